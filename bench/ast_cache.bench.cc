@@ -0,0 +1,109 @@
+#include "memory/memory.hpp"
+#include "base/base.hpp"
+#include "string_pool/string_pool.hpp"
+#include "parse/parser_context.hpp"
+
+#include "tokenizer/tokenizer.hpp"
+#include "ast/ast.hpp"
+#include "parse/parse.hpp"
+#include "ast/ast_cache.hpp"
+
+/* Loading a program from the binary AST cache against parsing the source again.
+
+    Usage: ast_cache_bench [copies]
+
+    The program is parsed from copies of a script with declarations, loops, functions and objects.
+*/
+
+namespace {
+
+constexpr std::string_view k_script =
+R"(
+    var i = 1;
+    var ter = i > 10 ? i : 11;
+    i += 2;
+
+    if ( (i + 10)++ ) { var n = i; } else if ( !false ) { var n = -i; } else { var n = i; }
+    for ( var i = 0; i < 10; i ++ ) { blaah (a,b,10)().aa; }
+
+    function calcRectArea(width, height)
+    {
+        if ( width ) { return 10; }
+        return width * height;
+    }
+
+    var car1 = new Car (123, -1234, "BLAAH" );
+    var arr = [, 20, "some string",, 30];
+    var obj = { a: "foo", b: 42, c: { h : 10, set b(c) { var a = 10; }, get s() { a; } } };
+)";
+
+template<typename F>
+auto run(std::string_view name, std::size_t bytes, std::size_t iterations, F&& f)
+{
+    auto nodes = std::size_t{};
+
+    const auto start = std::chrono::steady_clock::now();
+
+    for ( std::size_t i{}; i < iterations; i++ )
+    {
+        nodes = f();
+    }
+
+    const auto elapsed = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count() / static_cast<double>(iterations);
+
+    std::cout << std::left << std::setw(24) << name
+              << std::right << std::setw(10) << std::fixed << std::setprecision(1) << elapsed << " ms"
+              << std::setw(10) << std::setprecision(1) << static_cast<double>(bytes) / 1e3 / elapsed << " MB/s"
+              << "  (" << nodes << " statements)\n";
+}
+
+} // namespace
+
+auto main(int argc, char** argv) -> int
+{
+    const auto copies = argc > 1 ? static_cast<std::size_t>(std::strtoull(argv[1], nullptr, 10)) : std::size_t{2'000};
+
+    auto script = std::string{};
+
+    for ( std::size_t i{}; i < copies; i++ )
+    {
+        script += k_script;
+    }
+
+    auto cache = std::string{};
+
+    {
+        platform::pmr::monotonic_buffer_resource resource{};
+
+        acme::parser script_parser{script, std::addressof(resource)};
+        script_parser.parse_all();
+
+        acme::ast::write_cache(script_parser.ast_nodes(), cache);
+    }
+
+    std::cout << script.size() << " bytes of script, " << cache.size() << " bytes of cache\n";
+
+    constexpr std::size_t k_iterations = 5u;
+
+    run("acme::parser", script.size(), k_iterations, [&]()
+    {
+        platform::pmr::monotonic_buffer_resource resource{};
+
+        acme::parser script_parser{script, std::addressof(resource)};
+        script_parser.parse_all();
+
+        return script_parser.ast_nodes().size();
+    });
+
+    run("acme::ast::cache_reader", cache.size(), k_iterations, [&]()
+    {
+        platform::pmr::monotonic_buffer_resource resource{};
+
+        acme::parser_context    context{std::addressof(resource)};
+        acme::ast::cache_reader reader{};
+
+        return reader.read(context, cache).m_nodes.size();
+    });
+
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,112 @@
+#include "memory/memory.hpp"
+#include "base/base.hpp"
+#include "string_pool/string_pool.hpp"
+#include "parse/parser_context.hpp"
+
+#include "tokenizer/tokenizer.hpp"
+#include "var/script_value.hpp"
+#include "ast/ast.hpp"
+#include "parse/parse.hpp"
+#include "bytecode/bytecode.hpp"
+#include "virtual_machine/virtual_machine.hpp"
+#include "emit/emit.hpp"
+
+/* One rule evaluated over many records: a virtual machine execution per record, against
+   acme::batch_virtual_machine.
+
+    Usage: batch_bench [records]
+*/
+
+namespace {
+
+using namespace acme::literals;
+
+constexpr std::string_view k_rule = R"(
+    var total = price * quantity;
+    var flag  = false;
+
+    if ( total > 100 )
+    {
+        total = total - total / 10;
+        flag  = true;
+    }
+)";
+
+template<typename F>
+auto run(std::string_view name, std::size_t records, F&& f)
+{
+    const auto start   = std::chrono::steady_clock::now();
+    const auto checked = f();
+    const auto elapsed = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+
+    std::cout << std::left << std::setw(24) << name
+              << std::right << std::setw(10) << std::fixed << std::setprecision(1) << elapsed << " ms"
+              << std::setw(10) << std::setprecision(2) << elapsed * 1e6 / static_cast<double>(records) << " ns/record"
+              << "  (" << checked << " flagged)\n";
+}
+
+} // namespace
+
+auto main(int argc, char** argv) -> int
+{
+    const auto records = argc > 1 ? static_cast<std::size_t>(std::strtoull(argv[1], nullptr, 10)) : std::size_t{1'000'000};
+
+    auto price    = std::vector<double>(records);
+    auto quantity = std::vector<double>(records);
+
+    for ( std::size_t i{}; i < records; i++ )
+    {
+        price[i]    = static_cast<double>(i % 97) * 0.5;
+        quantity[i] = static_cast<double>(i % 13);
+    }
+
+    platform::pmr::monotonic_buffer_resource resource{};
+
+    acme::parser script_parser{k_rule, std::addressof(resource)};
+    script_parser.parse_all();
+
+    acme::emit_context context{};
+    acme::emit(script_parser.ast_nodes(), context);
+
+    const auto code = context.bytecode();
+
+    std::cout << records << " records\n";
+
+    run("execute per record", records, [&]()
+    {
+        auto flagged = std::size_t{};
+
+        acme::virtual_machine vm{};
+
+        for ( std::size_t i{}; i < records; i++ )
+        {
+            vm.push_scope();
+            vm.locals().push("price"_id, acme::number{price[i]});
+            vm.locals().push("quantity"_id, acme::number{quantity[i]});
+
+            vm.execute(code);
+
+            flagged += to_boolean(vm.get_var("flag"_id).value().get()) ? 1 : 0;
+
+            vm.pop_scope();
+            vm.pop_scope();
+        }
+
+        return flagged;
+    });
+
+    run("batch_virtual_machine", records, [&]()
+    {
+        auto flags = std::vector<acme::script_value>(records);
+
+        const acme::batch_input  inputs[]  = { { .m_id = "price"_id, .m_numbers = price }, { .m_id = "quantity"_id, .m_numbers = quantity } };
+        const acme::batch_output outputs[] = { { .m_id = "flag"_id, .m_values = flags } };
+
+        acme::batch_virtual_machine vm{};
+        vm.execute(code, inputs, outputs, records);
+
+        return static_cast<std::size_t>(std::count_if(flags.begin(), flags.end(), [](const auto& flag) { return to_boolean(flag); }));
+    });
+
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,107 @@
+#include "memory/memory.hpp"
+#include "base/base.hpp"
+
+/* acme::dynamic_cvector against std::pmr::vector, both allocating from a monotonic buffer
+   resource: many short lists, as the AST and the scope stack hold, and one long list. The
+   short lists are also built in inline storage and the long one with the 1.5x growth policy.
+
+    Usage: dynamic_cvector_bench [lists]
+*/
+
+namespace {
+
+constexpr std::size_t k_short_length = 3u;
+constexpr std::size_t k_long_length  = 1u << 20;
+
+template<typename F>
+auto run(std::string_view name, std::size_t count, F&& f)
+{
+    const auto start   = std::chrono::steady_clock::now();
+    const auto checked = f();
+    const auto elapsed = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+
+    std::cout << std::left << std::setw(32) << name
+              << std::right << std::setw(10) << std::fixed << std::setprecision(1) << elapsed << " ms"
+              << std::setw(10) << std::setprecision(2) << elapsed * 1e6 / static_cast<double>(count) << " ns/element"
+              << "  (" << checked << ")\n";
+}
+
+// Build the lists one after another from the same arena, as the parser does.
+
+template <typename list_type>
+auto short_lists(std::size_t lists) -> std::size_t
+{
+    platform::pmr::monotonic_buffer_resource resource{};
+
+    auto sum = std::size_t{};
+
+    for ( std::size_t i{}; i < lists; i++ )
+    {
+        list_type list{std::addressof(resource)};
+
+        for ( std::size_t j{}; j < k_short_length; j++ )
+        {
+            list.push_back(i + j);
+        }
+
+        sum += list[k_short_length - 1];
+    }
+
+    return sum;
+}
+
+template <typename list_type>
+auto long_list() -> std::size_t
+{
+    platform::pmr::monotonic_buffer_resource resource{};
+
+    list_type list{std::addressof(resource)};
+
+    for ( std::size_t i{}; i < k_long_length; i++ )
+    {
+        list.push_back(i);
+    }
+
+    return list.capacity();
+}
+
+} // namespace
+
+auto main(int argc, char** argv) -> int
+{
+    const auto lists = argc > 1 ? static_cast<std::size_t>(std::strtoull(argv[1], nullptr, 10)) : std::size_t{1'000'000};
+
+    std::cout << lists << " lists of " << k_short_length << ", one list of " << k_long_length << '\n';
+
+    run("std::pmr::vector short", lists * k_short_length, [&]()
+    {
+        return short_lists<platform::pmr::vector<std::size_t>>(lists);
+    });
+
+    run("dynamic_cvector short", lists * k_short_length, [&]()
+    {
+        return short_lists<acme::dynamic_cvector<std::size_t>>(lists);
+    });
+
+    run("dynamic_cvector<4> short", lists * k_short_length, [&]()
+    {
+        return short_lists<acme::dynamic_cvector<std::size_t, 4u>>(lists);
+    });
+
+    run("std::pmr::vector long", k_long_length, [&]()
+    {
+        return long_list<platform::pmr::vector<std::size_t>>();
+    });
+
+    run("dynamic_cvector long", k_long_length, [&]()
+    {
+        return long_list<acme::dynamic_cvector<std::size_t>>();
+    });
+
+    run("dynamic_cvector 1.5x long", k_long_length, [&]()
+    {
+        return long_list<acme::dynamic_cvector<std::size_t, 0u, acme::grow_by_half>>();
+    });
+
+    return EXIT_SUCCESS;
+}
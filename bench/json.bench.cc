@@ -0,0 +1,184 @@
+#include <random>
+
+#include <nlohmann/json.hpp>
+
+#include "memory/memory.hpp"
+#include "base/base.hpp"
+#include "string_pool/string_pool.hpp"
+#include "parse/parser_context.hpp"
+
+#include "tokenizer/tokenizer.hpp"
+#include "var/script_value.hpp"
+#include "ast/ast.hpp"
+#include "bytecode/bytecode.hpp"
+#include "virtual_machine/virtual_machine.hpp"
+#include "json/json.hpp"
+
+/* JSON to script values and back, against nlohmann::json. Parsing with nlohmann::json builds a
+   document that still has to be converted to script values, both steps are measured.
+
+    Usage: json_bench [iterations] [file.json]
+
+    Without a file a document of about 16 MB with records of numbers, strings and arrays is generated.
+*/
+
+namespace {
+
+template<typename F>
+auto run(std::string_view name, std::size_t bytes, std::size_t iterations, F&& f)
+{
+    const auto start = std::chrono::steady_clock::now();
+
+    auto result = std::size_t{};
+
+    for ( std::size_t i{}; i < iterations; i++ )
+    {
+        result += f();
+    }
+
+    const auto elapsed = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count() / static_cast<double>(iterations);
+
+    std::cout << std::left << std::setw(32) << name
+              << std::right << std::setw(10) << std::fixed << std::setprecision(1) << elapsed << " ms"
+              << std::setw(10) << std::setprecision(0) << static_cast<double>(bytes) / 1e3 / elapsed << " MB/s"
+              << "  (" << result / iterations << ")\n";
+}
+
+auto generate() -> std::string
+{
+    auto random  = std::mt19937{7};
+    auto records = nlohmann::json::array();
+
+    for ( int i{}; i < 60'000; i++ )
+    {
+        auto record = nlohmann::json::object();
+
+        record["id"]              = i;
+        record["price"]           = std::ldexp(static_cast<double>(random()), -20);
+        record["name"]            = "item \"" + std::to_string(random() % 10'000) + "\" of the catalogue";
+        record["active"]          = random() % 2 == 0;
+        record["tags"]            = { "red", "green", "blue" };
+        record["location"]["lat"] = std::ldexp(static_cast<double>(random()), -25);
+        record["location"]["lon"] = std::ldexp(static_cast<double>(random()), -25);
+        record["parent"]          = nullptr;
+
+        records.push_back(std::move(record));
+    }
+
+    return records.dump(2);
+}
+
+auto to_script_value(
+    acme::virtual_machine& vm,
+    const nlohmann::json&  json
+) -> acme::script_value
+{
+    switch ( json.type() )
+    {
+        case nlohmann::json::value_t::boolean:
+            return acme::script_value{acme::boolean{json.get<bool>()}};
+
+        case nlohmann::json::value_t::number_integer:
+        case nlohmann::json::value_t::number_unsigned:
+        case nlohmann::json::value_t::number_float:
+            return acme::script_value{acme::number{json.get<double>()}};
+
+        case nlohmann::json::value_t::string:
+            return acme::script_value{acme::string{vm.string_pool().intern(json.get_ref<const std::string&>())}};
+
+        case nlohmann::json::value_t::array:
+        {
+            const auto array = vm.heap().make_array();
+
+            for ( const auto& element : json )
+            {
+                array.data()->push_back(to_script_value(vm, element));
+            }
+
+            return acme::script_value{array};
+        }
+
+        case nlohmann::json::value_t::object:
+        {
+            const auto object = vm.heap().make_object();
+
+            for ( const auto& [key, value] : json.items() )
+            {
+                object.data()->insert(acme::string{vm.string_pool().intern(key)}, to_script_value(vm, value));
+            }
+
+            return acme::script_value{object};
+        }
+
+        default:
+            return acme::script_value{nullptr};
+    }
+}
+
+} // namespace
+
+auto main(int argc, char** argv) -> int
+{
+    const auto iterations = argc > 1 ? static_cast<std::size_t>(std::strtoull(argv[1], nullptr, 10)) : std::size_t{5};
+
+    auto text = std::string{};
+
+    if ( argc > 2 )
+    {
+        auto file = std::ifstream{argv[2], std::ios::binary};
+
+        text.assign(std::istreambuf_iterator<char>{file}, std::istreambuf_iterator<char>{});
+    }
+
+    else
+    {
+        text = generate();
+    }
+
+    std::cout << text.size() << " bytes, " << iterations << " iterations\n";
+
+    acme::virtual_machine vm{platform::pmr::get_default_resource()};
+    acme::json::parser    parser{};
+
+    run("nlohmann::json::parse", text.size(), iterations, [&]()
+    {
+        return nlohmann::json::parse(text).size();
+    });
+
+    run("nlohmann::json::parse + convert", text.size(), iterations, [&]()
+    {
+        vm.heap().clear();
+        return static_cast<std::size_t>(is_object(to_script_value(vm, nlohmann::json::parse(text))));
+    });
+
+    run("acme::json::parser::parse", text.size(), iterations, [&]()
+    {
+        vm.heap().clear();
+        return static_cast<std::size_t>(is_object(parser.parse(vm, text).m_value));
+    });
+
+    // Write the same values back.
+
+    const auto document = nlohmann::json::parse(text);
+
+    vm.heap().clear();
+
+    const auto value = parser.parse(vm, text).m_value;
+
+    auto buffer = std::string{};
+
+    run("nlohmann::json::dump", text.size(), iterations, [&]()
+    {
+        return document.dump().size();
+    });
+
+    run("acme::json::stringify", text.size(), iterations, [&]()
+    {
+        buffer.clear();
+        acme::json::stringify(value, buffer);
+
+        return buffer.size();
+    });
+
+    return EXIT_SUCCESS;
+}
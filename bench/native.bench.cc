@@ -0,0 +1,87 @@
+#include "memory/memory.hpp"
+#include "base/base.hpp"
+#include "string_pool/string_pool.hpp"
+#include "parse/parser_context.hpp"
+
+#include "tokenizer/tokenizer.hpp"
+#include "var/script_value.hpp"
+#include "ast/ast.hpp"
+#include "parse/parse.hpp"
+#include "bytecode/bytecode.hpp"
+#include "bytecode/verify.hpp"
+#include "virtual_machine/virtual_machine.hpp"
+#include "emit/emit.hpp"
+
+/* Loop calling a native function from a script, against the same loop with the function
+   inlined as a script expression. The difference is the cost of the trampoline.
+
+    Usage: native_bench [iterations]
+*/
+
+namespace {
+
+auto scale(double x, double factor) -> double
+{
+    return x * factor;
+}
+
+template<typename F>
+auto run(std::string_view name, std::size_t iterations, F&& f)
+{
+    const auto start   = std::chrono::steady_clock::now();
+    const auto result  = f();
+    const auto elapsed = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+
+    std::cout << std::left << std::setw(24) << name
+              << std::right << std::setw(10) << std::fixed << std::setprecision(1) << elapsed << " ms"
+              << std::setw(10) << std::setprecision(2) << elapsed * 1e6 / static_cast<double>(iterations) << " ns/iteration"
+              << "  (" << result << ")\n";
+}
+
+auto run_script(
+    std::string_view             script,
+    const acme::native_registry& natives
+) -> double
+{
+    using namespace acme::literals;
+
+    platform::pmr::monotonic_buffer_resource resource{};
+
+    acme::parser script_parser{script, std::addressof(resource)};
+    script_parser.parse_all();
+
+    acme::emit_context context{};
+    context.natives(natives.signatures());
+    acme::emit(script_parser.ast_nodes(), context);
+
+    acme::virtual_machine vm{};
+    vm.natives(std::addressof(natives));
+    vm.execute(context.bytecode());
+
+    return to_double(vm.locals().get("s"_id).value().get());
+}
+
+} // namespace
+
+auto main(int argc, char** argv) -> int
+{
+    const auto iterations = argc > 1 ? static_cast<std::size_t>(std::strtoull(argv[1], nullptr, 10)) : std::size_t{10'000'000};
+
+    std::cout << iterations << " iterations\n";
+
+    acme::native_registry natives{};
+    natives.add<&scale>("scale");
+
+    const auto loop = [&](std::string_view body)
+    {
+        return "var i = 0; var s = 0; while ( i < " + std::to_string(iterations) + " ) { " + std::string{body} + " i = i + 1; }";
+    };
+
+    const auto inlined = loop("s = s + i * 2;");
+    const auto called  = loop("s = s + scale(i, 2);");
+
+    run("script expression", iterations, [&]() { return run_script(inlined, natives); });
+    run("native call", iterations, [&]() { return run_script(called, natives); });
+
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,89 @@
+#include "memory/memory.hpp"
+#include "base/base.hpp"
+#include "numeric/numeric.hpp"
+#include "string_pool/string_pool.hpp"
+
+/* Number to string conversion: the previous snprintf("%.1f") implementation that
+   interned every result, against numeric::number_to_string.
+
+    Usage: number_to_string_bench [conversions]
+*/
+
+namespace {
+
+// Formatting used by the virtual machine before numeric::number_to_string.
+
+auto snprintf_to_string(acme::string_pool& pool, double value) -> acme::pool_string
+{
+    auto buffer = std::array<char, std::numeric_limits<double>::digits + 3>{};
+    auto length = std::snprintf(buffer.data(), buffer.size(), "%.1f", value);
+
+    return pool.intern(std::string_view{buffer.data(), static_cast<std::size_t>(length)});
+}
+
+// Mix of loop counter like integers and fractions.
+
+auto make_inputs(std::size_t count)
+{
+    auto inputs = std::vector<double>(count);
+
+    for ( std::size_t i{}; i < count; i++ )
+    {
+        inputs[i] = i % 2 == 0 ? static_cast<double>(i % 1000) : static_cast<double>(i) * 0.37;
+    }
+
+    return inputs;
+}
+
+template<typename F>
+auto run(std::string_view name, const std::vector<double>& inputs, F&& convert)
+{
+    auto total_length = std::size_t{};
+
+    const auto start = std::chrono::steady_clock::now();
+
+    for ( const auto value : inputs )
+    {
+        total_length += convert(value);
+    }
+
+    const auto elapsed = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+
+    std::cout << std::left << std::setw(32) << name
+              << std::right << std::setw(10) << std::fixed << std::setprecision(1) << elapsed << " ms"
+              << std::setw(10) << std::setprecision(2) << elapsed * 1e6 / static_cast<double>(inputs.size()) << " ns/op"
+              << "  (" << total_length << " chars)\n";
+}
+
+} // namespace
+
+auto main(int argc, char** argv) -> int
+{
+    const auto count  = argc > 1 ? static_cast<std::size_t>(std::strtoull(argv[1], nullptr, 10)) : std::size_t{10'000'000};
+    const auto inputs = make_inputs(count);
+
+    acme::string_pool pool{std::pmr::new_delete_resource()};
+
+    std::cout << count << " conversions\n";
+
+    run("snprintf + intern", inputs, [&](double value)
+    {
+        return snprintf_to_string(pool, value).view().size();
+    });
+
+    run("number_to_string + intern", inputs, [&](double value)
+    {
+        auto buffer = acme::numeric::number_string_buffer{};
+        auto text   = acme::numeric::number_to_string(value, buffer);
+
+        return text.data() == buffer.data() ? pool.intern(text).view().size() : text.size();
+    });
+
+    run("number_to_string", inputs, [&](double value)
+    {
+        auto buffer = acme::numeric::number_string_buffer{};
+        return acme::numeric::number_to_string(value, buffer).size();
+    });
+
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,108 @@
+#include "memory/memory.hpp"
+#include "base/base.hpp"
+#include "string_pool/string_pool.hpp"
+#include "parse/parser_context.hpp"
+
+#include "tokenizer/tokenizer.hpp"
+#include "var/script_value.hpp"
+#include "ast/ast.hpp"
+#include "parse/parse.hpp"
+#include "bytecode/bytecode.hpp"
+#include "virtual_machine/virtual_machine.hpp"
+#include "emit/emit.hpp"
+#include "optimize/optimize.hpp"
+
+/* Bytecode optimizer: instruction counts and execution time of each script of the
+   corpus at -O0, -O1 and -O2.
+
+    Usage: optimize_bench [iterations] [script.js...]
+
+    Without scripts the ahead-of-time test scripts are used as the corpus.
+*/
+
+namespace {
+
+auto read_file(const std::filesystem::path& path) -> std::string
+{
+    std::ifstream input{path, std::ios::binary};
+
+    return std::string{std::istreambuf_iterator<char>{input}, std::istreambuf_iterator<char>{}};
+}
+
+auto run(const std::filesystem::path& path, std::size_t iterations)
+{
+    using acme::opt::optimize_level;
+
+    const auto source = read_file(path);
+
+    platform::pmr::monotonic_buffer_resource resource{};
+
+    acme::parser script_parser{source, std::addressof(resource)};
+    script_parser.parse_all();
+
+    std::cout << path.filename().string() << '\n';
+
+    for ( const auto level : { optimize_level::k_O0, optimize_level::k_O1, optimize_level::k_O2 } )
+    {
+        acme::emit_context context{};
+        acme::emit(script_parser.ast_nodes(), context);
+
+        const auto stats = acme::opt::optimize(context, level);
+        const auto code  = context.bytecode();
+        const auto start = std::chrono::steady_clock::now();
+
+        for ( std::size_t i{}; i < iterations; i++ )
+        {
+            acme::virtual_machine vm{};
+            vm.execute(code);
+        }
+
+        const auto elapsed = std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start).count();
+
+        std::cout << "  -O" << static_cast<int>(level)
+                  << std::right << std::setw(8) << stats.m_instructions_after << " instructions"
+                  << std::setw(8) << std::fixed << std::setprecision(1)
+                  << 100.0 * (1.0 - static_cast<double>(stats.m_instructions_after) / static_cast<double>(stats.m_instructions_before)) << " %"
+                  << std::setw(12) << std::setprecision(2) << elapsed / static_cast<double>(iterations) << " us/run"
+                  << "  (" << stats.m_threaded_jumps << " threaded, "
+                  << stats.m_unreachable_instructions << " unreachable, "
+                  << stats.m_dead_stores << " dead stores, "
+                  << stats.m_redundant_loads << " loads, "
+                  << stats.m_copies << " copies, "
+                  << stats.m_hoisted_expressions << " hoisted)\n";
+    }
+}
+
+} // namespace
+
+auto main(int argc, char** argv) -> int
+{
+    const auto iterations = argc > 1 ? static_cast<std::size_t>(std::strtoull(argv[1], nullptr, 10)) : std::size_t{10'000};
+
+    auto scripts = std::vector<std::filesystem::path>{};
+
+    for ( int i = 2; i < argc; i++ )
+    {
+        scripts.emplace_back(argv[i]);
+    }
+
+    if ( scripts.empty() )
+    {
+        for ( const auto& entry : std::filesystem::directory_iterator{ACME_BENCH_CORPUS_DIR} )
+        {
+            if ( entry.path().extension() == ".js" )
+            {
+                scripts.push_back(entry.path());
+            }
+        }
+
+        std::sort(scripts.begin(), scripts.end());
+    }
+
+    for ( const auto& script : scripts )
+    {
+        run(script, iterations);
+    }
+
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,95 @@
+#include "memory/memory.hpp"
+#include "base/base.hpp"
+#include "string_pool/string_pool.hpp"
+#include "parse/parser_context.hpp"
+
+#include "tokenizer/tokenizer.hpp"
+#include "ast/ast.hpp"
+#include "parse/parse.hpp"
+
+/* Parse throughput on expression heavy input: the operator precedence loop of binary_expression
+   against the descent through a state per precedence level, from logical_expression.
+
+    Usage: parse_bench [lines]
+*/
+
+namespace {
+
+constexpr auto k_lines = std::array<std::string_view, 4>
+{
+    "a + b * c - d / e % 7 << 2 >= f && g || h;\n",
+    "price * quantity > 100 & discount != 0 | total <= limit ^ flag;\n",
+    "x;\n",
+    "(a + b) * (c - d) / 2 == e >>> 1 && !f || -g < h instanceof i;\n",
+};
+
+template<typename State>
+auto parse_lines(std::string_view script) -> std::size_t
+{
+    platform::pmr::monotonic_buffer_resource resource{};
+
+    acme::parser script_parser{script, std::addressof(resource)};
+    script_parser.next_token();
+
+    auto count = std::size_t{};
+
+    while ( script_parser.current_token().type() != acme::token_type::tok_eof && script_parser.current_token().type() != acme::token_type::tok_none )
+    {
+        count += script_parser.parse(State{}).get() != nullptr ? 1u : 0u;
+
+        script_parser.expect(acme::token_type::tok_semicolon, true, true);
+    }
+
+    return count;
+}
+
+template<typename F>
+auto run(std::string_view name, std::size_t bytes, F&& f)
+{
+    const auto start       = std::chrono::steady_clock::now();
+    const auto expressions = f();
+    const auto elapsed     = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+
+    std::cout << std::left << std::setw(32) << name
+              << std::right << std::setw(10) << std::fixed << std::setprecision(1) << elapsed << " ms"
+              << std::setw(10) << std::setprecision(2) << static_cast<double>(bytes) / 1e3 / elapsed << " MB/s"
+              << "  (" << expressions << " expressions)\n";
+}
+
+} // namespace
+
+auto main(int argc, char** argv) -> int
+{
+    const auto lines = argc > 1 ? static_cast<std::size_t>(std::strtoull(argv[1], nullptr, 10)) : std::size_t{20'000};
+
+    auto script = std::string{};
+
+    for ( std::size_t i{}; i < lines; i++ )
+    {
+        script += k_lines[i % k_lines.size()];
+    }
+
+    std::cout << script.size() << " bytes, " << lines << " lines\n";
+
+    run("precedence levels", script.size(), [&]()
+    {
+        return parse_lines<acme::state::logical_expression>(script);
+    });
+
+    run("binary_expression", script.size(), [&]()
+    {
+        return parse_lines<acme::state::binary_expression>(script);
+    });
+
+    run("parse_all", script.size(), [&]()
+    {
+        platform::pmr::monotonic_buffer_resource resource{};
+
+        acme::parser script_parser{script, std::addressof(resource)};
+        script_parser.parse_all();
+
+        return script_parser.ast_nodes().size();
+    });
+
+    return EXIT_SUCCESS;
+}
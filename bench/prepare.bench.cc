@@ -0,0 +1,107 @@
+#include "memory/memory.hpp"
+#include "base/base.hpp"
+#include "string_pool/string_pool.hpp"
+#include "parse/parser_context.hpp"
+
+#include "tokenizer/tokenizer.hpp"
+#include "var/script_value.hpp"
+#include "ast/ast.hpp"
+#include "parse/parse.hpp"
+#include "bytecode/bytecode.hpp"
+#include "bytecode/verify.hpp"
+#include "virtual_machine/virtual_machine.hpp"
+#include "emit/emit.hpp"
+#include "compile/prepare.hpp"
+
+/* Small predicate evaluated with different inputs: inputs declared as variables before each
+   execution, against a prepared expression with parameter slots.
+
+    Usage: prepare_bench [evaluations]
+*/
+
+namespace {
+
+using namespace acme::literals;
+
+constexpr std::string_view k_predicate = "price * quantity > 100;";
+
+template<typename F>
+auto run(std::string_view name, std::size_t evaluations, F&& f)
+{
+    const auto start   = std::chrono::steady_clock::now();
+    const auto matched = f();
+    const auto elapsed = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+
+    std::cout << std::left << std::setw(24) << name
+              << std::right << std::setw(10) << std::fixed << std::setprecision(1) << elapsed << " ms"
+              << std::setw(10) << std::setprecision(2) << elapsed * 1e6 / static_cast<double>(evaluations) << " ns/eval"
+              << "  (" << matched << " matched)\n";
+}
+
+} // namespace
+
+auto main(int argc, char** argv) -> int
+{
+    const auto evaluations = argc > 1 ? static_cast<std::size_t>(std::strtoull(argv[1], nullptr, 10)) : std::size_t{10'000'000};
+
+    std::cout << evaluations << " evaluations\n";
+
+    run("declare and execute", evaluations, [&]()
+    {
+        platform::pmr::monotonic_buffer_resource resource{};
+
+        acme::parser script_parser{k_predicate, std::addressof(resource)};
+        script_parser.parse_all();
+
+        acme::emit_context context{};
+        acme::emit(script_parser.ast_nodes(), context);
+
+        const auto code = context.bytecode();
+
+        auto matched = std::size_t{};
+
+        acme::virtual_machine vm{};
+
+        for ( std::size_t i{}; i < evaluations; i++ )
+        {
+            vm.push_scope();
+            vm.locals().push("price"_id, acme::number{static_cast<double>(i % 97)});
+            vm.locals().push("quantity"_id, acme::number{static_cast<double>(i % 13)});
+
+            vm.execute(code);
+
+            matched += to_boolean(vm.stack().pop_back()) ? 1 : 0;
+
+            vm.pop_scope();
+            vm.pop_scope();
+        }
+
+        return matched;
+    });
+
+    run("prepared expression", evaluations, [&]()
+    {
+        static constexpr std::string_view k_parameters[] = { "price", "quantity" };
+
+        const auto expression = acme::prepared_expression{k_predicate, k_parameters};
+
+        auto matched = std::size_t{};
+
+        acme::virtual_machine vm{};
+
+        for ( std::size_t i{}; i < evaluations; i++ )
+        {
+            const acme::script_value arguments[] =
+            {
+                acme::script_value{acme::number{static_cast<double>(i % 97)}},
+                acme::script_value{acme::number{static_cast<double>(i % 13)}},
+            };
+
+            matched += to_boolean(acme::evaluate(vm, expression, arguments)) ? 1 : 0;
+        }
+
+        return matched;
+    });
+
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,187 @@
+#include <nlohmann/json.hpp>
+
+#include "memory/memory.hpp"
+#include "base/base.hpp"
+#include "string_pool/string_pool.hpp"
+#include "parse/parser_context.hpp"
+
+#include "tokenizer/tokenizer.hpp"
+#include "ast/ast.hpp"
+#include "parse/parse.hpp"
+#include "render/render.hpp"
+#include "render/to_json.hpp"
+
+/* AST to JSON text: the nlohmann::json document built by json_printer and dumped, against
+   the streaming writer to a string and to a stream that discards the text. The peak of the
+   memory allocated while writing is measured with a counting operator new.
+
+    Usage: render_bench [copies]
+
+    The AST is parsed from copies of a script with declarations, loops, functions and objects.
+*/
+
+namespace {
+
+constexpr std::string_view k_script =
+R"(
+    var i = 1;
+    var ter = i > 10 ? i : 11;
+    i += 2;
+
+    if ( (i + 10)++ ) { var n = i; } else if ( !false ) { var n = -i; } else { var n = i; }
+    for ( var i = 0; i < 10; i ++ ) { blaah (a,b,10)().aa; }
+
+    function calcRectArea(width, height)
+    {
+        if ( width ) { return 10; }
+        return width * height;
+    }
+
+    var car1 = new Car (123, -1234, "BLAAH" );
+    var arr = [, 20, "some string",, 30];
+    var obj = { a: "foo", b: 42, c: { h : 10, set b(c) { var a = 10; }, get s() { a; } } };
+)";
+
+std::size_t g_allocated{};
+std::size_t g_peak{};
+
+constexpr std::size_t k_header_size = alignof(std::max_align_t);
+
+// Stream buffer that counts and discards the text.
+
+struct null_buffer : std::streambuf
+{
+    auto overflow(int_type c) -> int_type override
+    {
+        m_size++;
+        return c;
+    }
+
+    auto xsputn(const char_type*, std::streamsize n) -> std::streamsize override
+    {
+        m_size += static_cast<std::size_t>(n);
+        return n;
+    }
+
+    std::size_t m_size{};
+};
+
+template<typename F>
+auto run(std::string_view name, std::size_t iterations, F&& f)
+{
+    auto bytes = std::size_t{};
+    auto peak  = std::size_t{};
+
+    const auto start = std::chrono::steady_clock::now();
+
+    for ( std::size_t i{}; i < iterations; i++ )
+    {
+        const auto allocated = g_allocated;
+
+        g_peak = allocated;
+        bytes  = f();
+        peak   = std::max(peak, g_peak - allocated);
+    }
+
+    const auto elapsed = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count() / static_cast<double>(iterations);
+
+    std::cout << std::left << std::setw(28) << name
+              << std::right << std::setw(10) << std::fixed << std::setprecision(1) << elapsed << " ms"
+              << std::setw(10) << std::setprecision(1) << static_cast<double>(peak) / 1e6 << " MB peak"
+              << "  (" << bytes << " bytes)\n";
+}
+
+} // namespace
+
+auto operator new(std::size_t size) -> void*
+{
+    auto* p = static_cast<std::byte*>(std::malloc(size + k_header_size));
+
+    if ( p == nullptr )
+    {
+        throw std::bad_alloc{};
+    }
+
+    *reinterpret_cast<std::size_t*>(p) = size;
+
+    g_allocated += size;
+    g_peak       = std::max(g_peak, g_allocated);
+
+    return p + k_header_size;
+}
+
+auto operator delete(void* p) noexcept -> void
+{
+    if ( p == nullptr )
+    {
+        return;
+    }
+
+    auto* header = static_cast<std::byte*>(p) - k_header_size;
+
+    g_allocated -= *reinterpret_cast<std::size_t*>(header);
+
+    std::free(header);
+}
+
+auto operator delete(void* p, std::size_t) noexcept -> void
+{
+    operator delete(p);
+}
+
+auto main(int argc, char** argv) -> int
+{
+    using namespace std::string_view_literals;
+
+    const auto copies = argc > 1 ? static_cast<std::size_t>(std::strtoull(argv[1], nullptr, 10)) : std::size_t{2'000};
+
+    auto script = std::string{};
+
+    for ( std::size_t i{}; i < copies; i++ )
+    {
+        script += k_script;
+    }
+
+    platform::pmr::monotonic_buffer_resource resource{};
+
+    acme::parser script_parser{script, std::addressof(resource)};
+    script_parser.parse_all();
+
+    const auto& ast_nodes = script_parser.ast_nodes();
+
+    std::cout << script.size() << " bytes of script, " << ast_nodes.size() << " statements\n";
+
+    constexpr std::size_t k_iterations = 3u;
+
+    run("nlohmann::json dump(2)", k_iterations, [&]()
+    {
+        nlohmann::json result{};
+
+        for ( const auto& p : ast_nodes )
+        {
+            auto sub      = acme::render::to_json(p);
+            sub["type"sv] = acme::ast::to_string(p);
+
+            result += sub;
+        }
+
+        return result.dump(2).size();
+    });
+
+    run("acme::to_json std::string", k_iterations, [&]()
+    {
+        return acme::to_json(ast_nodes).size();
+    });
+
+    run("acme::to_json std::ostream", k_iterations, [&]()
+    {
+        null_buffer  buffer{};
+        std::ostream stream{std::addressof(buffer)};
+
+        acme::to_json(ast_nodes, stream);
+
+        return buffer.m_size;
+    });
+
+    return EXIT_SUCCESS;
+}
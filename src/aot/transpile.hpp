@@ -0,0 +1,317 @@
+#pragma once
+
+namespace acme::aot {
+
+namespace detail {
+
+[[nodiscard]] inline auto quoted(std::string_view s) -> std::string
+{
+    // Quote as a C++ string literal. Octal escapes are used since they never consume following characters.
+
+    std::string result{"\""};
+
+    for ( const auto c : s )
+    {
+        const auto u = static_cast<unsigned char>(c);
+
+        if ( c == '"' || c == '\\' )
+        {
+            result += '\\';
+            result += c;
+        }
+
+        else if ( u < 0x20 || u >= 0x7F || c == '?' )
+        {
+            result += '\\';
+            result += static_cast<char>('0' + ((u >> 6) & 7));
+            result += static_cast<char>('0' + ((u >> 3) & 7));
+            result += static_cast<char>('0' + (u & 7));
+        }
+
+        else
+        {
+            result += c;
+        }
+    }
+
+    result += "\"sv";
+
+    return result;
+}
+
+[[nodiscard]] inline auto label(std::size_t offset) -> std::string
+{
+    return "L" + std::to_string(offset);
+}
+
+[[nodiscard]] constexpr auto binary_expression(opcode op) -> std::string_view
+{
+    using namespace std::string_view_literals;
+
+    // Operand order mirrors binary_op(), `l` is the value on top of the stack.
+
+    switch ( op )
+    {
+        case opcode::binary_add:                    return "acme::op_add(vm, l, r)"sv;
+        case opcode::binary_sub:                    return "acme::op_sub(l, r)"sv;
+        case opcode::binary_mul:                    return "acme::op_mul(l, r)"sv;
+        case opcode::binary_div:                    return "acme::op_div(l, r)"sv;
+        case opcode::binary_mod:                    return "acme::op_mod(l, r)"sv;
+        case opcode::binary_pow:                    return "acme::op_pow(l, r)"sv;
+        case opcode::compare_strict_equal:          return "acme::op_strict_equal(vm, l, r)"sv;
+        case opcode::compare_equal:                 return "acme::op_equal(vm, l, r)"sv;
+        case opcode::compare_less_than:             return "acme::op_greater_than(r, l)"sv;
+        case opcode::compare_less_than_or_equal:    return "acme::op_greater_than_or_equal(r, l)"sv;
+        case opcode::compare_greater_than:          return "acme::op_greater_than(l, r)"sv;
+        case opcode::compare_greater_than_or_equal: return "acme::op_greater_than_or_equal(l, r)"sv;
+        case opcode::compare_instanceof:            return "acme::op_instanceof(l, r)"sv;
+        default:                                    return {};
+    }
+}
+
+[[nodiscard]] constexpr auto unary_expression(opcode op) -> std::string_view
+{
+    using namespace std::string_view_literals;
+
+    switch ( op )
+    {
+        case opcode::unary_negate:                  return "acme::op_negate(v)"sv;
+        case opcode::typeof_value:                  return "acme::value_typeof_s(v)"sv;
+        case opcode::unary_delete:                  return "acme::script_value{acme::boolean{true}}"sv;
+        default:                                    return {};
+    }
+}
+
+} // namespace detail
+
+/* Translate bytecode into a C++ function `void name(acme::virtual_machine&)`.
+
+    Every instruction becomes straight-line code operating on the virtual machine's
+    stack and scopes through the same helpers the interpreter uses. Jumps become
+    labels and gotos, constants are embedded into the generated source.
+*/
+
+inline auto transpile(
+    const acme::bytecode& code,
+    std::string_view      name,
+    std::ostream&         out
+) -> bool
+{
+    using namespace std::string_view_literals;
+
+    const auto instructions = code.instructions();
+
+    // Find jump targets, each of those gets a label.
+
+    acme::dynamic_cvector<bool> targets(instructions.size() + 1);
+
+    for ( const auto ins : instructions )
+    {
+        const auto op = operand(ins);
+
+        if ( op == opcode::jump_to || op == opcode::jump_if_false || op == opcode::jump_if_true )
+        {
+            if ( immediate(ins) > instructions.size() )
+            {
+                return false;
+            }
+
+            targets[immediate(ins)] = true;
+        }
+    }
+
+    const auto identifier_of = [&](std::size_t offset)
+    {
+        return code.constant<acme::identifier>(offset).as<acme::identifier>().value();
+    };
+
+    out << "// Generated by acme_aotc, do not edit.\n\n";
+
+    out << "#include \"memory/memory.hpp\"\n"
+           "#include \"base/base.hpp\"\n"
+           "#include \"string_pool/string_pool.hpp\"\n"
+           "#include \"parse/parser_context.hpp\"\n"
+           "#include \"tokenizer/tokenizer.hpp\"\n"
+           "#include \"var/script_value.hpp\"\n"
+           "#include \"ast/ast.hpp\"\n"
+           "#include \"parse/parse.hpp\"\n"
+           "#include \"bytecode/bytecode.hpp\"\n"
+           "#include \"virtual_machine/virtual_machine.hpp\"\n\n";
+
+    out << "void " << name << "(acme::virtual_machine& vm)\n{\n";
+    out << "    using namespace std::string_view_literals;\n\n";
+    out << "    vm.reserve_stack(" << code.max_stack_depth() << "u);\n";
+
+    for ( std::size_t pc{}; pc < instructions.size(); ++pc )
+    {
+        const auto ins = instructions[pc];
+        const auto op  = generic_opcode(operand(ins));
+        const auto imm = immediate(ins);
+
+        if ( targets[pc] )
+        {
+            out << '\n' << detail::label(pc) << ":\n";
+        }
+
+        // Identifier followed by a variable load or store is resolved without going through the stack.
+
+        if ( op == opcode::constant_identifier && pc + 1 < instructions.size() && targets[pc + 1] == false )
+        {
+            const auto next = operand(instructions[pc + 1]);
+
+            if ( next == opcode::load_var )
+            {
+                out << "\n    // " << pc << ": " << to_string(next) << ' ' << identifier_of(imm) << '\n';
+                out << "    if ( auto var = vm.get_var(std::bit_cast<acme::identifier>(" << identifier_of(imm) << "u)); var.has_value() )\n"
+                       "    {\n"
+                       "        vm.stack().push_back(var.value().get());\n"
+                       "    }\n"
+                       "    else\n"
+                       "    {\n"
+                       "        vm.stack().push_back(acme::script_value{acme::undefined{}});\n"
+                       "    }\n";
+
+                pc += 1;
+                continue;
+            }
+
+            if ( next == opcode::store_var )
+            {
+                out << "\n    // " << pc << ": " << to_string(next) << ' ' << identifier_of(imm) << '\n';
+                out << "    {\n"
+                       "        auto value = vm.stack().pop_back();\n\n"
+                       "        if ( auto var = vm.get_var(std::bit_cast<acme::identifier>(" << identifier_of(imm) << "u)); var.has_value() )\n"
+                       "        {\n"
+                       "            var.value().get().assign(value);\n"
+                       "        }\n"
+                       "    }\n";
+
+                pc += 1;
+                continue;
+            }
+        }
+
+        out << "\n    // " << pc << ": " << to_string(op) << '\n';
+
+        if ( auto expression = detail::binary_expression(op); expression.empty() == false )
+        {
+            out << "    {\n"
+                   "        auto l = vm.stack().pop_back();\n"
+                   "        auto r = vm.stack().pop_back();\n\n"
+                   "        vm.stack().push_back(" << expression << ");\n"
+                   "    }\n";
+
+            continue;
+        }
+
+        if ( auto expression = detail::unary_expression(op); expression.empty() == false )
+        {
+            out << "    {\n"
+                   "        auto v = vm.stack().pop_back();\n\n"
+                   "        vm.stack().push_back(" << expression << ");\n"
+                   "    }\n";
+
+            continue;
+        }
+
+        switch ( op )
+        {
+            case opcode::constant_i32:
+                out << "    vm.stack().push_back(acme::script_value{acme::number{" << code.m_number_constants[imm].m_i32 << "}});\n";
+                break;
+
+            case opcode::constant_u32:
+                out << "    vm.stack().push_back(acme::script_value{acme::number{" << code.m_number_constants[imm].m_u32 << "u}});\n";
+                break;
+
+            case opcode::constant_double:
+            {
+                const auto value = code.constant<double>(imm).as<acme::number>().value();
+
+                out << "    vm.stack().push_back(acme::script_value{acme::number{std::bit_cast<double>(0x"
+                    << std::hex << std::bit_cast<std::uint64_t>(value) << std::dec << "ull)}}); // " << value << '\n';
+                break;
+            }
+
+            case opcode::constant_identifier:
+                out << "    vm.stack().push_back(acme::script_value{std::bit_cast<acme::identifier>(" << identifier_of(imm) << "u)});\n";
+                break;
+
+            case opcode::constant_string:
+                out << "    vm.stack().push_back(acme::script_value{acme::string{" << detail::quoted(code.constant<acme::string>(imm).as<acme::string>().value()) << "}});\n";
+                break;
+
+            case opcode::push_bool_true:
+                out << "    vm.stack().push_back(acme::script_value{acme::boolean{true}});\n";
+                break;
+
+            case opcode::push_bool_false:
+                out << "    vm.stack().push_back(acme::script_value{acme::boolean{false}});\n";
+                break;
+
+            case opcode::push_null:
+                out << "    vm.stack().push_back(acme::script_value{std::nullptr_t{}});\n";
+                break;
+
+            case opcode::push_undefined:
+                out << "    vm.stack().push_back(acme::script_value{acme::undefined{}});\n";
+                break;
+
+            case opcode::duplicate_top:
+                out << "    vm.stack().push_back(vm.stack().top());\n";
+                break;
+
+            case opcode::load_var:
+                out << "    acme::var_op<acme::opcode::load_var>(vm);\n";
+                break;
+
+            case opcode::store_var:
+                out << "    acme::var_op<acme::opcode::store_var>(vm);\n";
+                break;
+
+            case opcode::initialize:
+                out << "    acme::var_op<acme::opcode::initialize>(vm);\n";
+                break;
+
+            case opcode::push_stack_frame:
+                out << "    vm.push_scope();\n";
+                break;
+
+            case opcode::pop_stack_frame:
+                for ( auto count = imm; count != 0; --count )
+                {
+                    out << "    vm.pop_scope();\n";
+                }
+                break;
+
+            case opcode::jump_if_false:
+                out << "    if ( acme::to_boolean(vm.stack().pop_back()) == false ) goto " << detail::label(imm) << ";\n";
+                break;
+
+            case opcode::jump_if_true:
+                out << "    if ( acme::to_boolean(vm.stack().pop_back()) == true ) goto " << detail::label(imm) << ";\n";
+                break;
+
+            case opcode::jump_to:
+                out << "    goto " << detail::label(imm) << ";\n";
+                break;
+
+            case opcode::no_opearation:
+                break;
+
+            default:
+                return false;
+        }
+    }
+
+    if ( targets[instructions.size()] )
+    {
+        out << '\n' << detail::label(instructions.size()) << ":\n";
+    }
+
+    out << "    return;\n}\n";
+
+    return true;
+}
+
+} // namespace acme::aot
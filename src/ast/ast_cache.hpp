@@ -0,0 +1,917 @@
+#pragma once
+
+namespace acme::ast {
+
+/* Binary cache of parsed programs. Tools that analyze the same unchanged sources on every run
+   write the AST once after parsing and load it back into the same ast:: classes, without
+   tokenizing and parsing again.
+
+   Layout, integers are LEB128 varints and signed values are zigzag encoded:
+
+       "ACAC" version
+       string count, strings as length and bytes   // Identifiers and string literals.
+       node count, nodes
+
+   A node is a tag byte, its position and the fields of the node in declaration order. Child
+   nodes follow their parent, a missing child is the tag k_none. The line and index of the
+   position are stored as deltas to the previous node, which keeps most of them to one byte.
+
+       std::string cache{};
+       acme::ast::write_cache(script_parser.ast_nodes(), cache);
+
+       acme::parser_context context{resource};
+       acme::ast::cache_reader reader{};
+
+       if ( auto result = reader.read(context, cache); result )
+       {
+           acme::emit(result.m_nodes, emit_context);
+       }
+*/
+
+inline constexpr std::string_view k_cache_magic   = "ACAC";
+inline constexpr std::uint32_t    k_cache_version = 1u;
+
+enum class cache_tag : std::uint8_t
+{
+    k_none = 0u,
+    k_literal,
+    k_identifier,
+    k_object_property,
+    k_object_property_setter,
+    k_object_property_getter,
+    k_object_literal,
+    k_call_expression,
+    k_new_expression,
+    k_this_expression,
+    k_ternary_expression,
+    k_block_statement,
+    k_member_expression,
+    k_binary_expression,
+    k_unary_expression,
+    k_function_expression,
+    k_function_declaration,
+    k_sequence_expression,
+    k_if_statement,
+    k_loop_statement,
+    k_simple_statement,
+    k_variable_declaration,
+    k_node_list,
+    k_meta_property,
+    k_array_literal,
+};
+
+enum class cache_error : std::uint8_t
+{
+    none = 0u,
+    bad_magic,
+    unsupported_version,
+    truncated,
+    invalid_tag,
+    invalid_string,
+    invalid_value,
+    too_deep,
+};
+
+struct cache_result
+{
+    [[nodiscard]] constexpr explicit operator bool() const noexcept
+    {
+        return m_error == cache_error::none;
+    }
+
+    acme::parser::ast_node_list_type m_nodes{};
+    cache_error                      m_error{};
+    std::size_t                      m_offset{};   // Offset of the offending byte of the cache.
+};
+
+namespace detail {
+
+inline auto write_varint(
+    std::string&  out,
+    std::uint64_t value
+) -> void
+{
+    while ( value >= 0x80u )
+    {
+        out   += static_cast<char>(value | 0x80u);
+        value >>= 7u;
+    }
+
+    out += static_cast<char>(value);
+}
+
+[[nodiscard]] constexpr auto zigzag(std::int64_t value) noexcept -> std::uint64_t
+{
+    return (static_cast<std::uint64_t>(value) << 1u) ^ static_cast<std::uint64_t>(value >> 63);
+}
+
+[[nodiscard]] constexpr auto unzigzag(std::uint64_t value) noexcept -> std::int64_t
+{
+    return static_cast<std::int64_t>(value >> 1u) ^ -static_cast<std::int64_t>(value & 1u);
+}
+
+} // namespace detail
+
+/* Writes the cache of a program. The strings are collected into a table while the nodes are
+   written, the table is written in front of them at the end.
+*/
+
+class cache_writer
+{
+    public:
+
+    auto write(
+        const acme::parser::ast_node_list_type& nodes,
+        std::string&                            out
+    ) -> void
+    {
+        m_body.clear();
+        m_strings.clear();
+        m_table.clear();
+        m_line  = 0u;
+        m_index = 0u;
+
+        detail::write_varint(m_body, nodes.size());
+
+        for ( const auto& p : nodes )
+        {
+            node(p);
+        }
+
+        out += k_cache_magic;
+        detail::write_varint(out, k_cache_version);
+        detail::write_varint(out, m_table.size());
+
+        for ( const auto s : m_table )
+        {
+            detail::write_varint(out, s.size());
+            out += s;
+        }
+
+        out += m_body;
+    }
+
+    private:
+
+    auto varint(std::uint64_t value) -> void
+    {
+        detail::write_varint(m_body, value);
+    }
+
+    auto string(std::string_view s) -> void
+    {
+        const auto [it, inserted] = m_strings.try_emplace(s, m_table.size());
+
+        if ( inserted )
+        {
+            m_table.push_back(s);
+        }
+
+        varint(it->second);
+    }
+
+    auto header(
+        cache_tag      tag,
+        const AstNode& n
+    ) -> void
+    {
+        const auto& location = n.location();
+
+        m_body += static_cast<char>(tag);
+
+        varint(location.column());
+        varint(detail::zigzag(static_cast<std::int64_t>(location.line() - m_line)));
+        varint(detail::zigzag(static_cast<std::int64_t>(location.index() - m_index)));
+
+        m_line  = location.line();
+        m_index = location.index();
+    }
+
+    auto node(const UniqueAstNode& p) -> void
+    {
+        if ( p.get() == nullptr )
+        {
+            m_body += static_cast<char>(cache_tag::k_none);
+            return;
+        }
+
+        auto& n = *p.get();
+
+        switch ( n.type() )
+        {
+            case rtti::type_index<Literal>():
+            {
+                header(cache_tag::k_literal, n);
+
+                const auto& value = n.deref<Literal>().value();
+
+                m_body += static_cast<char>(value.index());
+
+                std::visit([&](const auto& v)
+                {
+                    using type = std::remove_cvref_t<decltype(v)>;
+
+                    if constexpr ( std::is_same_v<type, String> )
+                    {
+                        string(v.value().view());
+                    }
+
+                    else if constexpr ( std::is_same_v<type, Integer> )
+                    {
+                        varint(detail::zigzag(v.value()));
+                    }
+
+                    else if constexpr ( std::is_same_v<type, Float> )
+                    {
+                        const auto bits = std::bit_cast<std::uint64_t>(v.value());
+
+                        for ( std::size_t i{}; i < sizeof(bits); i++ )
+                        {
+                            m_body += static_cast<char>(bits >> (i * 8u));
+                        }
+                    }
+
+                    else
+                    {
+                        varint(static_cast<std::uint64_t>(v.value()));
+                    }
+                }, value);
+
+                return;
+            }
+
+            case rtti::type_index<Identifier>():
+                header(cache_tag::k_identifier, n);
+                string(n.deref<Identifier>().value().view());
+                return;
+
+            case rtti::type_index<ObjectProperty>():
+            {
+                const auto& v = n.deref<ObjectProperty>();
+
+                header(cache_tag::k_object_property, n);
+                node(v.key());
+                node(v.value());
+                return;
+            }
+
+            case rtti::type_index<ObjectPropertySetter>():
+            {
+                const auto& v = n.deref<ObjectPropertySetter>();
+
+                header(cache_tag::k_object_property_setter, n);
+                node(v.function_body());
+                node(v.formals());
+                return;
+            }
+
+            case rtti::type_index<ObjectPropertyGetter>():
+                header(cache_tag::k_object_property_getter, n);
+                node(n.deref<ObjectPropertyGetter>().function_body());
+                return;
+
+            case rtti::type_index<ObjectLiteral>():
+                header(cache_tag::k_object_literal, n);
+                node(n.deref<ObjectLiteral>().properties());
+                return;
+
+            case rtti::type_index<CallExpression>():
+            {
+                const auto& v = n.deref<CallExpression>();
+
+                header(cache_tag::k_call_expression, n);
+                node(v.callee());
+                node(v.arguments());
+                return;
+            }
+
+            case rtti::type_index<NewExpression>():
+            {
+                const auto& v = n.deref<NewExpression>();
+
+                header(cache_tag::k_new_expression, n);
+                node(v.callee());
+                node(v.arguments());
+                return;
+            }
+
+            case rtti::type_index<ThisExpression>():
+                header(cache_tag::k_this_expression, n);
+                return;
+
+            case rtti::type_index<TernaryExpression>():
+            {
+                const auto& v = n.deref<TernaryExpression>();
+
+                header(cache_tag::k_ternary_expression, n);
+                node(v.condition());
+                node(v.consequent());
+                node(v.alternate());
+                return;
+            }
+
+            case rtti::type_index<BlockStatement>():
+                header(cache_tag::k_block_statement, n);
+                node(n.deref<BlockStatement>().body());
+                return;
+
+            case rtti::type_index<MemberExpression>():
+            {
+                const auto& v = n.deref<MemberExpression>();
+
+                header(cache_tag::k_member_expression, n);
+                node(v.object());
+                node(v.property());
+                return;
+            }
+
+            case rtti::type_index<BinaryExpression>():
+            {
+                const auto& v = n.deref<BinaryExpression>();
+
+                header(cache_tag::k_binary_expression, n);
+                varint(static_cast<std::uint64_t>(v.operand()));
+                node(v.left());
+                node(v.right());
+                return;
+            }
+
+            case rtti::type_index<UnaryExpression>():
+            {
+                const auto& v = n.deref<UnaryExpression>();
+
+                header(cache_tag::k_unary_expression, n);
+                varint(static_cast<std::uint64_t>(v.operand()));
+                node(v.expression());
+                return;
+            }
+
+            case rtti::type_index<FunctionExpression>():
+            {
+                const auto& v = n.deref<FunctionExpression>();
+
+                header(cache_tag::k_function_expression, n);
+                node(v.parameters());
+                node(v.body());
+                return;
+            }
+
+            case rtti::type_index<FunctionDeclaration>():
+            {
+                const auto& v = n.deref<FunctionDeclaration>();
+
+                header(cache_tag::k_function_declaration, n);
+                node(v.identifier());
+                node(v.parameters());
+                node(v.body());
+                return;
+            }
+
+            case rtti::type_index<SequenceExpression>():
+                header(cache_tag::k_sequence_expression, n);
+                node(n.deref<SequenceExpression>().m_expressions);
+                return;
+
+            case rtti::type_index<IfStatement>():
+            {
+                const auto& v = n.deref<IfStatement>();
+
+                header(cache_tag::k_if_statement, n);
+                node(v.condition());
+                node(v.consequent());
+                node(v.alternate());
+                return;
+            }
+
+            case rtti::type_index<LoopStatement>():
+            {
+                const auto& v = n.deref<LoopStatement>();
+
+                header(cache_tag::k_loop_statement, n);
+                varint(static_cast<std::uint64_t>(v.kind()));
+                node(v.initializer());
+                node(v.condition());
+                node(v.update());
+                node(v.body());
+                return;
+            }
+
+            case rtti::type_index<SimpleStatement>():
+            {
+                const auto& v = n.deref<SimpleStatement>();
+
+                header(cache_tag::k_simple_statement, n);
+                varint(static_cast<std::uint64_t>(v.kind()));
+                node(v.argument());
+                return;
+            }
+
+            case rtti::type_index<VariableDeclaration>():
+            {
+                const auto& v = n.deref<VariableDeclaration>();
+
+                header(cache_tag::k_variable_declaration, n);
+                varint(static_cast<std::uint64_t>(v.kind().value()));
+                node(v.identifier());
+                node(v.initializer());
+                return;
+            }
+
+            case rtti::type_index<AstNodeList>():
+            {
+                const auto& list = n.deref<AstNodeList>().nodes();
+
+                header(cache_tag::k_node_list, n);
+                varint(list.size());
+
+                for ( const auto& element : list )
+                {
+                    node(element);
+                }
+
+                return;
+            }
+
+            case rtti::type_index<MetaProperty>():
+                header(cache_tag::k_meta_property, n);
+                varint(static_cast<std::uint64_t>(n.deref<MetaProperty>().type()));
+                return;
+
+            case rtti::type_index<ArrayLiteral>():
+                header(cache_tag::k_array_literal, n);
+                node(n.deref<ArrayLiteral>().elements());
+                return;
+        }
+
+        // Node types that are never created by the parser.
+
+        m_body += static_cast<char>(cache_tag::k_none);
+    }
+
+    std::string                                          m_body{};
+    std::unordered_map<std::string_view, std::uint32_t> m_strings{};
+    std::vector<std::string_view>                        m_table{};
+    std::size_t                                          m_line{};
+    std::size_t                                          m_index{};
+};
+
+inline auto write_cache(
+    const acme::parser::ast_node_list_type& nodes,
+    std::string&                            out
+) -> void
+{
+    cache_writer{}.write(nodes, out);
+}
+
+/* Loads a cache into nodes allocated from the resource of the context, with the strings
+   interned in its string pool. The cache is checked while it is read: a truncated or
+   corrupted cache gives an error, never a partial program.
+*/
+
+class cache_reader
+{
+    public:
+
+    static constexpr std::size_t k_max_depth = 1024u;
+
+    [[nodiscard]] auto read(
+        acme::parser_context& context,
+        std::string_view      data
+    ) -> cache_result
+    {
+        m_context = std::addressof(context);
+        m_data    = data;
+        m_offset  = 0u;
+        m_depth   = 0u;
+        m_line    = 0u;
+        m_index   = 0u;
+        m_error   = cache_error::none;
+        m_strings.clear();
+
+        auto result = cache_result{ .m_nodes = acme::parser::ast_node_list_type{context.resource()} };
+
+        const auto fail = [&](cache_error error)
+        {
+            result.m_nodes.clear();
+            result.m_error  = error;
+            result.m_offset = m_offset;
+
+            return std::move(result);
+        };
+
+        if ( data.substr(0u, k_cache_magic.size()) != k_cache_magic )
+        {
+            return fail(cache_error::bad_magic);
+        }
+
+        m_offset = k_cache_magic.size();
+
+        if ( const auto version = varint(); m_error == cache_error::none && version != k_cache_version )
+        {
+            return fail(cache_error::unsupported_version);
+        }
+
+        // Every string takes at least one byte, a count beyond the size is corrupted.
+
+        const auto strings = varint();
+
+        if ( strings > m_data.size() - m_offset )
+        {
+            return fail(cache_error::truncated);
+        }
+
+        m_strings.reserve(strings);
+
+        for ( std::uint64_t i{}; i < strings && m_error == cache_error::none; i++ )
+        {
+            const auto size = varint();
+
+            if ( size > m_data.size() - m_offset )
+            {
+                return fail(cache_error::truncated);
+            }
+
+            m_strings.push_back(context.get_string_pool().intern(m_data.substr(m_offset, size)));
+            m_offset += size;
+        }
+
+        const auto count = varint();
+
+        if ( count > m_data.size() - m_offset )
+        {
+            return fail(cache_error::truncated);
+        }
+
+        result.m_nodes.reserve(count);
+
+        for ( std::uint64_t i{}; i < count && m_error == cache_error::none; i++ )
+        {
+            result.m_nodes.push_back(node());
+        }
+
+        if ( m_error != cache_error::none )
+        {
+            return fail(m_error);
+        }
+
+        if ( m_offset != m_data.size() )
+        {
+            return fail(cache_error::invalid_value);
+        }
+
+        return result;
+    }
+
+    private:
+
+    auto error(cache_error e) -> void
+    {
+        if ( m_error == cache_error::none )
+        {
+            m_error = e;
+        }
+    }
+
+    [[nodiscard]] auto byte() -> std::uint8_t
+    {
+        if ( m_offset >= m_data.size() )
+        {
+            error(cache_error::truncated);
+            return 0u;
+        }
+
+        return static_cast<std::uint8_t>(m_data[m_offset++]);
+    }
+
+    [[nodiscard]] auto varint() -> std::uint64_t
+    {
+        auto value = std::uint64_t{};
+
+        for ( std::uint32_t shift{}; shift < 64u; shift += 7u )
+        {
+            const auto b = byte();
+
+            value |= static_cast<std::uint64_t>(b & 0x7Fu) << shift;
+
+            if ( (b & 0x80u) == 0u )
+            {
+                return value;
+            }
+        }
+
+        error(cache_error::invalid_value);
+        return 0u;
+    }
+
+    // A varint that has to be at most the given value.
+
+    [[nodiscard]] auto bounded(std::uint64_t max) -> std::uint64_t
+    {
+        const auto value = varint();
+
+        if ( value > max )
+        {
+            error(cache_error::invalid_value);
+            return 0u;
+        }
+
+        return value;
+    }
+
+    [[nodiscard]] auto string() -> acme::pool_string
+    {
+        const auto id = varint();
+
+        if ( id >= m_strings.size() )
+        {
+            error(cache_error::invalid_string);
+            return {};
+        }
+
+        return m_strings[id];
+    }
+
+    [[nodiscard]] auto token() -> token_type
+    {
+        return static_cast<token_type>(bounded(static_cast<std::uint64_t>(token_type::tok_yield)));
+    }
+
+    [[nodiscard]] auto location() -> acme::position
+    {
+        const auto column = varint();
+
+        m_line  += static_cast<std::size_t>(detail::unzigzag(varint()));
+        m_index += static_cast<std::size_t>(detail::unzigzag(varint()));
+
+        return acme::position{static_cast<std::size_t>(column), m_line, m_index};
+    }
+
+    [[nodiscard]] auto literal(acme::position position) -> UniqueAstNode
+    {
+        auto& context = *m_context;
+
+        switch ( byte() )
+        {
+            case 0u:
+                return Literal::make(context, String{string()}, std::move(position));
+
+            case 1u:
+                return Literal::make(context, Integer{static_cast<std::int32_t>(detail::unzigzag(varint()))}, std::move(position));
+
+            case 2u:
+                return Literal::make(context, UnsignedInteger{static_cast<std::uint32_t>(varint())}, std::move(position));
+
+            case 3u:
+            {
+                auto bits = std::uint64_t{};
+
+                for ( std::size_t i{}; i < sizeof(bits); i++ )
+                {
+                    bits |= static_cast<std::uint64_t>(byte()) << (i * 8u);
+                }
+
+                return Literal::make(context, Float{std::bit_cast<double>(bits)}, std::move(position));
+            }
+
+            case 4u:
+                return Literal::make(context, Boolean{varint() != 0u}, std::move(position));
+
+            case 5u:
+                return Literal::make(context, Null{varint() != 0u}, std::move(position));
+
+            case 6u:
+                return Literal::make(context, Undefined{static_cast<char>(varint())}, std::move(position));
+
+            default:
+                error(cache_error::invalid_value);
+                return {};
+        }
+    }
+
+    [[nodiscard]] auto node() -> UniqueAstNode
+    {
+        if ( m_depth >= k_max_depth )
+        {
+            error(cache_error::too_deep);
+            return {};
+        }
+
+        m_depth++;
+
+        auto result = node_at_depth();
+
+        m_depth--;
+
+        return m_error == cache_error::none ? std::move(result) : UniqueAstNode{};
+    }
+
+    [[nodiscard]] auto node_at_depth() -> UniqueAstNode
+    {
+        auto& context = *m_context;
+
+        const auto tag = static_cast<cache_tag>(byte());
+
+        if ( tag == cache_tag::k_none || m_error != cache_error::none )
+        {
+            return {};
+        }
+
+        if ( tag > cache_tag::k_array_literal )
+        {
+            error(cache_error::invalid_tag);
+            return {};
+        }
+
+        auto position = location();
+
+        switch ( tag )
+        {
+            case cache_tag::k_literal:
+                return literal(std::move(position));
+
+            case cache_tag::k_identifier:
+                return acme::make_unique<Identifier>(context.resource(), string(), std::move(position));
+
+            case cache_tag::k_object_property:
+            {
+                auto key = node();
+
+                return ObjectProperty::make(context, std::move(key), node(), std::move(position));
+            }
+
+            case cache_tag::k_object_property_setter:
+            {
+                auto function_body = node();
+
+                return ObjectPropertySetter::make(context, std::move(function_body), node(), std::move(position));
+            }
+
+            case cache_tag::k_object_property_getter:
+                return ObjectPropertyGetter::make(context, node(), std::move(position));
+
+            case cache_tag::k_object_literal:
+                return ObjectLiteral::make(context, node(), std::move(position));
+
+            case cache_tag::k_call_expression:
+            {
+                auto callee = node();
+
+                return CallExpression::make(context, std::move(position), std::move(callee), node());
+            }
+
+            case cache_tag::k_new_expression:
+            {
+                auto callee = node();
+
+                return NewExpression::make(context, std::move(position), std::move(callee), node());
+            }
+
+            case cache_tag::k_this_expression:
+                return ThisExpression::make(context, std::move(position));
+
+            case cache_tag::k_ternary_expression:
+            {
+                auto condition  = node();
+                auto consequent = node();
+
+                return TernaryExpression::make(context, std::move(position), std::move(condition), std::move(consequent), node());
+            }
+
+            case cache_tag::k_block_statement:
+                return BlockStatement::make(context, node(), std::move(position));
+
+            case cache_tag::k_member_expression:
+            {
+                auto object = node();
+
+                return MemberExpression::make(context, std::move(position), std::move(object), node());
+            }
+
+            case cache_tag::k_binary_expression:
+            {
+                const auto op = token();
+
+                auto left = node();
+
+                return BinaryExpression::make(context, std::move(left), node(), op, std::move(position));
+            }
+
+            case cache_tag::k_unary_expression:
+            {
+                const auto op = token();
+
+                return UnaryExpression::make(context, node(), op, std::move(position));
+            }
+
+            case cache_tag::k_function_expression:
+            {
+                auto parameters = node();
+
+                return FunctionExpression::make(context, std::move(parameters), node(), std::move(position));
+            }
+
+            case cache_tag::k_function_declaration:
+            {
+                auto identifier = node();
+                auto parameters = node();
+
+                return FunctionDeclaration::make(context, std::move(identifier), std::move(parameters), node(), std::move(position));
+            }
+
+            case cache_tag::k_sequence_expression:
+                return SequenceExpression::make(context, std::move(position), node());
+
+            case cache_tag::k_if_statement:
+            {
+                auto result = IfStatement::make(context, std::move(position));
+
+                result->condition(node());
+                result->consequent(node());
+                result->alternate(node());
+
+                return result;
+            }
+
+            case cache_tag::k_loop_statement:
+            {
+                const auto kind = static_cast<loop_kind>(bounded(static_cast<std::uint64_t>(loop_kind::k_do_while_loop)));
+
+                auto result = LoopStatement::make(context, std::move(position), kind);
+
+                result->initializer(node());
+                result->condition(node());
+                result->update(node());
+                result->body(node());
+
+                return result;
+            }
+
+            case cache_tag::k_simple_statement:
+            {
+                const auto kind = static_cast<simple_statement_kind>(bounded(static_cast<std::uint64_t>(simple_statement_kind::k_label_statement)));
+
+                auto result = SimpleStatement::make(context, std::move(position), kind);
+
+                result->argument(node());
+
+                return result;
+            }
+
+            case cache_tag::k_variable_declaration:
+            {
+                const auto kind = DeclarationKind{token()};
+
+                auto identifier = node();
+                auto result     = VariableDeclaration::make(context, std::move(identifier), kind, std::move(position));
+
+                result->assignment(node());
+
+                return result;
+            }
+
+            case cache_tag::k_node_list:
+            {
+                const auto count = varint();
+
+                // Every element takes at least one byte.
+
+                if ( count > m_data.size() - m_offset )
+                {
+                    error(cache_error::truncated);
+                    return {};
+                }
+
+                auto result = AstNodeList::make(context, std::move(position));
+
+                for ( std::uint64_t i{}; i < count && m_error == cache_error::none; i++ )
+                {
+                    result->insert(node());
+                }
+
+                return result;
+            }
+
+            case cache_tag::k_meta_property:
+                return MetaProperty::make(context, std::move(position), static_cast<MetaProperty::property_type>(bounded(0u)));
+
+            case cache_tag::k_array_literal:
+                return ArrayLiteral::make(context, node(), std::move(position));
+
+            default:
+                break;
+        }
+
+        return {};
+    }
+
+    acme::parser_context*          m_context{};
+    std::string_view               m_data{};
+    std::size_t                    m_offset{};
+    std::size_t                    m_depth{};
+    std::size_t                    m_line{};
+    std::size_t                    m_index{};
+    cache_error                    m_error{};
+    std::vector<acme::pool_string> m_strings{};
+};
+
+} // namespace acme::ast
@@ -120,9 +120,11 @@ struct AstNode
 {
     using rtti_value_type = decltype(rtti::type_index<AstNode>());
 
-    // No virtual destructor required (not destructed polymorphically).
+    // Nodes are destroyed polymorphically only when allocated during constant evaluation.
+    // Derived nodes provide a destructor body since GCC can not evaluate implicitly
+    // defined virtual destructors in constant expressions.
 
-    virtual ~AstNode() = default;
+    constexpr virtual ~AstNode() = default;
 
     template <typename T>
     [[nodiscard]] constexpr auto is() const
@@ -147,6 +149,11 @@ struct AstNode
         return m_rtti_type;
     }
 
+    [[nodiscard]] constexpr auto location() const noexcept -> const acme::position&
+    {
+        return m_parse_location;
+    }
+
     protected:
 
     explicit constexpr AstNode(
@@ -185,6 +192,8 @@ struct DeclarationKind
 
 struct Statement : public AstNode
 {
+    constexpr ~Statement() override {}
+
     explicit constexpr Statement(
         acme::position  position,
         rtti_value_type rtti_type
@@ -195,6 +204,8 @@ struct Statement : public AstNode
 
 struct Expression : public Statement
 {
+    constexpr ~Expression() override {}
+
     explicit constexpr Expression(
         acme::position  position,
         rtti_value_type rtti_type
@@ -293,6 +304,8 @@ struct Identifier : public Expression
 
     static constexpr auto rtti_type = rtti::type_index<Identifier>();
 
+    constexpr ~Identifier() override {}
+
     constexpr Identifier(
         value_type     id,
         acme::position position
@@ -316,6 +329,19 @@ struct Identifier : public Expression
         return acme::make_unique<Identifier>(context.resource(), std::move(interned_string), std::move(position));
     }
 
+    // Identifier with the hash of its name computed by the tokenizer.
+
+    [[nodiscard]] static constexpr auto make(
+        acme::parser_context&                       context,
+        std::string_view                            id,
+        acme::string_pool::string_header::hash_type hash,
+        acme::position                              position) -> UniqueIdentifier
+    {
+        auto interned_string = context.get_string_pool().intern(id, hash);
+
+        return acme::make_unique<Identifier>(context.resource(), std::move(interned_string), std::move(position));
+    }
+
     value_type m_id{};
 };
 
@@ -334,6 +360,8 @@ struct Literal : public Expression
 
     static constexpr auto rtti_type = rtti::type_index<Literal>();
 
+    constexpr ~Literal() override {}
+
     template <typename T>
     constexpr Literal(
         T              literal,
@@ -363,6 +391,8 @@ struct ObjectPropertySetter : public Expression
 {
     static constexpr auto rtti_type = rtti::type_index<ObjectPropertySetter>();
 
+    constexpr ~ObjectPropertySetter() override {}
+
     constexpr ObjectPropertySetter(
         UniqueAstNode  function_body,
         UniqueAstNode  formals,
@@ -401,6 +431,8 @@ struct ObjectPropertyGetter : public Expression
 {
     static constexpr auto rtti_type = rtti::type_index<ObjectPropertyGetter>();
 
+    constexpr ~ObjectPropertyGetter() override {}
+
     constexpr ObjectPropertyGetter(
         UniqueAstNode  function_body,
         acme::position position
@@ -430,6 +462,8 @@ struct ObjectProperty : public Expression
 {
     static constexpr auto rtti_type = rtti::type_index<ObjectProperty>();
 
+    constexpr ~ObjectProperty() override {}
+
     constexpr ObjectProperty(
         UniqueAstNode  key,
         UniqueAstNode  value,
@@ -468,6 +502,8 @@ struct ObjectLiteral : public Expression
 {
     static constexpr auto rtti_type = rtti::type_index<ObjectLiteral>();
 
+    constexpr ~ObjectLiteral() override {}
+
     constexpr ObjectLiteral(
         UniqueAstNode  properties,
         acme::position position
@@ -497,6 +533,8 @@ struct BlockStatement : public Statement
 {
     static constexpr auto rtti_type = rtti::type_index<BlockStatement>();
 
+    constexpr ~BlockStatement() override {}
+
     constexpr BlockStatement(
         UniqueAstNode  statements,
         acme::position position
@@ -526,6 +564,8 @@ struct LoopStatement : public Statement
 {
     static constexpr auto rtti_type = rtti::type_index<LoopStatement>();
 
+    constexpr ~LoopStatement() override {}
+
     constexpr LoopStatement(acme::position position,
                             loop_kind      kind)
         : Statement{std::move(position), rtti_type}
@@ -602,6 +642,8 @@ struct SimpleStatement : public Statement
 {
     static constexpr auto rtti_type = rtti::type_index<SimpleStatement>();
 
+    constexpr ~SimpleStatement() override {}
+
     constexpr SimpleStatement(
         acme::position        position,
         simple_statement_kind kind
@@ -642,6 +684,8 @@ struct IfStatement : public Statement
 {
     static constexpr auto rtti_type = rtti::type_index<IfStatement>();
 
+    constexpr ~IfStatement() override {}
+
     constexpr IfStatement(acme::position position)
         : Statement{std::move(position), rtti_type}
         {}
@@ -693,6 +737,8 @@ struct VariableDeclaration : public Statement
 {
     static constexpr auto rtti_type = rtti::type_index<VariableDeclaration>();
 
+    constexpr ~VariableDeclaration() override {}
+
     constexpr VariableDeclaration(
         UniqueAstNode   id,
         DeclarationKind kind,
@@ -750,11 +796,15 @@ struct VariableDeclaration : public Statement
 
 struct AstNodeList : public Statement
 {
-    using list_type = acme::dynamic_cvector<ast::UniqueAstNode>;
+    // Argument and parameter lists are short, they are stored in the node.
+
+    using list_type = acme::dynamic_cvector<ast::UniqueAstNode, 4u>;
 
     static constexpr auto rtti_type = rtti::type_index<AstNodeList>();
 
-    AstNodeList(
+    constexpr ~AstNodeList() override {}
+
+    constexpr AstNodeList(
         acme::position                  position,
         platform::pmr::memory_resource* resource
     )
@@ -797,6 +847,8 @@ struct ArrayLiteral : public Expression
 {
     static constexpr auto rtti_type = rtti::type_index<ArrayLiteral>();
 
+    constexpr ~ArrayLiteral() override {}
+
     constexpr ArrayLiteral(
         UniqueAstNode  elements,
         acme::position position
@@ -826,6 +878,8 @@ struct SequenceExpression : public Expression
 {
     static constexpr auto rtti_type = rtti::type_index<SequenceExpression>();
 
+    constexpr ~SequenceExpression() override {}
+
     constexpr SequenceExpression(
         acme::position position,
         UniqueAstNode  expressions
@@ -850,6 +904,8 @@ struct MetaProperty : public Expression
 {
     static constexpr auto rtti_type = rtti::type_index<MetaProperty>();
 
+    constexpr ~MetaProperty() override {}
+
     enum class property_type
     {
         new_target
@@ -884,6 +940,8 @@ struct FunctionDeclaration : public Statement
 {
     static constexpr auto rtti_type = rtti::type_index<FunctionDeclaration>();
 
+    constexpr ~FunctionDeclaration() override {}
+
     constexpr FunctionDeclaration(
         UniqueAstNode  identifier,
         UniqueAstNode  parameters,
@@ -937,6 +995,8 @@ struct FunctionExpression : public Expression
 {
     static constexpr auto rtti_type = rtti::type_index<FunctionExpression>();
 
+    constexpr ~FunctionExpression() override {}
+
     constexpr FunctionExpression(
         UniqueAstNode  parameters,
         UniqueAstNode  body,
@@ -980,6 +1040,8 @@ struct UnaryExpression : public Expression
 {
     static constexpr auto rtti_type = rtti::type_index<UnaryExpression>();
 
+    constexpr ~UnaryExpression() override {}
+
     constexpr UnaryExpression(
         UniqueAstNode    expression,
         acme::token_type op,
@@ -1019,6 +1081,8 @@ struct BinaryExpression : public Expression
 {
     static constexpr auto rtti_type = rtti::type_index<BinaryExpression>();
 
+    constexpr ~BinaryExpression() override {}
+
     constexpr BinaryExpression(
         UniqueAstNode   left,
         acme::position position
@@ -1092,6 +1156,8 @@ struct ThisExpression : public Expression
 {
     static constexpr auto rtti_type = rtti::type_index<ThisExpression>();
 
+    constexpr ~ThisExpression() override {}
+
     constexpr ThisExpression(acme::position position)
         : Expression{std::move(position), rtti_type}
         {}
@@ -1109,6 +1175,8 @@ struct TernaryExpression : public Expression
 {
     static constexpr auto rtti_type = rtti::type_index<TernaryExpression>();
 
+    constexpr ~TernaryExpression() override {}
+
     constexpr TernaryExpression(
         acme::position position,
         UniqueAstNode  condition,
@@ -1162,6 +1230,8 @@ struct CallExpression : public Expression
 {
     static constexpr auto rtti_type = rtti::type_index<CallExpression>();
 
+    constexpr ~CallExpression() override {}
+
     constexpr CallExpression(
         acme::position position,
         UniqueAstNode  callee,
@@ -1204,6 +1274,8 @@ struct NewExpression : public Expression
 {
     static constexpr auto rtti_type = rtti::type_index<NewExpression>();
 
+    constexpr ~NewExpression() override {}
+
     constexpr NewExpression(
         acme::position position,
         UniqueAstNode  callee,
@@ -1246,6 +1318,8 @@ struct MemberExpression : public Expression
 {
     static constexpr auto rtti_type = rtti::type_index<MemberExpression>();
 
+    constexpr ~MemberExpression() override {}
+
     constexpr MemberExpression(acme::position position)
         : Expression{std::move(position), rtti_type}
         {}
@@ -1267,7 +1341,7 @@ struct MemberExpression : public Expression
         UniqueAstNode         prop
     ) -> UniqueAstNode
     {
-        return acme::make_unique<MemberExpression>(context.resource(), std::move(position), std::move(obj), std::move(prop));
+        return acme::make_unique<MemberExpression>(context.resource(), std::move(position), std::move(prop), std::move(obj));
     }
 
     constexpr auto property(UniqueAstNode node)
@@ -2,7 +2,48 @@
 
 namespace acme {
 
+// Growth policies of dynamic_cvector, the capacity after a full vector of the given capacity.
+
+struct grow_by_doubling
+{
+    [[nodiscard]] static constexpr auto next(std::size_t capacity) noexcept -> std::size_t
+    {
+        return std::max(capacity * 2u, std::size_t{1u});
+    }
+};
+
+struct grow_by_half
+{
+    [[nodiscard]] static constexpr auto next(std::size_t capacity) noexcept -> std::size_t
+    {
+        return std::max(capacity + capacity / 2u, capacity + 2u);
+    }
+};
+
+namespace detail {
+
+template <typename T, std::size_t k_capacity>
+struct inline_storage
+{
+    alignas(T) std::byte m_bytes[k_capacity * sizeof(T)];
+};
+
 template <typename T>
+struct inline_storage<T, 0u>
+{};
+
+} // namespace detail
+
+/* Vector whose storage comes from a memory resource, or from std::allocator if it has none
+   and during constant evaluation.
+
+   The first k_inline_capacity elements are stored in the vector itself, so a vector that
+   stays that small never allocates. Inline storage is not used during constant evaluation.
+
+   A moved vector takes the memory resource with the elements, a copied one has none.
+*/
+
+template <typename T, std::size_t k_inline_capacity = 0u, typename growth_policy = acme::grow_by_doubling>
 struct dynamic_cvector
 {
     using value_type      = T;
@@ -10,12 +51,17 @@ struct dynamic_cvector
     using const_reference = const value_type&;
     using reference       = value_type&;
     using difference_type = std::ptrdiff_t;
-    using allocator_type  = std::allocator<value_type>;
-    using pointer         = typename std::allocator_traits<allocator_type>::pointer;
-    using const_pointer   = typename std::allocator_traits<allocator_type>::const_pointer;
+    using pointer         = value_type*;
+    using const_pointer   = const value_type*;
     using iterator        = value_type*;
     using const_iterator  = const value_type*;
 
+    private:
+
+    using inline_storage_type = detail::inline_storage<T, k_inline_capacity>;
+
+    public:
+
     constexpr ~dynamic_cvector()
     {
         clear();
@@ -25,17 +71,17 @@ struct dynamic_cvector
 
     constexpr dynamic_cvector() = default;
 
-    constexpr dynamic_cvector(platform::pmr::memory_resource*)
+    constexpr dynamic_cvector(platform::pmr::memory_resource* resource)
+        : m_resource{resource}
     {}
 
     constexpr dynamic_cvector(size_type n) requires(std::is_default_constructible_v<T>)
-        : m_capacity{n}
-        , m_size{n}
-        , m_data{allocate(m_capacity)}
     {
-        for ( size_type i{}; i < m_size; ++i )
+        reserve(n);
+
+        for ( ; m_size < n; ++m_size )
         {
-            construct(i);
+            construct(m_size);
         }
     }
 
@@ -58,33 +104,35 @@ struct dynamic_cvector
     {}
 
     constexpr dynamic_cvector(const dynamic_cvector& b)
-        : m_capacity{b.m_capacity}
-        , m_size{b.m_size}
-        , m_data{allocate(m_capacity)}
     {
+        reserve(b.m_size);
+
         // Copy construct the storage array elements.
 
-        for ( size_type i{}; i < m_size; ++i )
+        for ( ; m_size < b.m_size; ++m_size )
         {
-            construct(i, b[i]);
+            construct(m_size, b[m_size]);
         }
     }
 
     constexpr dynamic_cvector(dynamic_cvector&& b)
-        : m_capacity{std::exchange(b.m_capacity, 0)}
-        , m_size{std::exchange(b.m_size, 0)}
-        , m_data{std::exchange(b.m_data, nullptr)}
-    {}
+        : m_resource{b.m_resource}
+    {
+        take(std::move(b));
+    }
 
     constexpr auto operator=(const dynamic_cvector& b) -> dynamic_cvector&
     {
-        // if `b` has a larger capacity, then clear and reallocate our storage array
-        if ( m_capacity < b.m_capacity )
+        // if `b` has more elements than fit, then clear and reallocate our storage array
+        if ( m_capacity < b.m_size )
         {
             clear();
             deallocate(m_data, m_capacity);
-            m_data = allocate(b.m_capacity);
-            m_capacity = b.m_capacity;
+
+            m_data     = nullptr;
+            m_capacity = 0;
+
+            reserve(b.m_size);
         }
 
         // copy assign or construct as necessary
@@ -110,16 +158,23 @@ struct dynamic_cvector
 
     constexpr auto operator=(dynamic_cvector&& b) -> dynamic_cvector&
     {
+        if ( this == std::addressof(b) )
+        {
+            return *this;
+        }
+
         // destroy our active storage array
 
         clear();
         deallocate(m_data, m_capacity);
 
+        m_data     = nullptr;
+        m_capacity = 0;
+        m_resource = b.m_resource;
+
         // and take all of b's data
 
-        m_capacity = std::exchange(b.m_capacity, 0);
-        m_size     = std::exchange(b.m_size, 0);
-        m_data     = std::exchange(b.m_data, nullptr);
+        take(std::move(b));
 
         return *this;
     }
@@ -183,12 +238,12 @@ struct dynamic_cvector
         return m_data[m_size - 1];
     }
 
-    [[nodiscard]] auto data() const -> const pointer
+    [[nodiscard]] constexpr auto data() const -> const pointer
     {
         return m_data;
     }
 
-    [[nodiscard]] auto data() -> pointer
+    [[nodiscard]] constexpr auto data() -> pointer
     {
         return m_data;
     }
@@ -241,7 +296,12 @@ struct dynamic_cvector
 
     [[nodiscard]] static constexpr auto max_size()
     {
-        return std::numeric_limits<decltype(m_capacity)>::max();
+        return std::numeric_limits<size_type>::max();
+    }
+
+    [[nodiscard]] constexpr auto resource() const noexcept -> platform::pmr::memory_resource*
+    {
+        return m_resource;
     }
 
     constexpr void reserve(size_type n)
@@ -259,7 +319,7 @@ struct dynamic_cvector
 
     constexpr void shrink_to_fit()
     {
-        if ( m_size < m_capacity )
+        if ( m_size < m_capacity && is_inline() == false )
         {
             reallocate(m_size);
         }
@@ -278,7 +338,7 @@ struct dynamic_cvector
 
         if ( m_size == m_capacity )
         {
-            reserve(std::max(2 * m_capacity, decltype(m_capacity){1}));
+            reserve(growth_policy::next(m_capacity));
         }
 
         return construct(m_size++, std::forward<Ts>(ts)...);
@@ -288,7 +348,7 @@ struct dynamic_cvector
     {
         if ( m_size == m_capacity )
         {
-            reserve(std::max(2 * m_capacity, decltype(m_capacity){1}));
+            reserve(growth_policy::next(m_capacity));
         }
 
         return construct(m_size++, t);
@@ -298,7 +358,7 @@ struct dynamic_cvector
     {
         if ( m_size == m_capacity )
         {
-            reserve(std::max(2 * m_capacity, decltype(m_capacity){1}));
+            reserve(growth_policy::next(m_capacity));
         }
 
         return construct(m_size++, std::move(t));
@@ -389,9 +449,54 @@ struct dynamic_cvector
 
     private:
 
+    [[nodiscard]] constexpr auto fits_inline(size_type n) const noexcept -> bool
+    {
+        return k_inline_capacity != 0u && n <= k_inline_capacity && std::is_constant_evaluated() == false;
+    }
+
+    [[nodiscard]] auto inline_data() noexcept -> pointer
+    {
+        return std::launder(reinterpret_cast<pointer>(std::addressof(m_inline)));
+    }
+
+    [[nodiscard]] constexpr auto is_inline() noexcept -> bool
+    {
+        if constexpr ( k_inline_capacity == 0u )
+        {
+            return false;
+        }
+
+        else
+        {
+            return std::is_constant_evaluated() == false && m_data != nullptr && m_data == inline_data();
+        }
+    }
+
+    // Storage for at least n elements, the capacity is updated by the caller to storage_capacity(n).
+
     [[nodiscard]] constexpr auto allocate(size_type n) -> pointer
     {
-        return (n != 0) ? m_allocator.allocate(n) : nullptr;
+        if ( n == 0 )
+        {
+            return nullptr;
+        }
+
+        if ( fits_inline(n) )
+        {
+            return inline_data();
+        }
+
+        if ( std::is_constant_evaluated() || m_resource == nullptr )
+        {
+            return std::allocator<value_type>{}.allocate(n);
+        }
+
+        return static_cast<pointer>(m_resource->allocate(n * sizeof(value_type), alignof(value_type)));
+    }
+
+    [[nodiscard]] constexpr auto storage_capacity(size_type n) const noexcept -> size_type
+    {
+        return n != 0 && fits_inline(n) ? k_inline_capacity : n;
     }
 
     constexpr void deallocate(
@@ -399,10 +504,43 @@ struct dynamic_cvector
       size_type n
     )
     {
-        if ( ptr )
+        if ( ptr == nullptr || (k_inline_capacity != 0u && std::is_constant_evaluated() == false && ptr == inline_data()) )
+        {
+            return;
+        }
+
+        if ( std::is_constant_evaluated() || m_resource == nullptr )
         {
-            m_allocator.deallocate(ptr, n);
+            std::allocator<value_type>{}.deallocate(ptr, n);
+            return;
         }
+
+        m_resource->deallocate(ptr, n * sizeof(value_type), alignof(value_type));
+    }
+
+    // Take the elements of b into this empty vector, whose memory resource is already set.
+    // Inline elements are moved one by one.
+
+    constexpr void take(dynamic_cvector&& b)
+    {
+        if ( b.is_inline() )
+        {
+            m_data     = inline_data();
+            m_capacity = k_inline_capacity;
+
+            for ( ; m_size < b.m_size; ++m_size )
+            {
+                construct(m_size, std::move(b.m_data[m_size]));
+            }
+
+            b.clear();
+
+            return;
+        }
+
+        m_capacity = std::exchange(b.m_capacity, 0);
+        m_size     = std::exchange(b.m_size, 0);
+        m_data     = std::exchange(b.m_data, nullptr);
     }
 
     template <class... Ts>
@@ -426,20 +564,19 @@ struct dynamic_cvector
         for ( size_type i{}; i < m_size; ++i )
         {
             construct(i, std::move(old[i]));
+            std::destroy_at(old + i);
         }
 
-        if ( old != nullptr )
-        {
-            m_allocator.deallocate(old, m_capacity);
-        }
+        deallocate(old, m_capacity);
 
-        m_capacity = n;
+        m_capacity = storage_capacity(n);
     }
 
-    allocator_type m_allocator{};
-    size_type      m_capacity{};
-    size_type      m_size{};
-    pointer        m_data{};
+    platform::pmr::memory_resource*           m_resource{};
+    size_type                                 m_capacity{};
+    size_type                                 m_size{};
+    pointer                                   m_data{};
+    [[no_unique_address]] inline_storage_type m_inline;
 };
 
 template <typename T, std::convertible_to<T>... Ts>
@@ -448,8 +585,8 @@ dynamic_cvector(std::in_place_t, T, Ts...) -> dynamic_cvector<T>;
 template <typename T, std::convertible_to<T>... Ts>
 dynamic_cvector(std::in_place_type_t<T>, Ts...) -> dynamic_cvector<T>;
 
-template <typename T, typename F>
-constexpr auto erase_if(acme::dynamic_cvector<T>& c, F pred)
+template <typename T, std::size_t k_inline_capacity, typename growth_policy, typename F>
+constexpr auto erase_if(acme::dynamic_cvector<T, k_inline_capacity, growth_policy>& c, F pred)
 {
     const auto begin = c.begin();
     const auto end   = c.end();
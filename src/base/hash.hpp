@@ -11,20 +11,33 @@ concept container_like = requires(T container)
 
 // initial source from: https://gist.github.com/Lee-R/3839813
 
+constexpr auto k_fnv1a_init  = std::uint32_t{2'1661'362'61u};
+constexpr auto k_fnv1a_prime = std::uint32_t{1'6777'619u};
+
+// One character of the hash, for hashing text while it is scanned.
+
+[[nodiscard]] constexpr auto hash_fnv1a_step(
+    std::uint32_t hash,
+    char          c) noexcept -> std::uint32_t
+{
+    hash ^= c;
+    hash *= k_fnv1a_prime;
+
+    return hash;
+}
+
 [[nodiscard]] constexpr auto hash_fnv1a(
     const container_like auto& container,
     std::uint32_t              hash_init) noexcept
 {
     // FNV-1a hash. See: http://www.isthe.com/chongo/tech/comp/fnv/
 
-    constexpr auto hash_prime = std::uint32_t{1'6777'619u};
-
     auto hash = hash_init;
 
     for ( const auto i : container )
     {
         hash ^= i;
-        hash *= hash_prime;
+        hash *= k_fnv1a_prime;
     }
 
     return hash;
@@ -32,9 +45,7 @@ concept container_like = requires(T container)
 
 [[nodiscard]] constexpr auto hash_fnv1a(const container_like auto& container) noexcept
 {
-    constexpr auto hash_init  = std::uint32_t{2'1661'362'61u};
-
-    return hash_fnv1a(container, hash_init);
+    return hash_fnv1a(container, k_fnv1a_init);
 }
 
 } // namespace acme::detail
@@ -53,6 +64,16 @@ struct identifier
         : m_hash{acme::detail::hash_fnv1a(s)}
         {}
 
+    // Identifier of a name hashed before, e.g. by the tokenizer or the string pool.
+
+    [[nodiscard]] static constexpr auto from_hash(value_type hash) noexcept -> identifier
+    {
+        auto id   = identifier{};
+        id.m_hash = hash;
+
+        return id;
+    }
+
     constexpr identifier(const identifier&)                = default;
     constexpr identifier(identifier&&) noexcept            = default;
 
@@ -29,9 +29,12 @@ struct stack : public std::array<T, N>
     using base::operator[];
     using base::at;
 
+    // Depth checks can be disabled by the caller if the stack depth is known to be in range.
+
+    template <bool k_checked = true>
     constexpr auto push_back(const T& value)
     {
-        if ( std::is_constant_evaluated() == false )
+        if ( k_checked && std::is_constant_evaluated() == false )
         {
             assert(num_entries < N);
         }
@@ -40,10 +43,10 @@ struct stack : public std::array<T, N>
         ++num_entries;
     }
 
-    template <typename V>
+    template <bool k_checked = true, typename V>
     constexpr auto push_back(V&& value)
     {
-        if ( std::is_constant_evaluated() == false )
+        if ( k_checked && std::is_constant_evaluated() == false )
         {
             assert(num_entries < N);
         }
@@ -61,9 +64,10 @@ struct stack : public std::array<T, N>
         }
     }
 
-    constexpr auto pop_back()
+    template <bool k_checked = true>
+    constexpr auto pop_back() -> T
     {
-        if ( std::is_constant_evaluated() == false )
+        if ( k_checked && std::is_constant_evaluated() == false )
         {
             assert(num_entries > decltype(num_entries){});
         }
@@ -110,4 +114,123 @@ struct stack : public std::array<T, N>
     std::size_t num_entries{};
 };
 
+// Stack over storage owned by the caller, e.g. sized per execution from the maximum depth
+// recorded in the bytecode. The storage is uninitialized, entries are constructed on push
+// and destroyed on pop.
+
+template <typename T>
+struct stack<std::dynamic_extent, T>
+{
+    using item_type    = T;
+    using storage_type = std::span<T>;
+
+    constexpr stack() = default;
+
+    constexpr explicit stack(storage_type storage) noexcept
+        : m_storage{storage}
+    {}
+
+    constexpr stack(const stack&)            = delete;
+    constexpr stack& operator=(const stack&) = delete;
+
+    constexpr ~stack()
+    {
+        clear();
+    }
+
+    // Move the entries to new storage and return the previous storage to the caller.
+
+    constexpr auto relocate(storage_type storage) -> storage_type
+    {
+        if ( std::is_constant_evaluated() == false )
+        {
+            assert(storage.size() >= num_entries);
+        }
+
+        for ( std::size_t i{}; i < num_entries; ++i )
+        {
+            std::construct_at(storage.data() + i, std::move(m_storage[i]));
+            std::destroy_at(m_storage.data() + i);
+        }
+
+        return std::exchange(m_storage, storage);
+    }
+
+    template <bool k_checked = true, typename V>
+    constexpr auto push_back(V&& value)
+    {
+        if ( k_checked && std::is_constant_evaluated() == false )
+        {
+            assert(num_entries < m_storage.size());
+        }
+
+        std::construct_at(m_storage.data() + num_entries, std::forward<V>(value));
+        ++num_entries;
+    }
+
+    template <bool k_checked = true>
+    constexpr auto pop_back() -> T
+    {
+        if ( k_checked && std::is_constant_evaluated() == false )
+        {
+            assert(num_entries > decltype(num_entries){});
+        }
+
+        --num_entries;
+
+        auto value = std::move(m_storage[num_entries]);
+        std::destroy_at(m_storage.data() + num_entries);
+
+        return value;
+    }
+
+    [[nodiscard]] constexpr auto get(const std::size_t entry) const -> const item_type&
+    {
+        return m_storage[entry];
+    }
+
+    [[nodiscard]] constexpr auto get(const std::size_t entry) -> item_type&
+    {
+        return m_storage[entry];
+    }
+
+    [[nodiscard]] constexpr auto top() const
+    {
+        return m_storage[num_entries - 1];
+    }
+
+    [[nodiscard]] constexpr auto size() const noexcept
+    {
+        return num_entries;
+    }
+
+    [[nodiscard]] constexpr auto capacity() const noexcept
+    {
+        return m_storage.size();
+    }
+
+    [[nodiscard]] constexpr auto storage() const noexcept -> storage_type
+    {
+        return m_storage;
+    }
+
+    [[nodiscard]] constexpr bool empty() const noexcept
+    {
+        return num_entries == 0;
+    }
+
+    constexpr void clear()
+    {
+        while ( not empty() )
+        {
+            pop_back();
+        }
+    }
+
+    private:
+
+    storage_type m_storage{};
+    std::size_t  num_entries{};
+};
+
 } // namespace acme
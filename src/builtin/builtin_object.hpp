@@ -2,17 +2,33 @@
 
 namespace acme {
 
+struct object_data;
+
+// Reference to an object or array of the object heap of a virtual machine. Objects compare
+// equal when they are the same object.
+
 struct object
 {
     constexpr object() = default;
 
+    explicit constexpr object(acme::object_data* data) noexcept
+        : m_data{data}
+        {}
+
     [[nodiscard]] constexpr auto instanceof(const acme::object& v) const noexcept
     {
         return false;
     }
 
+    [[nodiscard]] constexpr auto data() const noexcept -> acme::object_data*
+    {
+        return m_data;
+    }
+
     [[nodiscard]] constexpr bool operator==(const object& rhs) const noexcept = default;
     [[nodiscard]] constexpr bool operator!=(const object& rhs) const noexcept = default;
+
+    acme::object_data* m_data{};
 };
 
 } // namespace acme
@@ -5,7 +5,7 @@ namespace acme {
 struct string
 {
     using value_type     = std::string_view;
-    using reference_type = std::reference_wrapper<acme::pool_string>;
+    using reference_type = acme::pool_string;
     using variant_type   = std::variant
                             <
                                 std::monostate,
@@ -20,6 +20,12 @@ struct string
         : m_value{v}
         {}
 
+    // Keeps the interned string alive for as long as the value exists.
+
+    explicit constexpr string(reference_type v)
+        : m_value{std::move(v)}
+        {}
+
     constexpr string& operator=(value_type v) noexcept
     {
         m_value = v;
@@ -48,10 +54,7 @@ struct string
 
         if ( std::holds_alternative<reference_type>(m_value) )
         {
-            if ( auto ref = deref(ptr); ref.get() != nullptr )
-            {
-                return ref.get().view();
-            }
+            return deref(ptr).view();
         }
 
         else if ( std::holds_alternative<value_type>(m_value) )
@@ -62,6 +65,18 @@ struct string
         return {};
     }
 
+    // Convert to a number. Interned strings cache the result in the string pool.
+
+    [[nodiscard]] constexpr auto to_number() const noexcept -> double
+    {
+        if ( const auto* ref = std::get_if<reference_type>(std::addressof(m_value)); ref != nullptr )
+        {
+            return ref->to_number();
+        }
+
+        return numeric::string_to_number(value());
+    }
+
     variant_type m_value{};
 };
 
@@ -3,7 +3,11 @@
 #include "opcode.hpp"
 #include "number_constant.hpp"
 #include "string_constant.hpp"
+#include "symbol.hpp"
 #include "instruction.hpp"
+#include "native_call.hpp"
+#include "host_field.hpp"
+#include "stack_effect.hpp"
 
 namespace acme {
 
@@ -13,6 +17,7 @@ struct bytecode
     using number_constants_view = std::span<const acme::number_constant>;
     using string_constants_view = std::span<const acme::string_constant>;
     using string_buffer_view    = std::span<const char>;
+    using symbols_view          = std::span<const acme::symbol>;
 
     constexpr bytecode() = default;
 
@@ -20,14 +25,38 @@ struct bytecode
         instructions_view     instructions,
         number_constants_view number_constants = {},
         string_constants_view string_constant  = {},
-        string_buffer_view    string_buffer  = {}
+        string_buffer_view    string_buffer  = {},
+        std::size_t           max_stack_depth = {},
+        symbols_view          symbols = {}
     )
         : m_instructions{instructions}
         , m_number_constants{number_constants}
         , m_string_constants{string_constant}
         , m_string_buffer{string_buffer}
+        , m_symbols{symbols}
+        , m_max_stack_depth{max_stack_depth}
     {}
 
+    // Operand stack depth needed to execute the instructions. Recorded by the emitter and
+    // acme::verify(), computed from the instructions for bytecode assembled by hand.
+
+    [[nodiscard]] constexpr auto max_stack_depth() const noexcept -> std::size_t
+    {
+        if ( m_max_stack_depth == 0 )
+        {
+            return acme::max_stack_depth(m_instructions);
+        }
+
+        return m_max_stack_depth;
+    }
+
+    // Set by acme::verify() once the instructions and constants have been checked.
+
+    [[nodiscard]] constexpr auto verified() const noexcept
+    {
+        return m_verified;
+    }
+
     [[nodiscard]] constexpr auto instruction(std::size_t offset) const -> std::optional<acme::instruction>
     {
         if ( offset < m_instructions.size() )
@@ -53,12 +82,57 @@ struct bytecode
         return m_number_constants[offset].m_hash;
     }
 
-    template <typename T>
+    [[nodiscard]] constexpr auto symbols() const noexcept -> symbols_view
+    {
+        return m_symbols;
+    }
+
+    [[nodiscard]] constexpr auto symbol_name(std::size_t symbol) const -> std::string_view
+    {
+        const auto& [id, buffer_offset, length] = m_symbols[symbol];
+
+        return std::string_view{m_string_buffer.data() + buffer_offset, length};
+    }
+
+    // Symbol id of a name of the program.
+
+    [[nodiscard]] constexpr auto find_symbol(std::string_view name) const -> std::optional<std::size_t>
+    {
+        for ( std::size_t symbol{}; symbol < m_symbols.size(); symbol++ )
+        {
+            if ( symbol_name(symbol) == name )
+            {
+                return symbol;
+            }
+        }
+
+        return {};
+    }
+
+    // Identifier the program declares the variable of the name with. Bytecode without
+    // symbols, e.g. assembled by hand, uses the hash of the name.
+
+    [[nodiscard]] constexpr auto var_id(std::string_view name) const -> acme::identifier
+    {
+        if ( const auto symbol = find_symbol(name); symbol.has_value() )
+        {
+            return m_symbols[symbol.value()].m_id;
+        }
+
+        return acme::identifier{name};
+    }
+
+    template <typename T, bool k_checked = true>
     [[nodiscard]] constexpr auto constant(std::size_t offset) const -> acme::script_value
     {
-        if ( offset >= m_number_constants.size() )
+        if constexpr ( k_checked )
         {
-            return {};
+            const auto count = std::is_same_v<T, acme::string> ? m_string_constants.size() : m_number_constants.size();
+
+            if ( offset >= count )
+            {
+                return {};
+            }
         }
 
         if constexpr ( std::is_same_v<T, double> )
@@ -95,6 +169,9 @@ struct bytecode
     number_constants_view m_number_constants{};
     string_constants_view m_string_constants{};
     string_buffer_view    m_string_buffer{};
+    symbols_view          m_symbols{};
+    std::size_t           m_max_stack_depth{};
+    bool                  m_verified{};
 };
 
 } // namespace acme
@@ -0,0 +1,69 @@
+#pragma once
+
+namespace acme {
+
+// Representation of a field of a host object in native memory.
+
+enum class host_field_type : std::uint8_t
+{
+    k_f64 = 0u,
+    k_f32,
+    k_i64,
+    k_u64,
+    k_i32,
+    k_u32,
+    k_i16,
+    k_u16,
+    k_i8,
+    k_u8,
+    k_bool,
+    k_getter,   // The offset is the index of the getter function of the host type.
+};
+
+// Field of a host type as seen by the emitter.
+
+struct host_field
+{
+    acme::identifier m_name{};
+    host_field_type  m_type{};
+    std::uint16_t    m_offset{};
+};
+
+// Name a script uses for a host object, the index in the list of bindings is the host object slot.
+
+struct host_binding
+{
+    acme::identifier                  m_name{};
+    std::span<const acme::host_field> m_fields{};
+};
+
+// The immediate of load_host_field holds the field type, the host object slot and the byte
+// offset of the field, so an access is a typed load without looking up the field.
+
+inline constexpr std::size_t k_max_host_objects     = 16u;
+inline constexpr std::size_t k_max_host_field_offset = 0xFFFFu;
+
+[[nodiscard]] constexpr auto host_field_immediate(
+    std::size_t       slot,
+    const host_field& field
+) noexcept -> instruction::immediate_type
+{
+    return static_cast<instruction::immediate_type>(static_cast<std::size_t>(field.m_type) << 20u | slot << 16u | field.m_offset);
+}
+
+[[nodiscard]] constexpr auto host_field_type_of(instruction::immediate_type imm) noexcept -> host_field_type
+{
+    return static_cast<host_field_type>((imm >> 20u) & 0xFu);
+}
+
+[[nodiscard]] constexpr auto host_field_slot(instruction::immediate_type imm) noexcept -> std::size_t
+{
+    return (imm >> 16u) & 0xFu;
+}
+
+[[nodiscard]] constexpr auto host_field_offset(instruction::immediate_type imm) noexcept -> std::size_t
+{
+    return imm & 0xFFFFu;
+}
+
+} // namespace acme
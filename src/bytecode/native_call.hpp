@@ -0,0 +1,34 @@
+#pragma once
+
+namespace acme {
+
+// Name and argument count of a native function callable from scripts.
+
+struct native_signature
+{
+    acme::identifier m_name{};
+    std::uint8_t     m_arity{};
+};
+
+// The immediate of call_native holds the index of the function in the native registry and
+// the number of arguments on the operand stack.
+
+[[nodiscard]] constexpr auto native_call_immediate(
+    std::size_t  index,
+    std::uint8_t arity
+) noexcept -> instruction::immediate_type
+{
+    return static_cast<instruction::immediate_type>(index << 8u | arity);
+}
+
+[[nodiscard]] constexpr auto native_call_index(instruction::immediate_type imm) noexcept -> std::size_t
+{
+    return imm >> 8u;
+}
+
+[[nodiscard]] constexpr auto native_call_arity(instruction::immediate_type imm) noexcept -> std::uint8_t
+{
+    return static_cast<std::uint8_t>(imm & 0xFFu);
+}
+
+} // namespace acme
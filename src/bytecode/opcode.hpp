@@ -38,9 +38,34 @@ enum class opcode : std::uint8_t
     jump_if_false,
     jump_if_true,
     jump_to,
+    load_param,
+    call_native,
+    load_host_field,
     no_opearation,
+
+    // Quickened opcodes. These are never emitted, the virtual machine rewrites
+    // generic instructions into these once the type feedback is monomorphic.
+
+    binary_add_number,
+    binary_add_string,
+    binary_sub_number,
+    binary_mul_number,
+    compare_strict_equal_number,
+    compare_less_than_number,
+    compare_less_than_or_equal_number,
+    compare_greater_than_number,
+    compare_greater_than_or_equal_number,
+
+    // Variables of the script scope, addressed by the symbol id in the immediate. The
+    // virtual machine links the variable accesses the emitter resolved to them.
+
+    load_global,
+    store_global,
+    initialize_global,
 };
 
+inline constexpr auto k_opcode_count = static_cast<std::size_t>(opcode::initialize_global) + 1;
+
 [[nodiscard]] static constexpr auto to_string(opcode op) noexcept -> std::string_view
 {
     using namespace std::string_view_literals;
@@ -81,7 +106,22 @@ enum class opcode : std::uint8_t
         { opcode::jump_if_false,                 "JUMP IF FALSE"sv       },
         { opcode::jump_if_true,                  "JUMP IF TRUE"sv        },
         { opcode::jump_to,                       "JUMP TO"sv             },
+        { opcode::load_param,                    "LOAD PARAM"sv          },
+        { opcode::call_native,                   "CALL NATIVE"sv         },
+        { opcode::load_host_field,               "LOAD HOST FIELD"sv     },
         { opcode::no_opearation,                 "NO OPERATION"sv        },
+        { opcode::binary_add_number,                    "+ number"sv             },
+        { opcode::binary_add_string,                    "+ string"sv             },
+        { opcode::binary_sub_number,                    "- number"sv             },
+        { opcode::binary_mul_number,                    "* number"sv             },
+        { opcode::compare_strict_equal_number,          "=== number"sv           },
+        { opcode::compare_less_than_number,             "< number"sv             },
+        { opcode::compare_less_than_or_equal_number,    "<= number"sv            },
+        { opcode::compare_greater_than_number,          "> number"sv             },
+        { opcode::compare_greater_than_or_equal_number, ">= number"sv            },
+        { opcode::load_global,                          "LOAD GLOBAL"sv          },
+        { opcode::store_global,                         "STORE GLOBAL"sv         },
+        { opcode::initialize_global,                    "INITIALIZE GLOBAL"sv    },
     });
 
     for ( auto [o, s] : k_map )
@@ -95,4 +135,52 @@ enum class opcode : std::uint8_t
     return {};
 }
 
+[[nodiscard]] constexpr auto generic_opcode(opcode op) noexcept -> opcode
+{
+    switch ( op )
+    {
+        case opcode::binary_add_number:
+        case opcode::binary_add_string:
+            return opcode::binary_add;
+
+        case opcode::binary_sub_number:
+            return opcode::binary_sub;
+
+        case opcode::binary_mul_number:
+            return opcode::binary_mul;
+
+        case opcode::compare_strict_equal_number:
+            return opcode::compare_strict_equal;
+
+        case opcode::compare_less_than_number:
+            return opcode::compare_less_than;
+
+        case opcode::compare_less_than_or_equal_number:
+            return opcode::compare_less_than_or_equal;
+
+        case opcode::compare_greater_than_number:
+            return opcode::compare_greater_than;
+
+        case opcode::compare_greater_than_or_equal_number:
+            return opcode::compare_greater_than_or_equal;
+
+        case opcode::load_global:
+            return opcode::load_var;
+
+        case opcode::store_global:
+            return opcode::store_var;
+
+        case opcode::initialize_global:
+            return opcode::initialize;
+
+        default:
+            return op;
+    }
+}
+
+[[nodiscard]] constexpr auto is_quickened(opcode op) noexcept
+{
+    return generic_opcode(op) != op;
+}
+
 } // namespace acme
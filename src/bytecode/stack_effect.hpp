@@ -0,0 +1,98 @@
+#pragma once
+
+namespace acme {
+
+// Number of operand stack values an instruction pops and pushes.
+
+struct stack_effect
+{
+    std::uint8_t m_pops{};
+    std::uint8_t m_pushes{};
+};
+
+[[nodiscard]] constexpr auto stack_effect_of(opcode op) noexcept -> stack_effect
+{
+    switch ( generic_opcode(op) )
+    {
+        case opcode::binary_add:
+        case opcode::binary_sub:
+        case opcode::binary_mul:
+        case opcode::binary_div:
+        case opcode::binary_mod:
+        case opcode::binary_pow:
+        case opcode::compare_strict_equal:
+        case opcode::compare_equal:
+        case opcode::compare_less_than:
+        case opcode::compare_less_than_or_equal:
+        case opcode::compare_greater_than:
+        case opcode::compare_greater_than_or_equal:
+        case opcode::compare_instanceof:
+            return { 2, 1 };
+
+        case opcode::typeof_value:
+        case opcode::unary_delete:
+        case opcode::unary_negate:
+        case opcode::load_var:
+            return { 1, 1 };
+
+        case opcode::store_var:
+        case opcode::initialize:
+            return { 2, 0 };
+
+        case opcode::constant_double:
+        case opcode::constant_i32:
+        case opcode::constant_u32:
+        case opcode::constant_string:
+        case opcode::constant_identifier:
+        case opcode::push_bool_true:
+        case opcode::push_bool_false:
+        case opcode::push_undefined:
+        case opcode::push_null:
+        case opcode::load_param:
+        case opcode::load_host_field:
+            return { 0, 1 };
+
+        case opcode::duplicate_top:
+            return { 1, 2 };
+
+        case opcode::jump_if_false:
+        case opcode::jump_if_true:
+            return { 1, 0 };
+
+        default:
+            return { 0, 0 };
+    }
+}
+
+// Stack effect of an instruction. A native call pops its arguments, the count is encoded in the immediate.
+
+[[nodiscard]] constexpr auto stack_effect_of(acme::instruction ins) noexcept -> stack_effect
+{
+    if ( operand(ins) == opcode::call_native )
+    {
+        return { native_call_arity(immediate(ins)), 1 };
+    }
+
+    return stack_effect_of(operand(ins));
+}
+
+// Maximum operand stack depth of straight-line code. The emitter produces structured
+// code where every statement leaves the stack as it found it, for which this is exact.
+
+[[nodiscard]] constexpr auto max_stack_depth(std::span<const acme::instruction> instructions) noexcept -> std::size_t
+{
+    auto depth     = std::ptrdiff_t{};
+    auto max_depth = std::ptrdiff_t{};
+
+    for ( const auto ins : instructions )
+    {
+        const auto effect = stack_effect_of(ins);
+
+        depth     = std::max<std::ptrdiff_t>(depth - effect.m_pops, 0) + effect.m_pushes;
+        max_depth = std::max(max_depth, depth);
+    }
+
+    return static_cast<std::size_t>(max_depth);
+}
+
+} // namespace acme
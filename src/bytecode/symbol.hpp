@@ -0,0 +1,21 @@
+#pragma once
+
+namespace acme {
+
+// Name of a program, indexed by its symbol id. Symbol ids are dense: the names of a program
+// are numbered from zero in the order the emitter first meets them.
+//
+// m_id is the identifier the variable of the name is declared with. It is the hash of the
+// name, unless an other name of the program has the same hash.
+
+struct symbol
+{
+    acme::identifier m_id;
+    std::uint32_t    m_buffer_offset;
+    std::uint32_t    m_length;
+};
+
+static_assert(std::is_standard_layout<symbol>::value, "");
+static_assert(sizeof(symbol) == 12, "");
+
+} // namespace acme
@@ -0,0 +1,229 @@
+#pragma once
+
+namespace acme {
+
+enum class verify_error : std::uint8_t
+{
+    none = 0u,
+    invalid_opcode,
+    jump_out_of_range,
+    constant_out_of_range,
+    stack_underflow,
+    stack_overflow,
+    stack_mismatch,
+    scope_underflow,
+    scope_mismatch,
+};
+
+struct verify_result
+{
+    [[nodiscard]] constexpr explicit operator bool() const noexcept
+    {
+        return m_error == verify_error::none;
+    }
+
+    verify_error m_error{};
+    std::size_t  m_offset{};          // Offset of the offending instruction.
+    std::size_t  m_max_stack_depth{};
+};
+
+namespace detail {
+
+// Operand stack and scope depth on entry to an instruction.
+
+struct verify_state
+{
+    [[nodiscard]] constexpr auto operator==(const verify_state&) const noexcept -> bool = default;
+
+    std::int32_t m_stack_depth{-1};
+    std::int32_t m_scope_depth{};
+};
+
+[[nodiscard]] constexpr auto check_operands(
+    const bytecode&   code,
+    acme::instruction ins
+) noexcept -> verify_error
+{
+    const auto imm = static_cast<std::size_t>(immediate(ins));
+
+    switch ( operand(ins) )
+    {
+        case opcode::constant_double:
+        case opcode::constant_i32:
+        case opcode::constant_u32:
+        case opcode::constant_identifier:
+            return imm < code.m_number_constants.size() ? verify_error::none : verify_error::constant_out_of_range;
+
+        case opcode::constant_string:
+        {
+            if ( imm >= code.m_string_constants.size() )
+            {
+                return verify_error::constant_out_of_range;
+            }
+
+            const auto& str = code.m_string_constants[imm];
+
+            if ( std::size_t{str.m_buffer_offset} + str.m_length > code.m_string_buffer.size() )
+            {
+                return verify_error::constant_out_of_range;
+            }
+
+            return verify_error::none;
+        }
+
+        case opcode::jump_if_false:
+        case opcode::jump_if_true:
+        case opcode::jump_to:
+            return imm < code.m_instructions.size() ? verify_error::none : verify_error::jump_out_of_range;
+
+        // One plus the symbol id of a variable of the script scope, or zero.
+
+        case opcode::load_var:
+        case opcode::store_var:
+        case opcode::initialize:
+            return imm <= code.m_symbols.size() ? verify_error::none : verify_error::constant_out_of_range;
+
+        default:
+            return static_cast<std::size_t>(operand(ins)) < k_opcode_count ? verify_error::none : verify_error::invalid_opcode;
+    }
+}
+
+} // namespace detail
+
+/* Verify the bytecode once before it is executed:
+
+    - Opcodes are valid, jump targets and constant indices are in range.
+    - The operand stack never underflows and its depth at the start of each
+      instruction is the same on every path that reaches it.
+    - The maximum depth of the operand stack fits in the given capacity.
+    - Stack frames are never popped below the frame of the script.
+
+    On success the bytecode is marked verified, its exact maximum stack depth is recorded
+    and the virtual machine executes it without per-instruction bounds or stack depth checks.
+*/
+
+[[nodiscard]] constexpr auto verify(
+    bytecode&   code,
+    std::size_t stack_capacity
+) -> verify_result
+{
+    using state_type = detail::verify_state;
+
+    const auto instructions = code.instructions();
+
+    auto states   = acme::dynamic_cvector<state_type>(instructions.size() + 1);
+    auto worklist = acme::dynamic_cvector<std::size_t>{};
+    auto result   = verify_result{};
+
+    code.m_verified = false;
+
+    const auto fail = [&](verify_error error, std::size_t offset)
+    {
+        result.m_error  = error;
+        result.m_offset = offset;
+
+        return result;
+    };
+
+    // Merge the state into a successor. The state must match on every path reaching it.
+
+    const auto flow_to = [&](std::size_t target, state_type state)
+    {
+        if ( states[target].m_stack_depth < 0 )
+        {
+            states[target] = state;
+
+            if ( target < instructions.size() )
+            {
+                worklist.push_back(target);
+            }
+
+            return verify_error::none;
+        }
+
+        if ( states[target].m_stack_depth != state.m_stack_depth )
+        {
+            return verify_error::stack_mismatch;
+        }
+
+        return states[target] == state ? verify_error::none : verify_error::scope_mismatch;
+    };
+
+    // The script is executed with an empty stack in the first frame.
+
+    if ( const auto error = flow_to(0, state_type{ .m_stack_depth = 0, .m_scope_depth = 1 }); error != verify_error::none )
+    {
+        return fail(error, 0);
+    }
+
+    while ( worklist.empty() == false )
+    {
+        const auto pc  = worklist.back();
+        const auto ins = instructions[pc];
+        const auto op  = operand(ins);
+
+        worklist.pop_back();
+
+        if ( const auto error = detail::check_operands(code, ins); error != verify_error::none )
+        {
+            return fail(error, pc);
+        }
+
+        auto       state  = states[pc];
+        const auto effect = stack_effect_of(ins);
+
+        if ( state.m_stack_depth < effect.m_pops )
+        {
+            return fail(verify_error::stack_underflow, pc);
+        }
+
+        state.m_stack_depth += effect.m_pushes - effect.m_pops;
+
+        if ( static_cast<std::size_t>(state.m_stack_depth) > stack_capacity )
+        {
+            return fail(verify_error::stack_overflow, pc);
+        }
+
+        result.m_max_stack_depth = std::max(result.m_max_stack_depth, static_cast<std::size_t>(state.m_stack_depth));
+
+        if ( op == opcode::push_stack_frame )
+        {
+            state.m_scope_depth++;
+        }
+
+        else if ( op == opcode::pop_stack_frame )
+        {
+            state.m_scope_depth -= static_cast<std::int32_t>(immediate(ins));
+
+            if ( state.m_scope_depth < 1 )
+            {
+                return fail(verify_error::scope_underflow, pc);
+            }
+        }
+
+        // Successors: the branch target and, unless the jump is unconditional, the next instruction.
+
+        if ( op == opcode::jump_to || op == opcode::jump_if_false || op == opcode::jump_if_true )
+        {
+            if ( const auto error = flow_to(immediate(ins), state); error != verify_error::none )
+            {
+                return fail(error, pc);
+            }
+        }
+
+        if ( op != opcode::jump_to )
+        {
+            if ( const auto error = flow_to(pc + 1, state); error != verify_error::none )
+            {
+                return fail(error, pc);
+            }
+        }
+    }
+
+    code.m_verified        = true;
+    code.m_max_stack_depth = result.m_max_stack_depth;
+
+    return result;
+}
+
+} // namespace acme
@@ -0,0 +1,123 @@
+#pragma once
+
+namespace acme {
+
+// String literal that can be passed as a non-type template parameter.
+
+template <std::size_t N>
+struct fixed_string
+{
+    constexpr fixed_string(const char (&text)[N]) noexcept
+    {
+        std::copy_n(text, N, m_data);
+    }
+
+    [[nodiscard]] constexpr auto view() const noexcept -> std::string_view
+    {
+        return std::string_view{m_data, N - 1};
+    }
+
+    char m_data[N]{};
+};
+
+// Bytecode of a script that was compiled during constant evaluation. All of the
+// instructions and constants are stored inline so the object can live in read-only memory.
+
+template <
+    std::size_t k_instruction_count,
+    std::size_t k_number_count,
+    std::size_t k_string_count,
+    std::size_t k_buffer_size,
+    std::size_t k_symbol_count
+>
+struct compiled_script
+{
+    [[nodiscard]] constexpr auto bytecode() const noexcept -> acme::bytecode
+    {
+        return acme::bytecode
+        {
+            std::span{m_instructions},
+            std::span{m_number_constants},
+            std::span{m_string_constants},
+            std::span{m_string_buffer},
+            m_max_stack_depth,
+            std::span{m_symbols},
+        };
+    }
+
+    std::array<acme::instruction, k_instruction_count>  m_instructions{};
+    std::array<acme::number_constant, k_number_count>   m_number_constants{};
+    std::array<acme::string_constant, k_string_count>   m_string_constants{};
+    std::array<char, k_buffer_size>                     m_string_buffer{};
+    std::array<acme::symbol, k_symbol_count>            m_symbols{};
+    std::size_t                                         m_max_stack_depth{};
+};
+
+namespace detail {
+
+// Tokenize, parse and emit the given script and pass the resulting bytecode to the callback.
+// The AST and the emitter buffers are released before returning.
+
+constexpr auto compile_script(
+    std::string_view script,
+    auto&&           callback
+)
+{
+    acme::parser script_parser{script, nullptr};
+    script_parser.parse_all();
+
+    acme::emit_context context{};
+    acme::emit(script_parser.ast_nodes(), context);
+
+    return callback(context.bytecode());
+}
+
+template <fixed_string k_script>
+constexpr auto compiled_sizes() -> std::array<std::size_t, 5>
+{
+    return compile_script(k_script.view(), [](const acme::bytecode& code)
+    {
+        return std::array
+        {
+            code.m_instructions.size(),
+            code.m_number_constants.size(),
+            code.m_string_constants.size(),
+            code.m_string_buffer.size(),
+            code.m_symbols.size(),
+        };
+    });
+}
+
+} // namespace detail
+
+// Compile a script literal to bytecode at compile time:
+//
+//     static constexpr auto k_script = acme::compile<"x = 1 + y">();
+//     vm.execute(k_script.bytecode());
+//
+// The pipeline runs twice: first to size the arrays and then to fill them.
+
+template <fixed_string k_script>
+[[nodiscard]] consteval auto compile()
+{
+    constexpr auto k_sizes = detail::compiled_sizes<k_script>();
+
+    using result_type = compiled_script<k_sizes[0], k_sizes[1], k_sizes[2], k_sizes[3], k_sizes[4]>;
+
+    return detail::compile_script(k_script.view(), [](const acme::bytecode& code)
+    {
+        result_type result{};
+
+        std::copy(code.m_instructions.begin(), code.m_instructions.end(), result.m_instructions.begin());
+        std::copy(code.m_number_constants.begin(), code.m_number_constants.end(), result.m_number_constants.begin());
+        std::copy(code.m_string_constants.begin(), code.m_string_constants.end(), result.m_string_constants.begin());
+        std::copy(code.m_string_buffer.begin(), code.m_string_buffer.end(), result.m_string_buffer.begin());
+        std::copy(code.m_symbols.begin(), code.m_symbols.end(), result.m_symbols.begin());
+
+        result.m_max_stack_depth = code.max_stack_depth();
+
+        return result;
+    });
+}
+
+} // namespace acme
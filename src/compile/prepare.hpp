@@ -0,0 +1,85 @@
+#pragma once
+
+namespace acme {
+
+/* Expression compiled once and evaluated with different arguments, like a prepared statement:
+
+       const std::string_view names[] = { "price", "quantity" };
+       const auto expression = acme::prepared_expression{"price * quantity > 100", names};
+
+       auto result = acme::evaluate(vm, expression, arguments);
+
+    Parameters are bound to fixed slots when the expression is compiled and read with
+    load_param, so an evaluation does not parse, hash identifiers or declare variables.
+    The result is the value of the last expression statement.
+*/
+
+struct prepared_expression
+{
+    prepared_expression(
+        std::string_view                   source,
+        std::span<const std::string_view>  parameters
+    )
+        : m_parameter_count{parameters.size()}
+    {
+        auto names = acme::dynamic_cvector<acme::identifier>{};
+
+        for ( const auto name : parameters )
+        {
+            names.push_back(acme::identifier{name});
+        }
+
+        platform::pmr::monotonic_buffer_resource resource{};
+
+        acme::parser script_parser{source, std::addressof(resource)};
+        script_parser.parse_all();
+
+        m_context.parameters(names);
+        acme::emit(script_parser.ast_nodes(), m_context);
+
+        // Verified bytecode is evaluated without bounds checks.
+
+        m_bytecode = m_context.bytecode();
+
+        [[maybe_unused]] const auto result = acme::verify(m_bytecode, acme::virtual_machine::k_max_stack_depth);
+    }
+
+    // The bytecode refers to the storage of the emitter.
+
+    prepared_expression(const prepared_expression&)            = delete;
+    prepared_expression& operator=(const prepared_expression&) = delete;
+
+    [[nodiscard]] auto bytecode() const noexcept -> const acme::bytecode&
+    {
+        return m_bytecode;
+    }
+
+    [[nodiscard]] auto parameter_count() const noexcept -> std::size_t
+    {
+        return m_parameter_count;
+    }
+
+    private:
+
+    acme::emit_context m_context{};
+    acme::bytecode     m_bytecode{};
+    std::size_t        m_parameter_count{};
+};
+
+// Evaluate the expression with one argument per parameter, in the order the parameters were declared.
+
+inline auto evaluate(
+    acme::virtual_machine&              vm,
+    const prepared_expression&          expression,
+    std::span<const acme::script_value> arguments
+) -> acme::script_value
+{
+    if ( std::is_constant_evaluated() == false )
+    {
+        assert(arguments.size() == expression.parameter_count());
+    }
+
+    return vm.evaluate(expression.bytecode(), arguments);
+}
+
+} // namespace acme
@@ -1,4 +1,3 @@
-
 #include "memory/memory.hpp"
 #include "base/base.hpp"
 #include "string_pool/string_pool.hpp"
@@ -11,36 +10,3 @@
 #include "bytecode/bytecode.hpp"
 #include "virtual_machine/virtual_machine.hpp"
 #include "emit.hpp"
-#include "concepts.hpp"
-#include "emit_visit.hpp"
-#include "emit_visitor.hpp"
-
-namespace acme::eval {
-
-auto emit(
-    const ast::UniqueAstNode& p,
-    emit_context&            context
-) -> acme::script_value
-{
-    return eval::visit(eval::emit_visitor, p, context);
-}
-
-} // namespace acme::eval
-
-namespace acme {
-
-void emit(
-    const acme::parser::ast_node_list_type& ast_nodes,
-    acme::emit_context&                     context
-)
-{
-    for ( auto& p : ast_nodes )
-    {
-        eval::emit(p, context);
-    }
-
-    context.emit_instruction(opcode::no_opearation);
-}
-
-} // namespace acme
-
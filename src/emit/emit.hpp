@@ -1,9 +1,24 @@
 #pragma once
 
+#include "symbol_table.hpp"
 #include "emit_context.hpp"
+#include "concepts.hpp"
+#include "emit_visit.hpp"
+#include "emit_visitor.hpp"
 
 namespace acme {
 
-void emit(const acme::parser::ast_node_list_type&, emit_context&);
+constexpr void emit(
+    const acme::parser::ast_node_list_type& ast_nodes,
+    acme::emit_context&                     context
+)
+{
+    for ( auto& p : ast_nodes )
+    {
+        eval::emit(p, context);
+    }
+
+    context.emit_instruction(opcode::no_opearation);
+}
 
 } // namespace acme
@@ -52,6 +52,11 @@ struct emit_context
     using bytecode_list_type         = acme::dynamic_cvector<acme::instruction>;
     using number_constants_list_type = acme::dynamic_cvector<acme::number_constant>;
     using string_constants_list_type = acme::dynamic_cvector<acme::string_constant>;
+    using parameters_list_type       = acme::dynamic_cvector<acme::identifier>;
+    using natives_list_type          = acme::dynamic_cvector<acme::native_signature>;
+    using host_objects_list_type     = acme::dynamic_cvector<acme::host_binding>;
+    using frames_list_type           = acme::dynamic_cvector<std::size_t>;
+    using frame_symbols_list_type    = acme::dynamic_cvector<symbol_table::symbol_type>;
 
     enum class emit_state : std::uint32_t
     {
@@ -93,6 +98,14 @@ struct emit_context
             m_loop_context->decrement_stack_frame_depth();
         }
 
+        // Instructions are emitted in the order they are executed on the straight-line path
+        // and the stack is balanced at every jump target, so a linear scan gives the exact depth.
+
+        const auto effect = stack_effect_of(instruction::make(operand, imm));
+
+        m_stack_depth     = std::max(m_stack_depth, static_cast<std::size_t>(effect.m_pops)) - static_cast<std::size_t>(effect.m_pops) + static_cast<std::size_t>(effect.m_pushes);
+        m_max_stack_depth = std::max(m_max_stack_depth, m_stack_depth);
+
         m_bytecode.push_back(instruction::make(operand, imm));
         return count();
     }
@@ -143,13 +156,13 @@ struct emit_context
 
         else if constexpr ( std::is_same_v<T, ast::String> )
         {
-            acme::identifier hash_value{ constant.value().view() };
+            const auto hash_value = acme::identifier::from_hash(constant.value().hash());
 
             decltype(strings_index) index{};
 
             for ( const auto& s : m_strings )
             {
-                if ( s.m_hash == hash_value )
+                if ( s.m_hash == hash_value && std::string_view{m_string_buffer}.substr(s.m_buffer_offset, s.m_length) == constant.value().view() )
                 {
                     emit_instruction(opcode::constant_string, index);
                     return index;
@@ -183,7 +196,7 @@ struct emit_context
 
         else if constexpr ( std::is_same_v<T, ast::Identifier> )
         {
-            acme::identifier id{ constant.value().view() };
+            const auto id = m_symbols.id(symbol(constant.value().view(), constant.value().hash()));
 
             m_numbers.emplace_back(acme::number_constant { .m_hash = id } );
             emit_instruction(opcode::constant_identifier, numbers_index);
@@ -207,6 +220,209 @@ struct emit_context
         m_loop_context = context;
     }
 
+    // Dense symbol id of a name of the program. Variables of the name are declared with
+    // symbol_id(), which differs from the ids of the other names.
+
+    [[nodiscard]] constexpr auto symbol(
+        std::string_view        name,
+        symbol_table::hash_type hash
+    ) -> symbol_table::symbol_type
+    {
+        return m_symbols.intern(name, hash, m_string_buffer);
+    }
+
+    [[nodiscard]] constexpr auto symbol(std::string_view name) -> symbol_table::symbol_type
+    {
+        return symbol(name, acme::detail::hash_fnv1a(name));
+    }
+
+    [[nodiscard]] constexpr auto symbol_id(symbol_table::symbol_type symbol) const -> acme::identifier
+    {
+        return m_symbols.id(symbol);
+    }
+
+    [[nodiscard]] constexpr auto symbols() const -> std::span<const acme::symbol>
+    {
+        return m_symbols.symbols();
+    }
+
+    // Let and const, and var in a block that declares them, live in the stack frame of the
+    // block. Other names resolve to the variables of the script scope.
+
+    constexpr auto enter_frame()
+    {
+        m_frames.push_back(m_frame_symbols.size());
+    }
+
+    constexpr auto leave_frame()
+    {
+        m_frame_symbols.resize(m_frames.pop_back());
+    }
+
+    // Immediate of a load or store of the name: one plus its symbol id if the name resolves to
+    // a variable of the script scope, zero if the variable is looked up by identifier.
+
+    [[nodiscard]] constexpr auto variable_immediate(const ast::Identifier& v) -> acme::instruction::immediate_type
+    {
+        const auto s = symbol(v.value().view(), v.value().hash());
+
+        if ( std::find(m_frame_symbols.begin(), m_frame_symbols.end(), s) != m_frame_symbols.end() )
+        {
+            return 0u;
+        }
+
+        return global_immediate(s);
+    }
+
+    // Declare the name in the innermost frame. Returns the immediate of its initialize.
+
+    [[nodiscard]] constexpr auto declare(const ast::Identifier& v) -> acme::instruction::immediate_type
+    {
+        const auto s = symbol(v.value().view(), v.value().hash());
+
+        if ( m_frames.empty() )
+        {
+            return global_immediate(s);
+        }
+
+        m_frame_symbols.push_back(s);
+
+        return 0u;
+    }
+
+    // Names read with load_param instead of load_var, the index is the parameter slot.
+
+    constexpr auto parameters(std::span<const acme::identifier> names)
+    {
+        m_parameters.clear();
+
+        for ( const auto name : names )
+        {
+            m_parameters.push_back(name);
+        }
+    }
+
+    [[nodiscard]] constexpr auto parameter_slot(acme::identifier name) const -> std::optional<std::size_t>
+    {
+        for ( std::size_t slot{}; slot < m_parameters.size(); slot++ )
+        {
+            if ( m_parameters[slot] == name )
+            {
+                return slot;
+            }
+        }
+
+        return {};
+    }
+
+    // Native functions a call expression can reach, the index is the one of the native registry.
+
+    constexpr auto natives(std::span<const acme::native_signature> signatures)
+    {
+        m_natives.clear();
+
+        for ( const auto& signature : signatures )
+        {
+            m_natives.push_back(signature);
+        }
+    }
+
+    [[nodiscard]] constexpr auto native_index(acme::identifier name) const -> std::optional<std::size_t>
+    {
+        for ( std::size_t index{}; index < m_natives.size(); index++ )
+        {
+            if ( m_natives[index].m_name == name )
+            {
+                return index;
+            }
+        }
+
+        return {};
+    }
+
+    [[nodiscard]] constexpr auto native(std::size_t index) const -> const acme::native_signature&
+    {
+        return m_natives[index];
+    }
+
+    // Host objects a member expression can read, the index is the host object slot of the virtual machine.
+    // The fields must outlive the emitter.
+
+    constexpr auto host_objects(std::span<const acme::host_binding> bindings)
+    {
+        if ( std::is_constant_evaluated() == false )
+        {
+            assert(bindings.size() <= acme::k_max_host_objects);
+        }
+
+        m_host_objects.clear();
+
+        for ( const auto& binding : bindings )
+        {
+            m_host_objects.push_back(binding);
+        }
+    }
+
+    // Slot of the host object and the field named by a member expression.
+
+    [[nodiscard]] constexpr auto host_field(
+        acme::identifier object,
+        acme::identifier property
+    ) const -> std::optional<std::pair<std::size_t, acme::host_field>>
+    {
+        for ( std::size_t slot{}; slot < m_host_objects.size(); slot++ )
+        {
+            if ( m_host_objects[slot].m_name != object )
+            {
+                continue;
+            }
+
+            for ( const auto& field : m_host_objects[slot].m_fields )
+            {
+                if ( field.m_name == property )
+                {
+                    return std::pair{slot, field};
+                }
+            }
+
+            return {};
+        }
+
+        return {};
+    }
+
+    [[nodiscard]] constexpr auto max_stack_depth() const
+    {
+        return m_max_stack_depth;
+    }
+
+    [[nodiscard]] constexpr auto instructions() const -> std::span<const acme::instruction>
+    {
+        return std::span{m_bytecode};
+    }
+
+    [[nodiscard]] constexpr auto number_constants() const -> std::span<const acme::number_constant>
+    {
+        return std::span{m_numbers};
+    }
+
+    constexpr auto add_number_constant(acme::number_constant constant) -> std::size_t
+    {
+        m_numbers.push_back(constant);
+        return m_numbers.size() - 1;
+    }
+
+    // Replace the emitted instructions with their optimized version.
+
+    constexpr auto assign_instructions(
+        bytecode_list_type instructions,
+        std::size_t        max_stack_depth
+    )
+    {
+        m_bytecode        = std::move(instructions);
+        m_max_stack_depth = max_stack_depth;
+    }
+
     [[nodiscard]] constexpr auto bytecode() const -> acme::bytecode
     {
         return acme::bytecode
@@ -215,17 +431,36 @@ struct emit_context
             std::span{m_numbers},
             std::span{m_strings},
             std::span{m_string_buffer.data(), m_string_buffer.length()},
+            m_max_stack_depth,
+            m_symbols.symbols(),
         };
     }
 
     private:
 
+    [[nodiscard]] static constexpr auto global_immediate(symbol_table::symbol_type s) -> acme::instruction::immediate_type
+    {
+        // Symbols beyond the range of the immediate are looked up by identifier.
+
+        constexpr auto k_max_immediate = (1u << 24u) - 1u;
+
+        return s < k_max_immediate ? s + 1u : 0u;
+    }
+
     bytecode_list_type         m_bytecode{};
     number_constants_list_type m_numbers{};
     string_constants_list_type m_strings{};
     std::string                m_string_buffer{};
+    symbol_table               m_symbols{};
+    frames_list_type           m_frames{};
+    frame_symbols_list_type    m_frame_symbols{};
+    parameters_list_type       m_parameters{};
+    natives_list_type          m_natives{};
+    host_objects_list_type     m_host_objects{};
     emit_state                 m_state{};
     loop_context*              m_loop_context{};
+    std::size_t                m_stack_depth{};
+    std::size_t                m_max_stack_depth{};
 };
 
 } // namespace acme::eval
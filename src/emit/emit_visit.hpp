@@ -1,8 +1,8 @@
-
+#pragma once
 
 namespace acme::eval {
 
-auto visit(
+constexpr auto visit(
     concepts::emit_visitor auto callback,
     const ast::UniqueAstNode&   p,
     emit_context&               context
@@ -1,35 +1,66 @@
 #pragma once
 
-#include <iostream>
-
 namespace acme::eval {
 
-auto emit(const ast::UniqueAstNode& p, emit_context& context) -> acme::script_value;
+constexpr auto emit(const ast::UniqueAstNode& p, emit_context& context) -> acme::script_value;
+
+// True if the statements declare let or const bindings directly in the block.
+
+constexpr auto declares_lexical(const ast::UniqueAstNode& p) -> bool
+{
+    if ( ast::instanceof<ast::VariableDeclaration>(p) )
+    {
+        const auto kind = p.get()->deref<ast::VariableDeclaration>().kind().value();
+
+        return kind == token_type::tok_let || kind == token_type::tok_const;
+    }
+
+    if ( ast::instanceof<ast::AstNodeList>(p) )
+    {
+        const auto& list = p.get()->deref<ast::AstNodeList>().nodes();
+
+        return std::any_of(list.begin(), list.end(), [](const auto& node) { return declares_lexical(node); });
+    }
+
+    return false;
+}
 
 static constexpr struct
 {
-    auto operator()(const ast::Identifier& v, emit_context& context) -> acme::script_value
+    constexpr auto operator()(const ast::Identifier& v, emit_context& context) -> acme::script_value
     {
+        // Parameters of a prepared expression are read from their slot. Parameters are read-only,
+        // an assignment targets a variable of the same name.
+
+        if ( context.state() != emit_context::emit_state::k_variable_declaration )
+        {
+            if ( const auto slot = context.parameter_slot(acme::identifier::from_hash(v.value().hash())); slot.has_value() )
+            {
+                context.emit_instruction(opcode::load_param, static_cast<acme::instruction::immediate_type>(slot.value()));
+                return {};
+            }
+        }
+
         context.emit(v);
         if ( context.state() != emit_context::emit_state::k_variable_declaration )
         {
-            context.emit_instruction(opcode::load_var);
+            context.emit_instruction(opcode::load_var, context.variable_immediate(v));
         }
 
         return {};
     }
 
-    auto operator()(const ast::DeclarationKind& v, emit_context& context) -> acme::script_value
+    constexpr auto operator()(const ast::DeclarationKind& v, emit_context& context) -> acme::script_value
     {
         return {};
     }
 
-    auto operator()(const ast::ArrayLiteral& lit, emit_context& context) -> acme::script_value
+    constexpr auto operator()(const ast::ArrayLiteral& lit, emit_context& context) -> acme::script_value
     {
         return {};
     }
 
-    auto operator()(const ast::Literal& lit, emit_context& context) -> acme::script_value
+    constexpr auto operator()(const ast::Literal& lit, emit_context& context) -> acme::script_value
     {
         using namespace acme::ast;
 
@@ -69,12 +100,12 @@ static constexpr struct
     }
 
     template <typename T> requires(std::is_same<T, ast::FunctionDeclaration>::value or std::is_same<T, ast::FunctionExpression>::value)
-    auto operator()(const T& v, emit_context& context) -> acme::script_value
+    constexpr auto operator()(const T& v, emit_context& context) -> acme::script_value
     {
         return {};
     }
 
-    auto operator()(const ast::VariableDeclaration& v, emit_context& context) -> acme::script_value
+    constexpr auto operator()(const ast::VariableDeclaration& v, emit_context& context) -> acme::script_value
     {
         if ( auto& id = v.identifier(); id.get() != nullptr  )
         {
@@ -93,16 +124,25 @@ static constexpr struct
             context.emit_instruction(opcode::push_undefined);
         }
 
-        context.emit_instruction(opcode::initialize);
+        // The name is declared after its initializer, which still reads an outer variable of the name.
+
+        auto imm = acme::instruction::immediate_type{};
+
+        if ( ast::instanceof<ast::Identifier>(v.identifier()) )
+        {
+            imm = context.declare(v.identifier().get()->deref<ast::Identifier>());
+        }
+
+        context.emit_instruction(opcode::initialize, imm);
 
         return {};
     }
 
-    auto operator()(const ast::BinaryExpression& v, emit_context& context) -> acme::script_value
+    constexpr auto operator()(const ast::BinaryExpression& v, emit_context& context) -> acme::script_value
     {
         const auto is_assignment_op = [&]()
         {
-            static constexpr auto k_lut = std::to_array
+            constexpr auto k_lut = std::to_array
             ({
                 token_type::tok_assignment,
                 token_type::tok_assignment_plus,
@@ -116,16 +156,14 @@ static constexpr struct
             return std::find(k_lut.cbegin(), k_lut.end(), v.operand()) != k_lut.cend();
         }();
 
-        if ( is_assignment_op == false )
-        {
-            eval::emit(v.right(), context);
-            eval::emit(v.left(), context);
-        }
+        // The left operand is on top of the stack. A plain assignment does not load the
+        // target, its only value on the stack is the one consumed by store_var.
 
-        else
+        eval::emit(v.right(), context);
+
+        if ( v.operand() != token_type::tok_assignment )
         {
             eval::emit(v.left(), context);
-            eval::emit(v.right(), context);
         }
 
         switch ( v.operand() )
@@ -235,13 +273,20 @@ static constexpr struct
             eval::emit(v.left(), context);
             context.state(emit_context::emit_state::k_none);
 
-            context.emit_instruction(opcode::store_var);
+            auto imm = acme::instruction::immediate_type{};
+
+            if ( ast::instanceof<ast::Identifier>(v.left()) )
+            {
+                imm = context.variable_immediate(v.left().get()->deref<ast::Identifier>());
+            }
+
+            context.emit_instruction(opcode::store_var, imm);
         }
 
         return {};
     }
 
-    auto operator()(const ast::UnaryExpression& v, emit_context& context) -> acme::script_value
+    constexpr auto operator()(const ast::UnaryExpression& v, emit_context& context) -> acme::script_value
     {
         eval::emit(v.expression(), context);
 
@@ -266,26 +311,67 @@ static constexpr struct
         return {};
     }
 
-    auto operator()(const ast::BlockStatement& v, emit_context& context) -> acme::script_value
+    constexpr auto operator()(const ast::BlockStatement& v, emit_context& context) -> acme::script_value
     {
-        if ( const auto& body = v.body(); body.get() != nullptr )
+        const auto& body = v.body();
+
+        if ( body.get() == nullptr )
         {
-            context.emit_instruction(opcode::push_stack_frame);
+            return {};
+        }
 
-            eval::emit(body, context);
+        // Only let and const are scoped to the block. Other blocks run in the enclosing frame.
 
-            context.emit_instruction(opcode::pop_stack_frame, 1);
+        if ( declares_lexical(body) == false )
+        {
+            eval::emit(body, context);
+            return {};
         }
 
+        context.emit_instruction(opcode::push_stack_frame);
+        context.enter_frame();
+
+        eval::emit(body, context);
+
+        context.leave_frame();
+        context.emit_instruction(opcode::pop_stack_frame, 1);
+
         return {};
     }
 
-    auto operator()(const ast::MemberExpression& v, emit_context& context) -> acme::script_value
+    constexpr auto operator()(const ast::MemberExpression& v, emit_context& context) -> acme::script_value
     {
+        // Host objects are read-only.
+
+        if ( context.state() == emit_context::emit_state::k_variable_declaration )
+        {
+            return {};
+        }
+
+        // A field of a host object is resolved to its slot and offset here, the virtual machine
+        // loads it from native memory. Other member expressions evaluate to undefined.
+
+        const auto& object   = v.object();
+        const auto& property = v.property();
+
+        if ( ast::instanceof<ast::Identifier>(object) && ast::instanceof<ast::Identifier>(property) )
+        {
+            const auto object_name   = acme::identifier::from_hash(object.get()->deref<ast::Identifier>().value().hash());
+            const auto property_name = acme::identifier::from_hash(property.get()->deref<ast::Identifier>().value().hash());
+
+            if ( const auto field = context.host_field(object_name, property_name); field.has_value() )
+            {
+                context.emit_instruction(opcode::load_host_field, host_field_immediate(field->first, field->second));
+                return {};
+            }
+        }
+
+        context.emit_instruction(opcode::push_undefined);
+
         return {};
     }
 
-    auto operator()(const ast::AstNodeList& v, emit_context& context) -> acme::script_value
+    constexpr auto operator()(const ast::AstNodeList& v, emit_context& context) -> acme::script_value
     {
         if ( const auto& list = v.nodes(); list.empty() == false )
         {
@@ -298,32 +384,32 @@ static constexpr struct
         return {};
     }
 
-    auto operator()(const ast::ObjectLiteral& v, emit_context& context) -> acme::script_value
+    constexpr auto operator()(const ast::ObjectLiteral& v, emit_context& context) -> acme::script_value
     {
         return {};
     }
 
-    auto operator()(const ast::ObjectPropertySetter& v, emit_context& context) -> acme::script_value
+    constexpr auto operator()(const ast::ObjectPropertySetter& v, emit_context& context) -> acme::script_value
     {
         return {};
     }
 
-    auto operator()(const ast::ObjectPropertyGetter& v, emit_context& context) -> acme::script_value
+    constexpr auto operator()(const ast::ObjectPropertyGetter& v, emit_context& context) -> acme::script_value
     {
         return {};
     }
 
-    auto operator()(const ast::ObjectProperty& v, emit_context& context) -> acme::script_value
+    constexpr auto operator()(const ast::ObjectProperty& v, emit_context& context) -> acme::script_value
     {
         return {};
     }
 
-    auto operator()(const ast::ThisExpression& v, emit_context& context) -> acme::script_value
+    constexpr auto operator()(const ast::ThisExpression& v, emit_context& context) -> acme::script_value
     {
         return {};
     }
 
-    auto operator()(const ast::IfStatement& v, emit_context& context) -> acme::script_value
+    constexpr auto operator()(const ast::IfStatement& v, emit_context& context) -> acme::script_value
     {
         // Get condition expression.
 
@@ -369,7 +455,7 @@ static constexpr struct
         return {};
     }
 
-    auto operator()(const ast::TernaryExpression& v, emit_context& context) -> acme::script_value
+    constexpr auto operator()(const ast::TernaryExpression& v, emit_context& context) -> acme::script_value
     {
         // Get condition expression.
 
@@ -417,7 +503,7 @@ static constexpr struct
         return {};
     }
 
-    auto operator()(const ast::LoopStatement& v, emit_context& context) -> acme::script_value
+    constexpr auto operator()(const ast::LoopStatement& v, emit_context& context) -> acme::script_value
     {
         loop_context loop{};
 
@@ -491,7 +577,7 @@ static constexpr struct
         return {};
     }
 
-    auto operator()(const ast::SimpleStatement& v, emit_context& context) -> acme::script_value
+    constexpr auto operator()(const ast::SimpleStatement& v, emit_context& context) -> acme::script_value
     {
         switch ( v.kind() )
         {
@@ -553,21 +639,72 @@ static constexpr struct
         return {};
     }
 
-    auto operator()(const ast::CallExpression& v, emit_context& context) -> acme::script_value
+    constexpr auto operator()(const ast::CallExpression& v, emit_context& context) -> acme::script_value
     {
+        const auto index = [&]() -> std::optional<std::size_t>
+        {
+            if ( ast::instanceof<ast::Identifier>(v.callee()) )
+            {
+                return context.native_index(acme::identifier::from_hash(v.callee().get()->deref<ast::Identifier>().value().hash()));
+            }
+
+            return {};
+        }();
+
+        // Only native functions can be called, other calls evaluate to undefined.
+
+        if ( index.has_value() == false )
+        {
+            context.emit_instruction(opcode::push_undefined);
+            return {};
+        }
+
+        // Arguments are pushed left to right. Missing arguments are undefined and extra
+        // arguments are not evaluated.
+
+        const auto arity = context.native(index.value()).m_arity;
+        auto       count = std::size_t{};
+
+        if ( auto& arguments = v.arguments(); arguments.get() != nullptr && ast::instanceof<ast::AstNodeList>(arguments) )
+        {
+            for ( const auto& argument : arguments.get()->deref<ast::AstNodeList>().nodes() )
+            {
+                if ( count < arity )
+                {
+                    eval::emit(argument, context);
+                    count++;
+                }
+            }
+        }
+
+        for ( ; count < arity; count++ )
+        {
+            context.emit_instruction(opcode::push_undefined);
+        }
+
+        context.emit_instruction(opcode::call_native, native_call_immediate(index.value(), arity));
+
         return {};
     }
 
-    auto operator()(const ast::NewExpression& v, emit_context& context) -> acme::script_value
+    constexpr auto operator()(const ast::NewExpression& v, emit_context& context) -> acme::script_value
     {
         return {};
     }
 
-    auto operator()(const ast::MetaProperty& v, emit_context& context) -> acme::script_value
+    constexpr auto operator()(const ast::MetaProperty& v, emit_context& context) -> acme::script_value
     {
         return {};
     }
 
 } emit_visitor{};
 
+constexpr auto emit(
+    const ast::UniqueAstNode& p,
+    emit_context&            context
+) -> acme::script_value
+{
+    return eval::visit(eval::emit_visitor, p, context);
+}
+
 } // namespace acme::eval
@@ -0,0 +1,180 @@
+#pragma once
+
+namespace acme {
+
+/* Symbols of the program being emitted. Each distinct name gets a dense symbol id, the index
+   of its entry in symbols(), so the emitter can keep per-name state in arrays.
+
+   Names are found by hash in an open addressed table and compared in full, so names with
+   the same hash are different symbols. The identifier of a name whose hash is taken by an
+   other name is rehashed until it is unique in the program, so their variables do not alias.
+   The names are appended to the string buffer of the emitter.
+*/
+
+struct symbol_table
+{
+    using hash_type         = acme::identifier::value_type;
+    using symbol_type       = std::uint32_t;
+    using symbols_list_type = acme::dynamic_cvector<acme::symbol>;
+
+    static constexpr symbol_type k_no_symbol      = std::numeric_limits<symbol_type>::max();
+    static constexpr std::size_t k_min_slot_count = 16u;
+
+    struct slot
+    {
+        hash_type   m_hash{};
+        symbol_type m_symbol{k_no_symbol};
+    };
+
+    using slots_list_type = acme::dynamic_cvector<slot>;
+
+    // Symbol id of the name, added to the table and the buffer if the program did not use it before.
+
+    [[nodiscard]] constexpr auto intern(
+        std::string_view name,
+        hash_type        hash,
+        std::string&     buffer
+    ) -> symbol_type
+    {
+        // Keep the load factor at most one half.
+
+        if ( (m_symbols.size() + 1u) * 2u > m_slots.size() )
+        {
+            grow();
+        }
+
+        const auto mask = m_slots.size() - 1u;
+
+        for ( auto i = static_cast<std::size_t>(hash) & mask; ; i = (i + 1u) & mask )
+        {
+            auto& s = m_slots[i];
+
+            if ( s.m_symbol == k_no_symbol )
+            {
+                s = slot{ .m_hash = hash, .m_symbol = static_cast<symbol_type>(m_symbols.size()) };
+                break;
+            }
+
+            if ( s.m_hash == hash && name_of(s.m_symbol, buffer) == name )
+            {
+                return s.m_symbol;
+            }
+        }
+
+        m_symbols.push_back(acme::symbol
+        {
+            .m_id            = unique_id(hash),
+            .m_buffer_offset = static_cast<std::uint32_t>(buffer.length()),
+            .m_length        = static_cast<std::uint32_t>(name.length())
+        });
+
+        buffer.append(name);
+
+        return static_cast<symbol_type>(m_symbols.size() - 1u);
+    }
+
+    [[nodiscard]] constexpr auto id(symbol_type symbol) const -> acme::identifier
+    {
+        return m_symbols[symbol].m_id;
+    }
+
+    [[nodiscard]] constexpr auto symbols() const -> std::span<const acme::symbol>
+    {
+        return std::span{m_symbols};
+    }
+
+    [[nodiscard]] constexpr auto size() const noexcept -> std::size_t
+    {
+        return m_symbols.size();
+    }
+
+    private:
+
+    [[nodiscard]] constexpr auto name_of(
+        symbol_type        symbol,
+        const std::string& buffer
+    ) const -> std::string_view
+    {
+        const auto& [id, buffer_offset, length] = m_symbols[symbol];
+
+        return std::string_view{buffer}.substr(buffer_offset, length);
+    }
+
+    // The hash of the name, or the hash rehashed past the identifiers of the other names.
+
+    [[nodiscard]] constexpr auto unique_id(hash_type hash) -> acme::identifier
+    {
+        // While no name was rehashed, an identifier is taken only by a name with the same hash.
+
+        if ( m_rehashed == false && hash != acme::identifier::none && find_hash(hash) == false )
+        {
+            return acme::identifier::from_hash(hash);
+        }
+
+        const auto is_taken = [&](hash_type h)
+        {
+            return std::any_of(m_symbols.begin(), m_symbols.end(), [&](const auto& s) { return s.m_id.value() == h; });
+        };
+
+        auto id = hash;
+
+        while ( id == acme::identifier::none || is_taken(id) )
+        {
+            id = acme::detail::hash_fnv1a_step(id, '\0');
+        }
+
+        m_rehashed = m_rehashed || id != hash;
+
+        return acme::identifier::from_hash(id);
+    }
+
+    // Whether a name interned before has the hash. The slot of the new name is already taken.
+
+    [[nodiscard]] constexpr auto find_hash(hash_type hash) const -> bool
+    {
+        const auto mask = m_slots.size() - 1u;
+        const auto self = static_cast<symbol_type>(m_symbols.size());
+
+        for ( auto i = static_cast<std::size_t>(hash) & mask; m_slots[i].m_symbol != k_no_symbol; i = (i + 1u) & mask )
+        {
+            if ( m_slots[i].m_hash == hash && m_slots[i].m_symbol != self )
+            {
+                return true;
+            }
+        }
+
+        return false;
+    }
+
+    constexpr auto grow() -> void
+    {
+        auto slots = slots_list_type(std::max(k_min_slot_count, m_slots.size() * 2u));
+
+        const auto mask = slots.size() - 1u;
+
+        for ( const auto& s : m_slots )
+        {
+            if ( s.m_symbol == k_no_symbol )
+            {
+                continue;
+            }
+
+            auto i = static_cast<std::size_t>(s.m_hash) & mask;
+
+            while ( slots[i].m_symbol != k_no_symbol )
+            {
+                i = (i + 1u) & mask;
+            }
+
+            slots[i] = s;
+        }
+
+        m_slots = std::move(slots);
+    }
+
+    symbols_list_type m_symbols{};
+    slots_list_type   m_slots{};
+    bool              m_rehashed{};
+};
+
+} // namespace acme
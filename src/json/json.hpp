@@ -0,0 +1,6 @@
+#pragma once
+
+#include "json_scan.hpp"
+#include "json_escape.hpp"
+#include "json_parse.hpp"
+#include "json_stringify.hpp"
@@ -0,0 +1,102 @@
+#pragma once
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif /* __SSE2__ */
+
+namespace acme::json {
+
+// String escaping shared by the parser, the stringifier and the AST writer of render.
+
+namespace detail {
+
+// Offset of the first quote, backslash or control character at or after the offset.
+
+[[nodiscard]] inline auto find_string_special(
+    std::string_view text,
+    std::size_t      offset
+) noexcept -> std::size_t
+{
+#if defined(__SSE2__)
+
+    for ( ; offset + 16u <= text.size(); offset += 16u )
+    {
+        const auto bytes = _mm_loadu_si128(reinterpret_cast<const __m128i*>(text.data() + offset));
+
+        // Signed compare: bytes 0x80..0xFF of UTF-8 sequences are negative, so compare against
+        // the unsigned range with the sign bit flipped.
+
+        const auto biased  = _mm_xor_si128(bytes, _mm_set1_epi8(static_cast<char>(0x80)));
+        const auto control = _mm_cmplt_epi8(biased, _mm_set1_epi8(static_cast<char>(0x20 ^ 0x80)));
+        const auto special = _mm_or_si128(_mm_or_si128(_mm_cmpeq_epi8(bytes, _mm_set1_epi8('"')), _mm_cmpeq_epi8(bytes, _mm_set1_epi8('\\'))), control);
+
+        if ( const auto mask = static_cast<std::uint32_t>(_mm_movemask_epi8(special)); mask != 0u )
+        {
+            return offset + static_cast<std::size_t>(std::countr_zero(mask));
+        }
+    }
+
+#endif /* __SSE2__ */
+
+    for ( ; offset < text.size(); offset++ )
+    {
+        if ( const auto c = static_cast<unsigned char>(text[offset]); c == '"' || c == '\\' || c < 0x20u )
+        {
+            return offset;
+        }
+    }
+
+    return text.size();
+}
+
+inline constexpr char k_hex_digits[] = "0123456789abcdef";
+
+// Append a string literal. Runs of bytes that need no escape are found 16 bytes at a time
+// and appended at once.
+
+inline auto append_quoted(
+    std::string&     out,
+    std::string_view text
+)
+{
+    out += '"';
+
+    auto offset = std::size_t{};
+
+    while ( offset < text.size() )
+    {
+        const auto special = find_string_special(text, offset);
+
+        out.append(text.substr(offset, special - offset));
+
+        if ( special == text.size() )
+        {
+            break;
+        }
+
+        switch ( const auto c = text[special]; c )
+        {
+            case '"':  out += "\\\""; break;
+            case '\\': out += "\\\\"; break;
+            case '\b': out += "\\b";  break;
+            case '\f': out += "\\f";  break;
+            case '\n': out += "\\n";  break;
+            case '\r': out += "\\r";  break;
+            case '\t': out += "\\t";  break;
+
+            default:
+                out += "\\u00";
+                out += k_hex_digits[static_cast<unsigned char>(c) >> 4u];
+                out += k_hex_digits[static_cast<unsigned char>(c) & 0xFu];
+                break;
+        }
+
+        offset = special + 1u;
+    }
+
+    out += '"';
+}
+
+} // namespace detail
+
+} // namespace acme::json
@@ -0,0 +1,584 @@
+#pragma once
+
+namespace acme::json {
+
+enum class parse_error : std::uint8_t
+{
+    none = 0u,
+    empty_document,
+    unexpected_character,
+    unexpected_end,
+    unclosed_string,
+    invalid_string,
+    invalid_number,
+    invalid_literal,
+    trailing_content,
+    too_deep,
+};
+
+struct parse_result
+{
+    [[nodiscard]] constexpr explicit operator bool() const noexcept
+    {
+        return m_error == parse_error::none;
+    }
+
+    acme::script_value m_value{};
+    parse_error        m_error{};
+    std::size_t        m_offset{};   // Offset of the offending byte of the text.
+};
+
+namespace detail {
+
+[[nodiscard]] constexpr auto hex_digit(char c) noexcept -> std::int32_t
+{
+    if ( c >= '0' && c <= '9' ) { return c - '0'; }
+    if ( c >= 'a' && c <= 'f' ) { return c - 'a' + 10; }
+    if ( c >= 'A' && c <= 'F' ) { return c - 'A' + 10; }
+
+    return -1;
+}
+
+[[nodiscard]] constexpr auto read_hex4(std::string_view text) noexcept -> std::int32_t
+{
+    if ( text.size() < 4u )
+    {
+        return -1;
+    }
+
+    auto value = std::int32_t{};
+
+    for ( std::size_t i{}; i < 4u; i++ )
+    {
+        const auto digit = hex_digit(text[i]);
+
+        if ( digit < 0 )
+        {
+            return -1;
+        }
+
+        value = value << 4 | digit;
+    }
+
+    return value;
+}
+
+constexpr auto append_utf8(
+    std::string&  out,
+    std::uint32_t code_point
+)
+{
+    if ( code_point < 0x80u )
+    {
+        out += static_cast<char>(code_point);
+    }
+
+    else if ( code_point < 0x800u )
+    {
+        out += static_cast<char>(0xC0u | (code_point >> 6u));
+        out += static_cast<char>(0x80u | (code_point & 0x3Fu));
+    }
+
+    else if ( code_point < 0x10000u )
+    {
+        out += static_cast<char>(0xE0u | (code_point >> 12u));
+        out += static_cast<char>(0x80u | ((code_point >> 6u) & 0x3Fu));
+        out += static_cast<char>(0x80u | (code_point & 0x3Fu));
+    }
+
+    else
+    {
+        out += static_cast<char>(0xF0u | (code_point >> 18u));
+        out += static_cast<char>(0x80u | ((code_point >> 12u) & 0x3Fu));
+        out += static_cast<char>(0x80u | ((code_point >> 6u) & 0x3Fu));
+        out += static_cast<char>(0x80u | (code_point & 0x3Fu));
+    }
+}
+
+// Length of a number that follows the JSON grammar, zero if the text does not start with one.
+
+[[nodiscard]] constexpr auto number_length(std::string_view text) noexcept -> std::size_t
+{
+    auto i = std::size_t{};
+
+    const auto digits = [&]()
+    {
+        const auto begin = i;
+
+        while ( i < text.size() && text[i] >= '0' && text[i] <= '9' )
+        {
+            i++;
+        }
+
+        return i - begin;
+    };
+
+    if ( i < text.size() && text[i] == '-' )
+    {
+        i++;
+    }
+
+    if ( i < text.size() && text[i] == '0' )
+    {
+        i++;
+    }
+
+    else if ( digits() == 0u )
+    {
+        return 0u;
+    }
+
+    if ( i < text.size() && text[i] == '.' )
+    {
+        i++;
+
+        if ( digits() == 0u )
+        {
+            return 0u;
+        }
+    }
+
+    if ( i < text.size() && (text[i] == 'e' || text[i] == 'E') )
+    {
+        i++;
+
+        if ( i < text.size() && (text[i] == '+' || text[i] == '-') )
+        {
+            i++;
+        }
+
+        if ( digits() == 0u )
+        {
+            return 0u;
+        }
+    }
+
+    return i;
+}
+
+} // namespace detail
+
+/* JSON parser producing script values. Objects and arrays are created in the object heap of the
+   virtual machine and strings are interned in its string pool, there is no intermediate document.
+
+       acme::json::parser json{};
+
+       if ( const auto result = json.parse(vm, text); result )
+       {
+           use(result.m_value);
+       }
+
+   The structural index of the first stage, and the buffers of the second stage, are kept for the
+   next parse. The text is expected to be valid UTF-8, it is not validated.
+*/
+
+struct parser
+{
+    // Deepest nesting of objects and arrays.
+
+    static constexpr std::size_t k_max_depth = 1024u;
+
+    [[nodiscard]] auto parse(
+        acme::virtual_machine& vm,
+        std::string_view       text
+    ) -> parse_result
+    {
+        if ( text.size() >= std::numeric_limits<std::uint32_t>::max() )
+        {
+            return error(parse_error::unexpected_end, 0u);
+        }
+
+        // Stage one: index of the structural bytes, terminated by the end of the text.
+
+        if ( m_index.size() < text.size() + 1u )
+        {
+            m_index.resize(text.size() + 1u);
+        }
+
+        const auto scanned = json::scan(text, m_index.data());
+
+        if ( scanned.m_unclosed_string )
+        {
+            return error(parse_error::unclosed_string, text.size());
+        }
+
+        if ( scanned.m_count == 0u )
+        {
+            return error(parse_error::empty_document, 0u);
+        }
+
+        m_index[scanned.m_count] = static_cast<std::uint32_t>(text.size());
+
+        m_text  = text;
+        m_count = scanned.m_count;
+        m_next  = 0u;
+
+        // Stage two: walk the index with an explicit stack of the open objects and arrays.
+
+        m_frames.clear();
+
+        auto root = acme::script_value{};
+
+        const auto add = [&](acme::script_value value)
+        {
+            if ( m_frames.empty() )
+            {
+                root = std::move(value);
+            }
+
+            else if ( auto& frame = m_frames.back(); frame.m_container->is_array() )
+            {
+                frame.m_container->push_back(std::move(value));
+            }
+
+            else
+            {
+                frame.m_container->insert(std::move(frame.m_key), std::move(value));
+            }
+        };
+
+        enum class expect : std::uint8_t
+        {
+            k_value = 0u,
+            k_key,
+            k_separator,
+        };
+
+        auto state = expect::k_value;
+
+        while ( true )
+        {
+            if ( state == expect::k_key )
+            {
+                const auto offset = next();
+
+                if ( offset >= m_text.size() )
+                {
+                    return error(parse_error::unexpected_end, offset);
+                }
+
+                if ( m_text[offset] != '"' )
+                {
+                    return error(parse_error::unexpected_character, offset);
+                }
+
+                if ( auto key = string(vm, offset); key.has_value() )
+                {
+                    m_frames.back().m_key = std::move(key.value());
+                }
+
+                else
+                {
+                    return error(parse_error::invalid_string, offset);
+                }
+
+                if ( const auto colon = next(); colon >= m_text.size() || m_text[colon] != ':' )
+                {
+                    return error(colon >= m_text.size() ? parse_error::unexpected_end : parse_error::unexpected_character, colon);
+                }
+
+                state = expect::k_value;
+            }
+
+            else if ( state == expect::k_value )
+            {
+                const auto offset = next();
+
+                if ( offset >= m_text.size() )
+                {
+                    return error(parse_error::unexpected_end, offset);
+                }
+
+                switch ( m_text[offset] )
+                {
+                    case '{':
+                    case '[':
+                    {
+                        const auto is_array = m_text[offset] == '[';
+                        const auto object   = is_array ? vm.heap().make_array() : vm.heap().make_object();
+
+                        if ( m_frames.size() == k_max_depth )
+                        {
+                            return error(parse_error::too_deep, offset);
+                        }
+
+                        add(acme::script_value{object});
+
+                        if ( peek() == (is_array ? ']' : '}') )
+                        {
+                            m_next++;
+                            state = expect::k_separator;
+                            break;
+                        }
+
+                        m_frames.push_back(frame{ .m_container = object.data() });
+
+                        state = is_array ? expect::k_value : expect::k_key;
+                        break;
+                    }
+
+                    case '"':
+                    {
+                        auto value = string(vm, offset);
+
+                        if ( value.has_value() == false )
+                        {
+                            return error(parse_error::invalid_string, offset);
+                        }
+
+                        add(acme::script_value{std::move(value.value())});
+
+                        state = expect::k_separator;
+                        break;
+                    }
+
+                    case 't':
+                    case 'f':
+                    case 'n':
+                    {
+                        using namespace std::string_view_literals;
+
+                        const auto literal = m_text[offset] == 't' ? "true"sv : m_text[offset] == 'f' ? "false"sv : "null"sv;
+
+                        if ( m_text.substr(offset, literal.size()) != literal || scalar_ends(offset + literal.size()) == false )
+                        {
+                            return error(parse_error::invalid_literal, offset);
+                        }
+
+                        if ( literal == "null"sv )
+                        {
+                            add(acme::script_value{nullptr});
+                        }
+
+                        else
+                        {
+                            add(acme::script_value{acme::boolean{literal == "true"sv}});
+                        }
+
+                        state = expect::k_separator;
+                        break;
+                    }
+
+                    case '}':
+                    case ']':
+                    case ',':
+                    case ':':
+                        return error(parse_error::unexpected_character, offset);
+
+                    default:
+                    {
+                        const auto length = detail::number_length(m_text.substr(offset));
+
+                        if ( length == 0u || scalar_ends(offset + length) == false )
+                        {
+                            return error(parse_error::invalid_number, offset);
+                        }
+
+                        const auto number = numeric::parse_number(m_text.substr(offset, length));
+
+                        if ( number.has_value() == false )
+                        {
+                            return error(parse_error::invalid_number, offset);
+                        }
+
+                        add(acme::script_value{acme::number{number->m_value}});
+
+                        state = expect::k_separator;
+                        break;
+                    }
+                }
+            }
+
+            else
+            {
+                // A complete value: the document ends, or a separator or the closing bracket follows.
+
+                if ( m_frames.empty() )
+                {
+                    if ( const auto offset = next(); offset < m_text.size() )
+                    {
+                        return error(parse_error::trailing_content, offset);
+                    }
+
+                    return parse_result{ .m_value = std::move(root) };
+                }
+
+                const auto offset   = next();
+                const auto is_array = m_frames.back().m_container->is_array();
+
+                if ( offset >= m_text.size() )
+                {
+                    return error(parse_error::unexpected_end, offset);
+                }
+
+                if ( m_text[offset] == ',' )
+                {
+                    state = is_array ? expect::k_value : expect::k_key;
+                }
+
+                else if ( m_text[offset] == (is_array ? ']' : '}') )
+                {
+                    m_frames.pop_back();
+                }
+
+                else
+                {
+                    return error(parse_error::unexpected_character, offset);
+                }
+            }
+        }
+    }
+
+    private:
+
+    struct frame
+    {
+        acme::object_data* m_container{};
+        acme::string       m_key{};
+    };
+
+    [[nodiscard]] static constexpr auto error(
+        parse_error error,
+        std::size_t offset
+    ) -> parse_result
+    {
+        return parse_result{ .m_error = error, .m_offset = offset };
+    }
+
+    // Offset of the next structural byte, the size of the text past the last one.
+
+    [[nodiscard]] constexpr auto next() noexcept -> std::size_t
+    {
+        return m_next <= m_count ? m_index[m_next++] : m_text.size();
+    }
+
+    [[nodiscard]] constexpr auto peek() const noexcept -> char
+    {
+        const auto offset = m_next <= m_count ? m_index[m_next] : m_text.size();
+
+        return offset < m_text.size() ? m_text[offset] : '\0';
+    }
+
+    // A number or literal is followed by whitespace, an operator or the end of the text.
+
+    [[nodiscard]] constexpr auto scalar_ends(std::size_t offset) const noexcept -> bool
+    {
+        return offset == m_text.size() || detail::is_json_operator(m_text[offset]) || detail::is_json_whitespace(m_text[offset]);
+    }
+
+    // String starting at the quote at the offset. Strings without escapes are interned from the
+    // text, others are unescaped into the scratch buffer first.
+
+    [[nodiscard]] auto string(
+        acme::virtual_machine& vm,
+        std::size_t            quote
+    ) -> std::optional<acme::string>
+    {
+        const auto begin = quote + 1u;
+
+        auto offset = detail::find_string_special(m_text, begin);
+
+        if ( offset < m_text.size() && m_text[offset] == '"' )
+        {
+            return intern(vm, m_text.substr(begin, offset - begin));
+        }
+
+        m_scratch.assign(m_text.substr(begin, offset - begin));
+
+        while ( offset < m_text.size() )
+        {
+            const auto c = m_text[offset];
+
+            if ( c == '"' )
+            {
+                return intern(vm, m_scratch);
+            }
+
+            if ( c != '\\' || offset + 1u >= m_text.size() )
+            {
+                return {};
+            }
+
+            switch ( m_text[offset + 1u] )
+            {
+                case '"':  m_scratch += '"';  break;
+                case '\\': m_scratch += '\\'; break;
+                case '/':  m_scratch += '/';  break;
+                case 'b':  m_scratch += '\b'; break;
+                case 'f':  m_scratch += '\f'; break;
+                case 'n':  m_scratch += '\n'; break;
+                case 'r':  m_scratch += '\r'; break;
+                case 't':  m_scratch += '\t'; break;
+
+                case 'u':
+                {
+                    auto code_point = detail::read_hex4(m_text.substr(offset + 2u));
+
+                    if ( code_point < 0 )
+                    {
+                        return {};
+                    }
+
+                    offset += 4u;
+
+                    // A high surrogate is followed by an escaped low surrogate.
+
+                    if ( code_point >= 0xD800 && code_point <= 0xDBFF )
+                    {
+                        const auto low = m_text.substr(offset + 2u, 2u) == "\\u" ? detail::read_hex4(m_text.substr(offset + 4u)) : -1;
+
+                        if ( low < 0xDC00 || low > 0xDFFF )
+                        {
+                            return {};
+                        }
+
+                        code_point = 0x10000 + ((code_point - 0xD800) << 10) + (low - 0xDC00);
+                        offset    += 6u;
+                    }
+
+                    else if ( code_point >= 0xDC00 && code_point <= 0xDFFF )
+                    {
+                        return {};
+                    }
+
+                    detail::append_utf8(m_scratch, static_cast<std::uint32_t>(code_point));
+                    break;
+                }
+
+                default:
+                    return {};
+            }
+
+            offset += 2u;
+
+            const auto run = detail::find_string_special(m_text, offset);
+
+            m_scratch.append(m_text.substr(offset, run - offset));
+            offset = run;
+        }
+
+        return {};
+    }
+
+    [[nodiscard]] static auto intern(
+        acme::virtual_machine& vm,
+        std::string_view       text
+    ) -> acme::string
+    {
+        if ( text.empty() )
+        {
+            return acme::string{std::string_view{}};
+        }
+
+        return acme::string{vm.string_pool().intern(text)};
+    }
+
+    acme::dynamic_cvector<std::uint32_t> m_index{};
+    acme::dynamic_cvector<frame>         m_frames{};
+    std::string                          m_scratch{};
+    std::string_view                     m_text{};
+    std::size_t                          m_count{};
+    std::size_t                          m_next{};
+};
+
+} // namespace acme::json
@@ -0,0 +1,230 @@
+#pragma once
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif /* __SSE2__ */
+
+#if defined(__PCLMUL__)
+#include <wmmintrin.h>
+#endif /* __PCLMUL__ */
+
+namespace acme::json {
+
+/* Structural scan of a JSON text, the first stage of the parser. The input is classified 64 bytes
+   at a time into bitmasks, one bit per byte, and the positions of structural characters are
+   written to an index without branching on the input:
+
+    - Quotes that are not escaped by an odd run of backslashes delimit strings. A prefix xor of
+      the quote mask gives the bytes inside strings.
+    - Structural are the operators {}[]:, outside of strings, and the first byte of every scalar:
+      the opening quote of a string, or the first byte of a number or literal.
+
+   The parser then walks the index instead of the text. See: Langdale, Lemire, "Parsing Gigabytes
+   of JSON per Second" (simdjson).
+*/
+
+namespace detail {
+
+inline constexpr std::size_t k_block_size = 64u;
+
+struct block_masks
+{
+    std::uint64_t m_backslash{};
+    std::uint64_t m_quote{};
+    std::uint64_t m_operator{};
+    std::uint64_t m_whitespace{};
+};
+
+[[nodiscard]] constexpr auto is_json_operator(char c) noexcept -> bool
+{
+    return c == '{' || c == '}' || c == '[' || c == ']' || c == ':' || c == ',';
+}
+
+[[nodiscard]] constexpr auto is_json_whitespace(char c) noexcept -> bool
+{
+    return c == ' ' || c == '\t' || c == '\n' || c == '\r';
+}
+
+[[nodiscard]] inline auto classify(const char* block) noexcept -> block_masks
+{
+    auto masks = block_masks{};
+
+#if defined(__SSE2__)
+
+    for ( std::size_t i{}; i < k_block_size / 16u; i++ )
+    {
+        const auto bytes = _mm_loadu_si128(reinterpret_cast<const __m128i*>(block + i * 16u));
+
+        const auto equal = [&](char c) { return _mm_cmpeq_epi8(bytes, _mm_set1_epi8(c)); };
+        const auto bits  = [&](__m128i v) { return static_cast<std::uint64_t>(static_cast<std::uint16_t>(_mm_movemask_epi8(v))) << (i * 16u); };
+
+        const auto operators  = _mm_or_si128(_mm_or_si128(_mm_or_si128(equal('{'), equal('}')), _mm_or_si128(equal('['), equal(']'))), _mm_or_si128(equal(':'), equal(',')));
+        const auto whitespace = _mm_or_si128(_mm_or_si128(equal(' '), equal('\t')), _mm_or_si128(equal('\n'), equal('\r')));
+
+        masks.m_backslash  |= bits(equal('\\'));
+        masks.m_quote      |= bits(equal('"'));
+        masks.m_operator   |= bits(operators);
+        masks.m_whitespace |= bits(whitespace);
+    }
+
+#else
+
+    for ( std::size_t i{}; i < k_block_size; i++ )
+    {
+        const auto bit = std::uint64_t{1} << i;
+        const auto c   = block[i];
+
+        masks.m_backslash  |= c == '\\'              ? bit : 0u;
+        masks.m_quote      |= c == '"'               ? bit : 0u;
+        masks.m_operator   |= is_json_operator(c)    ? bit : 0u;
+        masks.m_whitespace |= is_json_whitespace(c)  ? bit : 0u;
+    }
+
+#endif /* __SSE2__ */
+
+    return masks;
+}
+
+// Bit i of the result is the xor of bits 0..i, it is set for the bytes from an opening
+// quote up to, not including, the closing quote.
+
+[[nodiscard]] inline auto prefix_xor(std::uint64_t bits) noexcept -> std::uint64_t
+{
+#if defined(__PCLMUL__)
+
+    const auto product = _mm_clmulepi64_si128(_mm_set_epi64x(0, static_cast<std::int64_t>(bits)), _mm_set1_epi8(-1), 0);
+
+    return static_cast<std::uint64_t>(_mm_cvtsi128_si64(product));
+
+#else
+
+    bits ^= bits << 1u;
+    bits ^= bits << 2u;
+    bits ^= bits << 4u;
+    bits ^= bits << 8u;
+    bits ^= bits << 16u;
+    bits ^= bits << 32u;
+
+    return bits;
+
+#endif /* __PCLMUL__ */
+}
+
+} // namespace detail
+
+// Scanner state carried from one block to the next.
+
+struct scan_state
+{
+    std::uint64_t m_escaped{};     // The first byte of the next block is escaped.
+    std::uint64_t m_in_string{};   // All ones if the previous block ended inside a string.
+    std::uint64_t m_scalar{};      // The previous block ended with a byte of a number or literal.
+};
+
+// Bytes escaped by a backslash. Backslashes are rare, so the runs are resolved one at a time.
+
+[[nodiscard]] inline auto escaped_bytes(
+    std::uint64_t backslash,
+    scan_state&   state
+) noexcept -> std::uint64_t
+{
+    auto escaped = state.m_escaped;
+    auto escapes = backslash & ~escaped;
+
+    state.m_escaped = 0u;
+
+    while ( escapes != 0u )
+    {
+        const auto i = static_cast<std::uint64_t>(std::countr_zero(escapes));
+
+        if ( i == 63u )
+        {
+            state.m_escaped = 1u;
+            break;
+        }
+
+        escaped |= std::uint64_t{1} << (i + 1u);
+        escapes &= ~(std::uint64_t{3} << i);
+    }
+
+    return escaped;
+}
+
+// Mask of the structural bytes of one block.
+
+[[nodiscard]] inline auto structural_bytes(
+    const char* block,
+    scan_state& state
+) noexcept -> std::uint64_t
+{
+    const auto masks     = detail::classify(block);
+    const auto escaped   = escaped_bytes(masks.m_backslash, state);
+    const auto quotes    = masks.m_quote & ~escaped;
+    const auto in_string = detail::prefix_xor(quotes) ^ state.m_in_string;
+
+    state.m_in_string = static_cast<std::uint64_t>(static_cast<std::int64_t>(in_string) >> 63);
+
+    // A scalar starts at a byte that is neither an operator nor whitespace, and does not
+    // follow another byte of a number or literal.
+
+    const auto scalar          = ~(masks.m_operator | masks.m_whitespace);
+    const auto nonquote_scalar = scalar & ~quotes;
+    const auto follows_scalar  = nonquote_scalar << 1u | state.m_scalar;
+
+    state.m_scalar = nonquote_scalar >> 63u;
+
+    // The string contents and the closing quote are not structural, the opening quote is.
+
+    const auto string_tail = in_string ^ quotes;
+
+    return (masks.m_operator | (scalar & ~follows_scalar)) & ~string_tail;
+}
+
+struct scan_result
+{
+    std::size_t m_count{};             // Number of structural bytes.
+    bool        m_unclosed_string{};   // The text ends inside a string.
+};
+
+// Write the offsets of the structural bytes of the text to the index, which must have room
+// for one entry per byte of the text.
+
+[[nodiscard]] inline auto scan(
+    std::string_view text,
+    std::uint32_t*   index
+) noexcept -> scan_result
+{
+    auto state  = scan_state{};
+    auto count  = std::size_t{};
+    auto offset = std::size_t{};
+
+    const auto write = [&](std::uint64_t structurals, std::size_t base)
+    {
+        while ( structurals != 0u )
+        {
+            index[count++] = static_cast<std::uint32_t>(base + static_cast<std::size_t>(std::countr_zero(structurals)));
+            structurals   &= structurals - 1u;
+        }
+    };
+
+    for ( ; offset + detail::k_block_size <= text.size(); offset += detail::k_block_size )
+    {
+        write(structural_bytes(text.data() + offset, state), offset);
+    }
+
+    // The last block is padded with whitespace.
+
+    if ( offset < text.size() )
+    {
+        char block[detail::k_block_size];
+
+        std::memset(block, ' ', sizeof(block));
+        std::memcpy(block, text.data() + offset, text.size() - offset);
+
+        write(structural_bytes(block, state), offset);
+    }
+
+    return scan_result{ .m_count = count, .m_unclosed_string = state.m_in_string != 0u };
+}
+
+} // namespace acme::json
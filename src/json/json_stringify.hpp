@@ -0,0 +1,147 @@
+#pragma once
+
+namespace acme::json {
+
+namespace detail {
+
+// Values that have no JSON representation: properties with such a value are left out and array
+// elements are written as null.
+
+[[nodiscard]] constexpr auto is_serializable(const acme::script_value& v) noexcept -> bool
+{
+    return is_undefined(v) == false && is_function(v) == false && is_identifier(v) == false;
+}
+
+} // namespace detail
+
+/* Append the JSON text of the value to the buffer, as JSON.stringify does without indentation.
+   Numbers are formatted with the shortest representation that round-trips, NaN and infinities
+   are written as null, and a key repeated in a parsed text is written for each occurrence.
+   Returns false, and appends nothing, for values with no JSON representation and for objects
+   nested deeper than the parser accepts.
+
+       std::string buffer{};
+
+       buffer.clear();
+       acme::json::stringify(value, buffer);   // The capacity of the buffer is reused.
+*/
+
+inline auto stringify(
+    const acme::script_value& value,
+    std::string&              out,
+    std::size_t               depth = 0u
+) -> bool
+{
+    using namespace std::string_view_literals;
+
+    const auto size = out.size();
+
+    switch ( value.type() )
+    {
+        case acme::null_type:
+            out += "null"sv;
+            return true;
+
+        case acme::boolean_type:
+            out += to_boolean(value) ? "true"sv : "false"sv;
+            return true;
+
+        case acme::number_type:
+        {
+            if ( const auto number = to_double(value); std::isfinite(number) )
+            {
+                auto buffer = numeric::number_string_buffer{};
+
+                out += numeric::number_to_string(number, buffer);
+            }
+
+            else
+            {
+                out += "null"sv;
+            }
+
+            return true;
+        }
+
+        case acme::string_type:
+            detail::append_quoted(out, std::get<acme::string>(value.m_value).value());
+            return true;
+
+        case acme::object_type:
+            break;
+
+        default:
+            return false;
+    }
+
+    const auto* object = std::get<acme::object>(value.m_value).data();
+
+    if ( object == nullptr || depth >= parser::k_max_depth )
+    {
+        return false;
+    }
+
+    const auto values = object->values();
+
+    if ( object->is_array() )
+    {
+        out += '[';
+
+        for ( std::size_t i{}; i < values.size(); i++ )
+        {
+            if ( i != 0u )
+            {
+                out += ',';
+            }
+
+            if ( detail::is_serializable(values[i]) == false )
+            {
+                out += "null"sv;
+            }
+
+            else if ( stringify(values[i], out, depth + 1u) == false )
+            {
+                out.resize(size);
+                return false;
+            }
+        }
+
+        out += ']';
+        return true;
+    }
+
+    const auto keys = object->keys();
+
+    out += '{';
+
+    auto first = true;
+
+    for ( std::size_t i{}; i < values.size(); i++ )
+    {
+        if ( detail::is_serializable(values[i]) == false )
+        {
+            continue;
+        }
+
+        if ( first == false )
+        {
+            out += ',';
+        }
+
+        first = false;
+
+        detail::append_quoted(out, keys[i].value());
+        out += ':';
+
+        if ( stringify(values[i], out, depth + 1u) == false )
+        {
+            out.resize(size);
+            return false;
+        }
+    }
+
+    out += '}';
+    return true;
+}
+
+} // namespace acme::json
@@ -5,7 +5,10 @@
 
 namespace acme {
 
-constexpr auto match_any = nullptr;
+constexpr auto match_any = [](concepts::character_like auto) constexpr
+{
+    return true;
+};
 
 template <concepts::character_like auto... to_not_match>
 constexpr auto match_not = [](concepts::character_like auto x) constexpr
@@ -0,0 +1,219 @@
+#pragma once
+
+namespace acme {
+
+// Parts of the engine whose allocations are counted separately.
+
+enum class memory_subsystem : std::uint8_t
+{
+    k_parser = 0u,
+    k_string_pool,
+    k_vm_stack,
+    k_object_heap,
+    k_other,
+};
+
+inline constexpr std::size_t k_memory_subsystem_count = static_cast<std::size_t>(memory_subsystem::k_other) + 1u;
+
+// Thrown by an allocation that would exceed the quota of an accounting_resource.
+
+struct quota_exceeded : std::bad_alloc
+{
+    [[nodiscard]] auto what() const noexcept -> const char* override
+    {
+        return "acme::quota_exceeded";
+    }
+};
+
+struct memory_statistics
+{
+    // Allocation sizes are counted in power of two classes, the last class holds the sizes
+    // of 2^(k_size_class_count - 1) bytes and more.
+
+    static constexpr std::size_t k_size_class_count = 16u;
+
+    [[nodiscard]] static constexpr auto size_class(std::size_t bytes) noexcept -> std::size_t
+    {
+        return std::min<std::size_t>(static_cast<std::size_t>(std::bit_width(bytes)), k_size_class_count - 1u);
+    }
+
+    [[nodiscard]] constexpr auto in_use() const noexcept -> std::size_t
+    {
+        return m_allocated - m_freed;
+    }
+
+    std::size_t                                  m_allocated{};
+    std::size_t                                  m_freed{};
+    std::size_t                                  m_peak{};
+    std::size_t                                  m_allocations{};
+    std::array<std::size_t, k_size_class_count> m_histogram{};
+};
+
+/* Memory resource that counts the allocations made through it and fails the ones that would
+   take the bytes in use over a quota. The memory comes from an upstream resource.
+
+   Each subsystem allocates through its own resource(subsystem) so that its bytes are counted
+   separately. The quota applies to the total of all subsystems. An allocation over the quota
+   throws quota_exceeded, a std::bad_alloc, and leaves the statistics as they were.
+
+   The counters are not atomic, a resource is used by one thread at a time.
+*/
+
+struct accounting_resource : public platform::pmr::memory_resource
+{
+    static constexpr std::size_t k_unlimited = std::numeric_limits<std::size_t>::max();
+
+    explicit accounting_resource(
+        std::size_t                     quota    = k_unlimited,
+        platform::pmr::memory_resource* upstream = platform::pmr::get_default_resource()
+    ) noexcept
+        : m_upstream{upstream}
+        , m_quota{quota}
+    {
+        for ( auto& s : m_subsystems )
+        {
+            s.m_owner = this;
+        }
+    }
+
+    accounting_resource(const accounting_resource&)            = delete;
+    accounting_resource& operator=(const accounting_resource&) = delete;
+
+    [[nodiscard]] auto resource(memory_subsystem subsystem) noexcept -> platform::pmr::memory_resource*
+    {
+        return std::addressof(m_subsystems[static_cast<std::size_t>(subsystem)]);
+    }
+
+    [[nodiscard]] auto statistics(memory_subsystem subsystem) const noexcept -> const memory_statistics&
+    {
+        return m_subsystems[static_cast<std::size_t>(subsystem)].m_statistics;
+    }
+
+    // Statistics of all subsystems together.
+
+    [[nodiscard]] auto total() const noexcept -> const memory_statistics&
+    {
+        return m_total;
+    }
+
+    [[nodiscard]] auto quota() const noexcept -> std::size_t
+    {
+        return m_quota;
+    }
+
+    // A quota below the bytes in use fails every allocation until enough is freed.
+
+    auto set_quota(std::size_t quota) noexcept -> void
+    {
+        m_quota = quota;
+    }
+
+    // Peaks start again from the bytes in use, e.g. between the scripts of a tenant.
+
+    auto reset_peak() noexcept -> void
+    {
+        m_total.m_peak = m_total.in_use();
+
+        for ( auto& s : m_subsystems )
+        {
+            s.m_statistics.m_peak = s.m_statistics.in_use();
+        }
+    }
+
+    private:
+
+    struct subsystem_resource : public platform::pmr::memory_resource
+    {
+        [[nodiscard]] void* do_allocate(
+            std::size_t bytes,
+            std::size_t alignment
+        ) override
+        {
+            return m_owner->allocate_for(m_statistics, bytes, alignment);
+        }
+
+        auto do_deallocate(
+            void*       pointer,
+            std::size_t bytes,
+            std::size_t alignment
+        ) -> void override
+        {
+            m_owner->deallocate_for(m_statistics, pointer, bytes, alignment);
+        }
+
+        bool do_is_equal(const platform::pmr::memory_resource& other) const noexcept override
+        {
+            return this == std::addressof(other);
+        }
+
+        accounting_resource* m_owner{};
+        memory_statistics    m_statistics{};
+    };
+
+    [[nodiscard]] void* do_allocate(
+        std::size_t bytes,
+        std::size_t alignment
+    ) override
+    {
+        return allocate_for(m_subsystems[static_cast<std::size_t>(memory_subsystem::k_other)].m_statistics, bytes, alignment);
+    }
+
+    auto do_deallocate(
+        void*       pointer,
+        std::size_t bytes,
+        std::size_t alignment
+    ) -> void override
+    {
+        deallocate_for(m_subsystems[static_cast<std::size_t>(memory_subsystem::k_other)].m_statistics, pointer, bytes, alignment);
+    }
+
+    bool do_is_equal(const platform::pmr::memory_resource& other) const noexcept override
+    {
+        return this == std::addressof(other);
+    }
+
+    [[nodiscard]] auto allocate_for(
+        memory_statistics& statistics,
+        std::size_t        bytes,
+        std::size_t        alignment
+    ) -> void*
+    {
+        if ( bytes > m_quota || m_total.in_use() > m_quota - bytes )
+        {
+            throw acme::quota_exceeded{};
+        }
+
+        auto* pointer = m_upstream->allocate(bytes, alignment);
+
+        for ( auto* s : { std::addressof(statistics), std::addressof(m_total) } )
+        {
+            s->m_allocated   += bytes;
+            s->m_allocations += 1u;
+            s->m_peak         = std::max(s->m_peak, s->in_use());
+
+            s->m_histogram[memory_statistics::size_class(bytes)] += 1u;
+        }
+
+        return pointer;
+    }
+
+    auto deallocate_for(
+        memory_statistics& statistics,
+        void*              pointer,
+        std::size_t        bytes,
+        std::size_t        alignment
+    ) -> void
+    {
+        m_upstream->deallocate(pointer, bytes, alignment);
+
+        statistics.m_freed += bytes;
+        m_total.m_freed    += bytes;
+    }
+
+    platform::pmr::memory_resource*                          m_upstream;
+    std::size_t                                              m_quota;
+    memory_statistics                                        m_total{};
+    std::array<subsystem_resource, k_memory_subsystem_count> m_subsystems{};
+};
+
+} // namespace acme
@@ -26,10 +26,11 @@ struct fixed_buffer_resource : public platform::pmr::memory_resource
         const auto offset      = (alignment - std::uintptr_t(m_buffer)) & mask;
         const auto total_bytes = offset + bytes;
 
+        // Like any memory resource, fail by throwing so that the owner can recover.
+
         if ( total_bytes > m_size )
         {
-            assert(false && "Buffer overflow");
-            std::abort();
+            throw std::bad_alloc{};
         }
 
         m_size   -= total_bytes;
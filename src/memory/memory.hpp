@@ -1,5 +1,6 @@
 
 #include "concepts.hpp"
+#include "accounting_resource.hpp"
 
 namespace acme {
 
@@ -153,8 +154,18 @@ struct unique_ptr
 
 struct unique_ptr_pmr_deleter
 {
-    inline void operator()(void* ptr)
+    template <typename T>
+    constexpr void operator()(T* ptr)
     {
+        // Objects created during constant evaluation come from the
+        // default allocator and have no memory resource attached.
+
+        if ( allocator == nullptr )
+        {
+            delete ptr;
+            return;
+        }
+
         allocator->deallocate(ptr, size, align);
     }
 
@@ -174,6 +185,15 @@ template <typename T>
     auto&&...                       arguments
 )
 {
+    if ( std::is_constant_evaluated() )
+    {
+        return unique_ptr<T>
+        {
+            new T(std::forward<decltype(arguments)>(arguments)...),
+                detail::unique_ptr_pmr_deleter{}
+        };
+    }
+
     assert(resource != nullptr);
 
     return unique_ptr<T>
@@ -0,0 +1,278 @@
+#pragma once
+
+namespace acme::numeric {
+
+// Longest output is 25 characters, e.g. "-0.0000012345678901234567" or "-1.2345678901234567e-308".
+
+inline constexpr auto k_max_number_string_length = std::size_t{32};
+
+using number_string_buffer = std::array<char, k_max_number_string_length>;
+
+namespace detail {
+
+// Decimal strings of the integers [0, k_small_integer_count) laid out back to back.
+
+inline constexpr auto k_small_integer_count = std::uint32_t{1024};
+
+[[nodiscard]] constexpr auto decimal_digit_count(std::uint32_t n) noexcept -> std::size_t
+{
+    auto count = std::size_t{1};
+
+    for ( ; n >= 10; n /= 10 )
+    {
+        count++;
+    }
+
+    return count;
+}
+
+[[nodiscard]] constexpr auto small_integers_length() noexcept -> std::size_t
+{
+    auto length = std::size_t{};
+
+    for ( std::uint32_t i{}; i < k_small_integer_count; i++ )
+    {
+        length += decimal_digit_count(i);
+    }
+
+    return length;
+}
+
+struct small_integer_table
+{
+    constexpr small_integer_table() noexcept
+    {
+        auto offset = std::size_t{};
+
+        for ( std::uint32_t i{}; i < k_small_integer_count; i++ )
+        {
+            const auto count = decimal_digit_count(i);
+            auto       value = i;
+
+            for ( auto j = count; j > 0; j-- )
+            {
+                m_chars[offset + j - 1] = static_cast<char>('0' + value % 10);
+                value /= 10;
+            }
+
+            m_offsets[i] = static_cast<std::uint16_t>(offset);
+            offset      += count;
+        }
+
+        m_offsets[k_small_integer_count] = static_cast<std::uint16_t>(offset);
+    }
+
+    [[nodiscard]] constexpr auto get(std::uint32_t n) const noexcept -> std::string_view
+    {
+        return std::string_view{m_chars.data() + m_offsets[n], static_cast<std::size_t>(m_offsets[n + 1] - m_offsets[n])};
+    }
+
+    std::array<char, small_integers_length()>            m_chars{};
+    std::array<std::uint16_t, k_small_integer_count + 1> m_offsets{};
+};
+
+inline constexpr auto k_small_integers = small_integer_table{};
+
+// Lay out the shortest round-trip digits following ECMAScript Number::toString.
+// The value is digits * 10^(n - k) where k is the number of digits.
+
+[[nodiscard]] constexpr auto layout_number(
+    std::string_view digits,
+    std::int32_t     n,
+    bool             negative,
+    char*            out
+) noexcept -> std::size_t
+{
+    const auto k      = static_cast<std::int32_t>(digits.size());
+    auto       length = std::size_t{};
+
+    const auto put = [&](char c)
+    {
+        out[length++] = c;
+    };
+
+    const auto put_digits = [&](std::int32_t first, std::int32_t last)
+    {
+        for ( auto i = first; i < last; i++ )
+        {
+            put(digits[static_cast<std::size_t>(i)]);
+        }
+    };
+
+    if ( negative )
+    {
+        put('-');
+    }
+
+    // Integer: digits followed by n - k zeros.
+
+    if ( k <= n && n <= 21 )
+    {
+        put_digits(0, k);
+
+        for ( auto i = k; i < n; i++ )
+        {
+            put('0');
+        }
+    }
+
+    // Decimal point within the digits.
+
+    else if ( 0 < n && n <= 21 )
+    {
+        put_digits(0, n);
+        put('.');
+        put_digits(n, k);
+    }
+
+    // Small fraction: "0." followed by -n zeros.
+
+    else if ( -6 < n && n <= 0 )
+    {
+        put('0');
+        put('.');
+
+        for ( auto i = n; i < 0; i++ )
+        {
+            put('0');
+        }
+
+        put_digits(0, k);
+    }
+
+    // Exponential notation.
+
+    else
+    {
+        put(digits[0]);
+
+        if ( k > 1 )
+        {
+            put('.');
+            put_digits(1, k);
+        }
+
+        put('e');
+        put(n - 1 < 0 ? '-' : '+');
+
+        auto exponent = n - 1 < 0 ? 1 - n : n - 1;
+        char exponent_digits[4]{};
+        auto count = 0;
+
+        do
+        {
+            exponent_digits[count++] = static_cast<char>('0' + exponent % 10);
+            exponent /= 10;
+        }
+        while ( exponent != 0 );
+
+        while ( count > 0 )
+        {
+            put(exponent_digits[--count]);
+        }
+    }
+
+    return length;
+}
+
+} // namespace detail
+
+// Format a finite, non-zero number. Uses the shortest digit sequence that round-trips
+// (std::to_chars implements Ryu) and the ECMAScript layout rules.
+
+[[nodiscard]] inline auto number_to_chars(
+    double                value,
+    number_string_buffer& buffer
+) noexcept -> std::string_view
+{
+    // Scientific form from to_chars: d[.ddd]e(+|-)xx
+
+    char scientific[k_max_number_string_length]{};
+
+    const auto negative = value < 0.0;
+    const auto [end, ec] = std::to_chars(std::begin(scientific), std::end(scientific), negative ? -value : value, std::chars_format::scientific);
+
+    assert(ec == std::errc{});
+
+    const auto text     = std::string_view{scientific, static_cast<std::size_t>(end - scientific)};
+    const auto exp_pos  = text.find('e');
+    const auto mantissa = text.substr(0, exp_pos);
+
+    char digits[k_max_number_string_length]{};
+    auto digit_count = std::size_t{};
+
+    for ( const auto c : mantissa )
+    {
+        if ( c != '.' )
+        {
+            digits[digit_count++] = c;
+        }
+    }
+
+    auto exponent          = std::int32_t{};
+    const auto exp_text    = text.substr(exp_pos + 1);
+    const auto exp_digits  = exp_text.substr(1);
+
+    std::from_chars(exp_digits.data(), exp_digits.data() + exp_digits.size(), exponent);
+
+    if ( exp_text.front() == '-' )
+    {
+        exponent = -exponent;
+    }
+
+    const auto length = detail::layout_number(std::string_view{digits, digit_count}, exponent + 1, negative, buffer.data());
+
+    return std::string_view{buffer.data(), length};
+}
+
+// Cached representation of common numbers. Returns an empty view if the number is not cached.
+
+[[nodiscard]] constexpr auto cached_number_string(double value) noexcept -> std::string_view
+{
+    using namespace std::string_view_literals;
+
+    if ( value != value )
+    {
+        return "NaN"sv;
+    }
+
+    if ( value == std::numeric_limits<double>::infinity() )
+    {
+        return "Infinity"sv;
+    }
+
+    if ( value == -std::numeric_limits<double>::infinity() )
+    {
+        return "-Infinity"sv;
+    }
+
+    // Both +0 and -0 are formatted as "0".
+
+    if ( value >= 0.0 && value < detail::k_small_integer_count )
+    {
+        if ( const auto n = static_cast<std::uint32_t>(value); static_cast<double>(n) == value )
+        {
+            return detail::k_small_integers.get(n);
+        }
+    }
+
+    return {};
+}
+
+// ECMAScript Number::toString(10). Common values refer to static storage,
+// other values are formatted into the given buffer.
+
+[[nodiscard]] inline auto number_to_string(
+    double                value,
+    number_string_buffer& buffer
+) noexcept -> std::string_view
+{
+    if ( auto cached = cached_number_string(value); cached.empty() == false )
+    {
+        return cached;
+    }
+
+    return number_to_chars(value, buffer);
+}
+
+} // namespace acme::numeric
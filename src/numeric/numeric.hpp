@@ -0,0 +1,6 @@
+#pragma once
+
+#include "swar.hpp"
+#include "parse_number.hpp"
+#include "string_to_number.hpp"
+#include "number_to_string.hpp"
@@ -0,0 +1,458 @@
+#pragma once
+
+namespace acme::numeric {
+
+struct parsed_number
+{
+    [[nodiscard]] constexpr auto is_integer() const noexcept -> bool
+    {
+        return m_integer;
+    }
+
+    double        m_value{};     // Correctly rounded value of the literal.
+    std::uint64_t m_magnitude{}; // Exact absolute value if the literal is an integer.
+    std::size_t   m_length{};    // Number of characters consumed.
+    bool          m_negative{};
+    bool          m_integer{};   // No fraction or exponent part and the magnitude fits 64 bits.
+};
+
+namespace detail {
+
+inline constexpr auto k_max_mantissa_digits = 19;
+inline constexpr auto k_max_exact_integer   = std::uint64_t{1} << 53;
+
+// Powers of ten that are exactly representable as a double.
+
+inline constexpr auto k_exact_powers_of_ten = std::array
+{
+    1e0,  1e1,  1e2,  1e3,  1e4,  1e5,  1e6,  1e7,  1e8,  1e9,  1e10, 1e11,
+    1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22
+};
+
+[[nodiscard]] constexpr auto digit_value(
+    char          c,
+    std::uint32_t radix
+) noexcept -> std::uint32_t
+{
+    auto value = std::uint32_t{radix};
+
+    if ( c >= '0' && c <= '9' )
+    {
+        value = static_cast<std::uint32_t>(c - '0');
+    }
+
+    else if ( c >= 'a' && c <= 'z' )
+    {
+        value = static_cast<std::uint32_t>(c - 'a' + 10);
+    }
+
+    else if ( c >= 'A' && c <= 'Z' )
+    {
+        value = static_cast<std::uint32_t>(c - 'A' + 10);
+    }
+
+    // Returns radix for non-digits.
+
+    return value < radix ? value : radix;
+}
+
+// Accumulates up to 19 significant decimal digits. Digits beyond that are counted
+// but not stored, in which case the value must be parsed by the slow path.
+
+struct decimal_accumulator
+{
+    constexpr void push(std::uint32_t digit) noexcept
+    {
+        if ( m_significant < k_max_mantissa_digits )
+        {
+            m_mantissa = m_mantissa * 10 + digit;
+
+            if ( m_mantissa != 0 )
+            {
+                m_significant++;
+            }
+
+            m_stored++;
+            return;
+        }
+
+        m_truncated = m_truncated || digit != 0;
+        m_dropped++;
+    }
+
+    [[nodiscard]] constexpr auto try_push_eight(std::string_view text, std::size_t position) noexcept -> bool
+    {
+        if ( position + 8 > text.size() || m_significant + 8 > k_max_mantissa_digits )
+        {
+            return false;
+        }
+
+        const auto word = load_eight_chars(text.data() + position);
+
+        if ( is_eight_digits(word) == false )
+        {
+            return false;
+        }
+
+        m_mantissa = m_mantissa * 100'000'000 + parse_eight_digits(word);
+
+        // Over-counts leading zeros which at worst sends the number to the slow path.
+
+        if ( m_mantissa != 0 )
+        {
+            m_significant += 8;
+        }
+
+        m_stored += 8;
+        return true;
+    }
+
+    std::uint64_t m_mantissa{};
+    std::int32_t  m_significant{};
+    std::int32_t  m_stored{};
+    std::int32_t  m_dropped{};
+    bool          m_truncated{};
+};
+
+struct decimal_scan
+{
+    std::uint64_t m_mantissa{};
+    std::int64_t  m_exponent{};
+    std::size_t   m_length{};
+    bool          m_truncated{};
+    bool          m_integer{true};
+};
+
+// Scans 'digits [. digits] [(e|E) [+|-] digits]'. At least one mantissa digit is required.
+
+[[nodiscard]] constexpr auto scan_decimal(std::string_view text) noexcept -> std::optional<decimal_scan>
+{
+    auto accumulator = decimal_accumulator{};
+    auto position    = std::size_t{};
+    auto exponent    = std::int64_t{};
+
+    const auto consume_digits = [&](bool fraction)
+    {
+        const auto start = position;
+
+        while ( accumulator.try_push_eight(text, position) )
+        {
+            position += 8;
+            exponent -= fraction ? 8 : 0;
+        }
+
+        while ( position < text.size() && text[position] >= '0' && text[position] <= '9' )
+        {
+            const auto stored = accumulator.m_stored;
+
+            accumulator.push(static_cast<std::uint32_t>(text[position] - '0'));
+            position++;
+
+            // Integer digits that were dropped scale the value up, dropped
+            // fraction digits do not contribute to the exponent.
+
+            if ( fraction && accumulator.m_stored != stored )
+            {
+                exponent--;
+            }
+
+            else if ( fraction == false && accumulator.m_stored == stored )
+            {
+                exponent++;
+            }
+        }
+
+        return position - start;
+    };
+
+    auto result = decimal_scan{};
+
+    auto digit_count = consume_digits(false);
+
+    if ( position < text.size() && text[position] == '.' )
+    {
+        position++;
+        result.m_integer = false;
+        digit_count     += consume_digits(true);
+    }
+
+    if ( digit_count == 0 )
+    {
+        return {};
+    }
+
+    // Exponent part. Only consumed if followed by at least one digit.
+
+    if ( position < text.size() && (text[position] == 'e' || text[position] == 'E') )
+    {
+        auto next          = position + 1;
+        auto exp_negative  = false;
+
+        if ( next < text.size() && (text[next] == '+' || text[next] == '-') )
+        {
+            exp_negative = text[next] == '-';
+            next++;
+        }
+
+        if ( next < text.size() && text[next] >= '0' && text[next] <= '9' )
+        {
+            auto exp_value = std::int64_t{};
+
+            while ( next < text.size() && text[next] >= '0' && text[next] <= '9' )
+            {
+                // Clamp huge exponents, the result is either zero or infinity anyway.
+
+                if ( exp_value < 100'000 )
+                {
+                    exp_value = exp_value * 10 + (text[next] - '0');
+                }
+
+                next++;
+            }
+
+            exponent        += exp_negative ? -exp_value : exp_value;
+            position         = next;
+            result.m_integer = false;
+        }
+    }
+
+    result.m_mantissa  = accumulator.m_mantissa;
+    result.m_exponent  = exponent;
+    result.m_length    = position;
+    result.m_truncated = accumulator.m_truncated;
+
+    return result;
+}
+
+// Clinger's fast path: exact when both the mantissa and the power of ten are exactly representable.
+
+[[nodiscard]] constexpr auto fast_path(const decimal_scan& scan) noexcept -> std::optional<double>
+{
+    if ( scan.m_truncated || scan.m_mantissa > k_max_exact_integer )
+    {
+        return {};
+    }
+
+    if ( scan.m_mantissa == 0 )
+    {
+        return 0.0;
+    }
+
+    const auto mantissa = static_cast<double>(scan.m_mantissa);
+    const auto max_pow  = static_cast<std::int64_t>(k_exact_powers_of_ten.size() - 1);
+
+    if ( scan.m_exponent >= 0 && scan.m_exponent <= max_pow )
+    {
+        return mantissa * k_exact_powers_of_ten[static_cast<std::size_t>(scan.m_exponent)];
+    }
+
+    if ( scan.m_exponent < 0 && -scan.m_exponent <= max_pow )
+    {
+        return mantissa / k_exact_powers_of_ten[static_cast<std::size_t>(-scan.m_exponent)];
+    }
+
+    // Move part of the exponent into the mantissa if it stays exact, e.g. 1e25.
+
+    if ( scan.m_exponent > max_pow && scan.m_exponent <= max_pow + 15 )
+    {
+        auto shifted = scan.m_mantissa;
+
+        for ( auto i = max_pow; i < scan.m_exponent; i++ )
+        {
+            shifted *= 10;
+
+            if ( shifted > k_max_exact_integer )
+            {
+                return {};
+            }
+        }
+
+        return static_cast<double>(shifted) * k_exact_powers_of_ten.back();
+    }
+
+    return {};
+}
+
+// Slow path for values outside of the fast path. std::from_chars is correctly rounded
+// (libstdc++ implements it with the fast_float Eisel-Lemire algorithm). It is not usable
+// during constant evaluation where the value is scaled by powers of ten instead.
+
+[[nodiscard]] constexpr auto slow_path(
+    const decimal_scan& scan,
+    std::string_view    text
+) noexcept -> double
+{
+    if ( std::is_constant_evaluated() )
+    {
+        auto value    = static_cast<double>(scan.m_mantissa);
+        auto exponent = scan.m_exponent;
+
+        for ( ; exponent > 0 && value != std::numeric_limits<double>::infinity(); exponent-- )
+        {
+            value *= 10.0;
+        }
+
+        for ( ; exponent < 0 && value != 0.0; exponent++ )
+        {
+            value /= 10.0;
+        }
+
+        return value;
+    }
+
+    auto value        = double{};
+    const auto* first = text.data();
+    const auto* last  = text.data() + scan.m_length;
+
+    if ( const auto [ptr, ec] = std::from_chars(first, last, value); ec == std::errc::result_out_of_range )
+    {
+        return scan.m_exponent > 0 ? std::numeric_limits<double>::infinity() : 0.0;
+    }
+
+    return value;
+}
+
+} // namespace detail
+
+// Parse an unsigned integer of the given radix from the beginning of the text. Decimal
+// digits are consumed eight at a time. Values that overflow 64 bits are approximated
+// and reported as non-integers.
+
+[[nodiscard]] constexpr auto parse_integer(
+    std::string_view text,
+    std::uint32_t    radix
+) noexcept -> std::optional<parsed_number>
+{
+    auto result   = parsed_number{};
+    auto overflow = false;
+    auto position = std::size_t{};
+
+    if ( radix == 10 )
+    {
+        while ( result.m_magnitude < 100'000'000'000 && position + 8 <= text.size() )
+        {
+            const auto word = load_eight_chars(text.data() + position);
+
+            if ( is_eight_digits(word) == false )
+            {
+                break;
+            }
+
+            result.m_magnitude = result.m_magnitude * 100'000'000 + parse_eight_digits(word);
+            position          += 8;
+        }
+    }
+
+    for ( ; position < text.size(); position++ )
+    {
+        const auto digit = detail::digit_value(text[position], radix);
+
+        if ( digit == radix )
+        {
+            break;
+        }
+
+        if ( overflow == false && result.m_magnitude > (std::numeric_limits<std::uint64_t>::max() - digit) / radix )
+        {
+            overflow       = true;
+            result.m_value = static_cast<double>(result.m_magnitude);
+        }
+
+        if ( overflow )
+        {
+            result.m_value = result.m_value * radix + digit;
+        }
+
+        else
+        {
+            result.m_magnitude = result.m_magnitude * radix + digit;
+        }
+    }
+
+    if ( position == 0 )
+    {
+        return {};
+    }
+
+    if ( overflow == false )
+    {
+        result.m_value = static_cast<double>(result.m_magnitude);
+    }
+
+    result.m_length  = position;
+    result.m_integer = overflow == false;
+
+    return result;
+}
+
+// Parse a numeric literal from the beginning of the text: an optionally signed decimal
+// number with fraction and exponent parts, or an unsigned 0x, 0o or 0b prefixed integer.
+
+[[nodiscard]] constexpr auto parse_number(std::string_view text) noexcept -> std::optional<parsed_number>
+{
+    if ( text.size() > 2 && text[0] == '0' )
+    {
+        const auto radix = [&]() -> std::uint32_t
+        {
+            switch ( text[1] )
+            {
+                case 'x': case 'X': return 16;
+                case 'o': case 'O': return 8;
+                case 'b': case 'B': return 2;
+                default:            return 0;
+            }
+        }();
+
+        if ( radix != 0 )
+        {
+            if ( auto result = parse_integer(text.substr(2), radix); result.has_value() )
+            {
+                result->m_length += 2;
+                return result;
+            }
+
+            return {};
+        }
+    }
+
+    const auto negative = text.empty() == false && text[0] == '-';
+    const auto sign     = (text.empty() == false && (text[0] == '-' || text[0] == '+')) ? std::size_t{1} : std::size_t{0};
+    const auto unsigned_text = text.substr(sign);
+
+    const auto scan = detail::scan_decimal(unsigned_text);
+
+    if ( scan.has_value() == false )
+    {
+        return {};
+    }
+
+    auto result = parsed_number{};
+
+    if ( auto fast = detail::fast_path(*scan); fast.has_value() )
+    {
+        result.m_value = *fast;
+    }
+
+    else
+    {
+        result.m_value = detail::slow_path(*scan, unsigned_text);
+    }
+
+    result.m_negative = negative;
+    result.m_length   = sign + scan->m_length;
+    result.m_integer  = scan->m_integer && scan->m_truncated == false && scan->m_exponent == 0;
+
+    if ( result.m_integer )
+    {
+        result.m_magnitude = scan->m_mantissa;
+    }
+
+    if ( negative )
+    {
+        result.m_value = -result.m_value;
+    }
+
+    return result;
+}
+
+} // namespace acme::numeric
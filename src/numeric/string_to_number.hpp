@@ -0,0 +1,61 @@
+#pragma once
+
+namespace acme::numeric {
+
+namespace detail {
+
+[[nodiscard]] constexpr auto is_string_whitespace(char c) noexcept -> bool
+{
+    return c == ' ' || c == '\t' || c == '\n' || c == '\v' || c == '\f' || c == '\r';
+}
+
+[[nodiscard]] constexpr auto trim(std::string_view text) noexcept -> std::string_view
+{
+    while ( text.empty() == false && is_string_whitespace(text.front()) )
+    {
+        text.remove_prefix(1);
+    }
+
+    while ( text.empty() == false && is_string_whitespace(text.back()) )
+    {
+        text.remove_suffix(1);
+    }
+
+    return text;
+}
+
+} // namespace detail
+
+// ECMAScript StringToNumber: the whole string, ignoring surrounding white space,
+// must be a numeric literal. Otherwise the result is NaN.
+
+[[nodiscard]] constexpr auto string_to_number(std::string_view text) noexcept -> double
+{
+    using namespace std::string_view_literals;
+
+    text = detail::trim(text);
+
+    if ( text.empty() )
+    {
+        return 0.0;
+    }
+
+    if ( text == "Infinity"sv || text == "+Infinity"sv )
+    {
+        return std::numeric_limits<double>::infinity();
+    }
+
+    if ( text == "-Infinity"sv )
+    {
+        return -std::numeric_limits<double>::infinity();
+    }
+
+    if ( auto number = parse_number(text); number.has_value() && number->m_length == text.size() )
+    {
+        return number->m_value;
+    }
+
+    return std::numeric_limits<double>::quiet_NaN();
+}
+
+} // namespace acme::numeric
@@ -0,0 +1,40 @@
+#pragma once
+
+namespace acme::numeric {
+
+// SIMD-within-a-register helpers for parsing eight ASCII digits at a time.
+// See: https://lemire.me/blog/2022/01/21/swar-explained-parsing-eight-digits/
+
+// Load eight characters as a little-endian word regardless of the host byte order.
+
+[[nodiscard]] constexpr auto load_eight_chars(const char* chars) noexcept -> std::uint64_t
+{
+    auto word = std::uint64_t{};
+
+    for ( std::size_t i{}; i < 8; i++ )
+    {
+        word |= static_cast<std::uint64_t>(static_cast<unsigned char>(chars[i])) << (i * 8);
+    }
+
+    return word;
+}
+
+[[nodiscard]] constexpr auto is_eight_digits(std::uint64_t word) noexcept -> bool
+{
+    return ((word & 0xF0F0F0F0F0F0F0F0) | (((word + 0x0606060606060606) & 0xF0F0F0F0F0F0F0F0) >> 4)) == 0x3333333333333333;
+}
+
+[[nodiscard]] constexpr auto parse_eight_digits(std::uint64_t word) noexcept -> std::uint32_t
+{
+    constexpr auto k_mask = std::uint64_t{0x000000FF000000FF};
+    constexpr auto k_mul1 = std::uint64_t{0x000F424000000064}; // 100 + (1000000ULL << 32)
+    constexpr auto k_mul2 = std::uint64_t{0x0000271000000001}; // 1 + (10000ULL << 32)
+
+    word -= 0x3030303030303030;
+    word  = (word * 10) + (word >> 8);
+    word  = (((word & k_mask) * k_mul1) + (((word >> 16) & k_mask) * k_mul2)) >> 32;
+
+    return static_cast<std::uint32_t>(word);
+}
+
+} // namespace acme::numeric
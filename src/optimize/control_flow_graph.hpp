@@ -0,0 +1,290 @@
+#pragma once
+
+namespace acme::opt {
+
+inline constexpr auto k_no_block = std::numeric_limits<std::size_t>::max();
+
+// Set of small integers, e.g. block or variable indices.
+
+struct bit_set
+{
+    using word_type = std::uint64_t;
+
+    static constexpr auto k_word_bits = std::size_t{64};
+
+    constexpr bit_set() = default;
+
+    constexpr explicit bit_set(std::size_t count, bool value = false)
+        : m_words((count + k_word_bits - 1) / k_word_bits)
+        , m_count{count}
+    {
+        if ( value )
+        {
+            set_all();
+        }
+    }
+
+    [[nodiscard]] constexpr auto test(std::size_t i) const -> bool
+    {
+        return (m_words[i / k_word_bits] >> (i % k_word_bits)) & 1u;
+    }
+
+    constexpr void set(std::size_t i)
+    {
+        m_words[i / k_word_bits] |= word_type{1} << (i % k_word_bits);
+    }
+
+    constexpr void reset(std::size_t i)
+    {
+        m_words[i / k_word_bits] &= ~(word_type{1} << (i % k_word_bits));
+    }
+
+    constexpr void set_all()
+    {
+        for ( std::size_t i{}; i < m_count; i++ )
+        {
+            set(i);
+        }
+    }
+
+    constexpr auto operator|=(const bit_set& other) -> bit_set&
+    {
+        for ( std::size_t i{}; i < m_words.size(); i++ )
+        {
+            m_words[i] |= other.m_words[i];
+        }
+
+        return *this;
+    }
+
+    constexpr auto operator&=(const bit_set& other) -> bit_set&
+    {
+        for ( std::size_t i{}; i < m_words.size(); i++ )
+        {
+            m_words[i] &= other.m_words[i];
+        }
+
+        return *this;
+    }
+
+    [[nodiscard]] constexpr auto operator==(const bit_set& other) const -> bool
+    {
+        return m_words == other.m_words;
+    }
+
+    acme::dynamic_cvector<word_type> m_words{};
+    std::size_t                      m_count{};
+};
+
+// Straight-line instructions ending with at most one jump. The jump itself is not stored
+// in the body, it is described by the terminator and re-emitted once the blocks are laid out.
+
+struct basic_block
+{
+    using instructions_type = acme::dynamic_cvector<acme::instruction>;
+
+    [[nodiscard]] constexpr auto is_conditional() const noexcept -> bool
+    {
+        return m_terminator == opcode::jump_if_false || m_terminator == opcode::jump_if_true;
+    }
+
+    [[nodiscard]] constexpr auto falls_through() const noexcept -> bool
+    {
+        return m_terminator != opcode::jump_to && m_next != k_no_block;
+    }
+
+    instructions_type m_instructions{};
+    opcode            m_terminator{opcode::no_opearation}; // jump_to, jump_if_false, jump_if_true or no_opearation.
+    std::size_t       m_target{k_no_block};                // Jump target.
+    std::size_t       m_next{k_no_block};                  // Fall-through successor.
+    std::int32_t      m_scope_depth{};                     // Stack frames on entry.
+};
+
+struct control_flow_graph
+{
+    using blocks_type = acme::dynamic_cvector<basic_block>;
+    using layout_type = acme::dynamic_cvector<std::size_t>;
+
+    [[nodiscard]] constexpr auto successors(std::size_t b) const -> std::array<std::size_t, 2>
+    {
+        const auto& block = m_blocks[b];
+
+        return
+        {
+            block.m_terminator != opcode::no_opearation ? block.m_target : k_no_block,
+            block.falls_through() ? block.m_next : k_no_block,
+        };
+    }
+
+    [[nodiscard]] constexpr auto predecessors() const -> acme::dynamic_cvector<acme::dynamic_cvector<std::size_t>>
+    {
+        auto result = acme::dynamic_cvector<acme::dynamic_cvector<std::size_t>>(m_blocks.size());
+
+        for ( const auto b : m_layout )
+        {
+            for ( const auto s : successors(b) )
+            {
+                if ( s != k_no_block )
+                {
+                    result[s].push_back(b);
+                }
+            }
+        }
+
+        return result;
+    }
+
+    [[nodiscard]] constexpr auto instruction_count() const -> std::size_t
+    {
+        auto count = std::size_t{};
+
+        for ( const auto b : m_layout )
+        {
+            count += m_blocks[b].m_instructions.size() + (m_blocks[b].m_terminator != opcode::no_opearation ? 1 : 0);
+        }
+
+        return count;
+    }
+
+    blocks_type m_blocks{};
+    layout_type m_layout{};  // Emission order of the blocks in use, the entry block first.
+};
+
+// Split the instructions into basic blocks at jump targets and after jumps.
+
+[[nodiscard]] constexpr auto build_control_flow_graph(std::span<const acme::instruction> instructions) -> control_flow_graph
+{
+    const auto is_jump = [](opcode op)
+    {
+        return op == opcode::jump_to || op == opcode::jump_if_false || op == opcode::jump_if_true;
+    };
+
+    const auto count = instructions.size();
+
+    auto leaders  = bit_set(count + 1);
+    auto block_of = acme::dynamic_cvector<std::size_t>(count + 1);
+    auto graph    = control_flow_graph{};
+
+    leaders.set(0);
+    leaders.set(count);
+
+    for ( std::size_t pc{}; pc < count; pc++ )
+    {
+        if ( is_jump(operand(instructions[pc])) )
+        {
+            leaders.set(std::min<std::size_t>(immediate(instructions[pc]), count));
+            leaders.set(pc + 1);
+        }
+    }
+
+    // The end of the code maps to no block.
+
+    for ( std::size_t pc{}, b{k_no_block}; pc <= count; pc++ )
+    {
+        if ( leaders.test(pc) )
+        {
+            b = pc < count ? graph.m_blocks.size() : k_no_block;
+
+            if ( pc < count )
+            {
+                graph.m_blocks.emplace_back();
+                graph.m_layout.push_back(b);
+            }
+        }
+
+        block_of[pc] = b;
+    }
+
+    for ( std::size_t pc{}; pc < count; pc++ )
+    {
+        auto&      block = graph.m_blocks[block_of[pc]];
+        const auto ins   = instructions[pc];
+
+        if ( is_jump(operand(ins)) )
+        {
+            block.m_terminator = operand(ins);
+            block.m_target     = block_of[std::min<std::size_t>(immediate(ins), count)];
+        }
+
+        else
+        {
+            block.m_instructions.push_back(ins);
+        }
+
+        if ( leaders.test(pc + 1) && operand(ins) != opcode::jump_to )
+        {
+            block.m_next = block_of[pc + 1];
+        }
+    }
+
+    return graph;
+}
+
+// Lay out the blocks and resolve the jump targets. Jumps to the next block are dropped and
+// fall-through edges to a block that is not laid out next get an explicit jump.
+
+[[nodiscard]] constexpr auto emit_control_flow_graph(const control_flow_graph& graph) -> acme::dynamic_cvector<acme::instruction>
+{
+    const auto& layout = graph.m_layout;
+
+    auto offsets = acme::dynamic_cvector<std::size_t>(graph.m_blocks.size());
+    auto result  = acme::dynamic_cvector<acme::instruction>{};
+
+    const auto next_in_layout = [&](std::size_t i)
+    {
+        return i + 1 < layout.size() ? layout[i + 1] : k_no_block;
+    };
+
+    const auto jumps = [&](std::size_t i) -> std::array<bool, 2>
+    {
+        const auto& block = graph.m_blocks[layout[i]];
+        const auto  next  = next_in_layout(i);
+
+        const auto terminator = block.m_terminator != opcode::no_opearation && (block.m_terminator != opcode::jump_to || block.m_target != next);
+        const auto fall       = block.falls_through() && block.m_next != next;
+
+        return { terminator, fall };
+    };
+
+    auto offset = std::size_t{};
+
+    for ( std::size_t i{}; i < layout.size(); i++ )
+    {
+        const auto [terminator, fall] = jumps(i);
+
+        offsets[layout[i]] = offset;
+        offset            += graph.m_blocks[layout[i]].m_instructions.size() + (terminator ? 1 : 0) + (fall ? 1 : 0);
+    }
+
+    const auto offset_of = [&](std::size_t b)
+    {
+        return static_cast<acme::instruction::immediate_type>(b == k_no_block ? offset : offsets[b]);
+    };
+
+    result.reserve(offset);
+
+    for ( std::size_t i{}; i < layout.size(); i++ )
+    {
+        const auto& block             = graph.m_blocks[layout[i]];
+        const auto [terminator, fall] = jumps(i);
+
+        for ( const auto& ins : block.m_instructions )
+        {
+            result.push_back(ins);
+        }
+
+        if ( terminator )
+        {
+            result.push_back(acme::instruction::make(block.m_terminator, offset_of(block.m_target)));
+        }
+
+        if ( fall )
+        {
+            result.push_back(acme::instruction::make(opcode::jump_to, offset_of(block.m_next)));
+        }
+    }
+
+    return result;
+}
+
+} // namespace acme::opt
@@ -0,0 +1,602 @@
+#pragma once
+
+namespace acme::opt {
+
+namespace detail {
+
+[[nodiscard]] constexpr auto is_variable_access(opcode op) noexcept -> bool
+{
+    return op == opcode::load_var || op == opcode::store_var || op == opcode::initialize;
+}
+
+[[nodiscard]] constexpr auto is_frame_operation(opcode op) noexcept -> bool
+{
+    return op == opcode::push_stack_frame || op == opcode::pop_stack_frame;
+}
+
+// Instructions without side effects other than the values they push.
+
+[[nodiscard]] constexpr auto is_pure(opcode op) noexcept -> bool
+{
+    switch ( generic_opcode(op) )
+    {
+        case opcode::store_var:
+        case opcode::initialize:
+        case opcode::push_stack_frame:
+        case opcode::pop_stack_frame:
+        case opcode::unary_delete:
+        case opcode::jump_if_false:
+        case opcode::jump_if_true:
+        case opcode::jump_to:
+        case opcode::call_native:
+        case opcode::load_host_field:   // Getters run host code.
+            return false;
+
+        default:
+            return true;
+    }
+}
+
+} // namespace detail
+
+// Dense indices for the variables referenced by the bytecode.
+
+struct variable_table
+{
+    constexpr variable_table(
+        const control_flow_graph&                 graph,
+        std::span<const acme::number_constant>    numbers
+    )
+        : m_numbers{numbers}
+    {
+        for ( const auto& block : graph.m_blocks )
+        {
+            for ( const auto ins : block.m_instructions )
+            {
+                if ( operand(ins) == opcode::constant_identifier && index_of(numbers[immediate(ins)].m_hash) == k_no_block )
+                {
+                    m_ids.push_back(numbers[immediate(ins)].m_hash);
+                }
+            }
+        }
+    }
+
+    [[nodiscard]] constexpr auto index_of(acme::identifier id) const -> std::size_t
+    {
+        for ( std::size_t i{}; i < m_ids.size(); i++ )
+        {
+            if ( m_ids[i] == id )
+            {
+                return i;
+            }
+        }
+
+        return k_no_block;
+    }
+
+    [[nodiscard]] constexpr auto size() const noexcept
+    {
+        return m_ids.size();
+    }
+
+    // Index of the instruction in the block that produced the value at the given depth of the
+    // operand stack before `index`, 0 being the top. Returns k_no_block for values produced in
+    // another block. Duplicated values are followed to the original.
+
+    [[nodiscard]] static constexpr auto producer(
+        const basic_block::instructions_type& body,
+        std::size_t                           index,
+        std::size_t                           depth
+    ) -> std::size_t
+    {
+        for ( auto i = index; i > 0; i-- )
+        {
+            const auto op     = operand(body[i - 1]);
+            const auto effect = stack_effect_of(body[i - 1]);
+
+            if ( depth < effect.m_pushes )
+            {
+                return op == opcode::duplicate_top ? producer(body, i - 1, 0) : i - 1;
+            }
+
+            depth = depth - effect.m_pushes + effect.m_pops;
+        }
+
+        return k_no_block;
+    }
+
+    // Variable accessed by the load, store or initialize at `index`, k_no_block if it is not known.
+
+    [[nodiscard]] constexpr auto variable_of(
+        const basic_block::instructions_type& body,
+        std::size_t                           index
+    ) const -> std::size_t
+    {
+        // The identifier is on top of the stack, except for initialize where the value is above it.
+
+        const auto depth = operand(body[index]) == opcode::initialize ? std::size_t{1} : std::size_t{0};
+        const auto id    = producer(body, index, depth);
+
+        if ( id == k_no_block || operand(body[id]) != opcode::constant_identifier )
+        {
+            return k_no_block;
+        }
+
+        return index_of(m_numbers[immediate(body[id])].m_hash);
+    }
+
+    std::span<const acme::number_constant> m_numbers{};
+    acme::dynamic_cvector<acme::identifier> m_ids{};
+};
+
+// Start of the expression that computes the value on top of the stack after `last`.
+// Returns k_no_block if the expression does not start in the same block.
+
+[[nodiscard]] constexpr auto expression_begin(
+    const basic_block::instructions_type& body,
+    std::size_t                           last
+) -> std::size_t
+{
+    auto needed = std::ptrdiff_t{1};
+
+    for ( auto i = last + 1; i > 0; i-- )
+    {
+        const auto effect = stack_effect_of(body[i - 1]);
+
+        needed += effect.m_pops - effect.m_pushes;
+
+        if ( needed == 0 )
+        {
+            return i - 1;
+        }
+
+        if ( needed < 0 )
+        {
+            return k_no_block;
+        }
+    }
+
+    return k_no_block;
+}
+
+// Blocks reachable from the entry block.
+
+[[nodiscard]] constexpr auto reachable_blocks(const control_flow_graph& graph) -> bit_set
+{
+    auto reachable = bit_set(graph.m_blocks.size());
+    auto worklist  = acme::dynamic_cvector<std::size_t>{};
+
+    if ( graph.m_layout.empty() == false )
+    {
+        reachable.set(graph.m_layout[0]);
+        worklist.push_back(graph.m_layout[0]);
+    }
+
+    while ( worklist.empty() == false )
+    {
+        const auto b = worklist.back();
+        worklist.pop_back();
+
+        for ( const auto s : graph.successors(b) )
+        {
+            if ( s != k_no_block && reachable.test(s) == false )
+            {
+                reachable.set(s);
+                worklist.push_back(s);
+            }
+        }
+    }
+
+    return reachable;
+}
+
+// Number of stack frames on entry to each block. Structured code enters a block with the same depth on every path.
+
+constexpr void compute_scope_depths(control_flow_graph& graph)
+{
+    auto visited  = bit_set(graph.m_blocks.size());
+    auto worklist = acme::dynamic_cvector<std::size_t>{};
+
+    if ( graph.m_layout.empty() )
+    {
+        return;
+    }
+
+    graph.m_blocks[graph.m_layout[0]].m_scope_depth = 1;
+    visited.set(graph.m_layout[0]);
+    worklist.push_back(graph.m_layout[0]);
+
+    while ( worklist.empty() == false )
+    {
+        const auto b = worklist.back();
+        worklist.pop_back();
+
+        auto depth = graph.m_blocks[b].m_scope_depth;
+
+        for ( const auto ins : graph.m_blocks[b].m_instructions )
+        {
+            if ( operand(ins) == opcode::push_stack_frame )
+            {
+                depth++;
+            }
+
+            else if ( operand(ins) == opcode::pop_stack_frame )
+            {
+                depth -= static_cast<std::int32_t>(immediate(ins));
+            }
+        }
+
+        for ( const auto s : graph.successors(b) )
+        {
+            if ( s != k_no_block && visited.test(s) == false )
+            {
+                graph.m_blocks[s].m_scope_depth = depth;
+                visited.set(s);
+                worklist.push_back(s);
+            }
+        }
+    }
+}
+
+// Variables live on entry to and exit from each block. Every variable is live at the end of
+// the script since the caller can read it, and stack frame operations make every variable
+// live since a name may refer to another declaration on the other side of them.
+
+struct liveness
+{
+    constexpr liveness(
+        const control_flow_graph& graph,
+        const variable_table&     variables
+    )
+        : m_live_in(graph.m_blocks.size())
+        , m_live_out(graph.m_blocks.size())
+    {
+        const auto count = variables.size();
+
+        for ( std::size_t b{}; b < graph.m_blocks.size(); b++ )
+        {
+            m_live_in[b]  = bit_set(count);
+            m_live_out[b] = bit_set(count);
+        }
+
+        for ( auto changed = true; changed; )
+        {
+            changed = false;
+
+            for ( auto i = graph.m_layout.size(); i > 0; i-- )
+            {
+                const auto b = graph.m_layout[i - 1];
+
+                const auto& block = graph.m_blocks[b];
+
+                auto out = bit_set(count);
+
+                for ( const auto s : graph.successors(b) )
+                {
+                    if ( s != k_no_block )
+                    {
+                        out |= m_live_in[s];
+                    }
+                }
+
+                // Blocks that leave the script.
+
+                if ( (block.m_terminator != opcode::jump_to && block.m_next == k_no_block) || (block.m_terminator != opcode::no_opearation && block.m_target == k_no_block) )
+                {
+                    out.set_all();
+                }
+
+                auto in = out;
+                transfer(block.m_instructions, variables, in);
+
+                if ( (in == m_live_in[b]) == false || (out == m_live_out[b]) == false )
+                {
+                    m_live_in[b]  = std::move(in);
+                    m_live_out[b] = std::move(out);
+                    changed       = true;
+                }
+            }
+        }
+    }
+
+    // Apply one instruction to the set of variables live after it.
+
+    static constexpr void step(
+        const basic_block::instructions_type& body,
+        std::size_t                           index,
+        const variable_table&                 variables,
+        bit_set&                              live
+    )
+    {
+        const auto op = operand(body[index]);
+
+        if ( detail::is_frame_operation(op) )
+        {
+            live.set_all();
+        }
+
+        else if ( detail::is_variable_access(op) )
+        {
+            const auto v = variables.variable_of(body, index);
+
+            if ( op == opcode::store_var )
+            {
+                if ( v != k_no_block )
+                {
+                    live.reset(v);
+                }
+            }
+
+            else if ( v != k_no_block )
+            {
+                live.set(v);
+            }
+
+            else
+            {
+                live.set_all();
+            }
+        }
+    }
+
+    static constexpr void transfer(
+        const basic_block::instructions_type& body,
+        const variable_table&                 variables,
+        bit_set&                              live
+    )
+    {
+        for ( auto i = body.size(); i > 0; i-- )
+        {
+            step(body, i - 1, variables, live);
+        }
+    }
+
+    acme::dynamic_cvector<bit_set> m_live_in{};
+    acme::dynamic_cvector<bit_set> m_live_out{};
+};
+
+// Variables that are declared in the frame of the script on every path to the start of each block.
+// A store to such a variable is never dropped for a missing declaration.
+
+[[nodiscard]] constexpr auto declared_variables(
+    const control_flow_graph& graph,
+    const variable_table&     variables
+) -> acme::dynamic_cvector<bit_set>
+{
+    const auto count = variables.size();
+    const auto preds = graph.predecessors();
+
+    auto declared_in  = acme::dynamic_cvector<bit_set>(graph.m_blocks.size());
+    auto declared_out = acme::dynamic_cvector<bit_set>(graph.m_blocks.size());
+
+    for ( std::size_t b{}; b < graph.m_blocks.size(); b++ )
+    {
+        declared_in[b]  = bit_set(count, true);
+        declared_out[b] = bit_set(count, true);
+    }
+
+    const auto transfer = [&](std::size_t b, bit_set declared)
+    {
+        const auto& block = graph.m_blocks[b];
+        auto        depth = block.m_scope_depth;
+
+        for ( std::size_t i{}; i < block.m_instructions.size(); i++ )
+        {
+            const auto ins = block.m_instructions[i];
+
+            if ( operand(ins) == opcode::push_stack_frame )
+            {
+                depth++;
+            }
+
+            else if ( operand(ins) == opcode::pop_stack_frame )
+            {
+                depth -= static_cast<std::int32_t>(immediate(ins));
+            }
+
+            else if ( operand(ins) == opcode::initialize && depth == 1 )
+            {
+                if ( const auto v = variables.variable_of(block.m_instructions, i); v != k_no_block )
+                {
+                    declared.set(v);
+                }
+            }
+        }
+
+        return declared;
+    };
+
+    for ( auto changed = true; changed; )
+    {
+        changed = false;
+
+        for ( std::size_t i{}; i < graph.m_layout.size(); i++ )
+        {
+            const auto b = graph.m_layout[i];
+
+            auto in = i == 0 ? bit_set(count) : bit_set(count, true);
+
+            for ( const auto p : preds[b] )
+            {
+                in &= declared_out[p];
+            }
+
+            auto out = transfer(b, in);
+
+            if ( (in == declared_in[b]) == false || (out == declared_out[b]) == false )
+            {
+                declared_in[b]  = std::move(in);
+                declared_out[b] = std::move(out);
+                changed         = true;
+            }
+        }
+    }
+
+    return declared_in;
+}
+
+// Natural loop of a back edge: the header and the blocks that reach the edge without passing through the header.
+
+struct natural_loop
+{
+    std::size_t m_header{};
+    bit_set     m_blocks{};
+    std::size_t m_size{};
+};
+
+[[nodiscard]] constexpr auto find_loops(const control_flow_graph& graph) -> acme::dynamic_cvector<natural_loop>
+{
+    const auto count = graph.m_blocks.size();
+    const auto preds = graph.predecessors();
+
+    // Dominators: dom(entry) = {entry}, dom(b) = {b} + intersection of dom(p) over the predecessors.
+
+    auto dominators = acme::dynamic_cvector<bit_set>(count);
+
+    for ( std::size_t i{}; i < graph.m_layout.size(); i++ )
+    {
+        dominators[graph.m_layout[i]] = bit_set(count, i != 0);
+    }
+
+    if ( graph.m_layout.empty() == false )
+    {
+        dominators[graph.m_layout[0]].set(graph.m_layout[0]);
+    }
+
+    for ( auto changed = true; changed; )
+    {
+        changed = false;
+
+        for ( std::size_t i{1}; i < graph.m_layout.size(); i++ )
+        {
+            const auto b = graph.m_layout[i];
+
+            auto dom = bit_set(count, true);
+
+            for ( const auto p : preds[b] )
+            {
+                dom &= dominators[p];
+            }
+
+            dom.set(b);
+
+            if ( (dom == dominators[b]) == false )
+            {
+                dominators[b] = std::move(dom);
+                changed       = true;
+            }
+        }
+    }
+
+    auto loops = acme::dynamic_cvector<natural_loop>{};
+
+    for ( const auto b : graph.m_layout )
+    {
+        for ( const auto header : graph.successors(b) )
+        {
+            if ( header == k_no_block || dominators[b].test(header) == false )
+            {
+                continue;
+            }
+
+            // Loops with the same header are merged.
+
+            auto it = std::find_if(loops.begin(), loops.end(), [&](const auto& l) { return l.m_header == header; });
+
+            if ( it == loops.end() )
+            {
+                loops.push_back(natural_loop{ .m_header = header, .m_blocks = bit_set(count), .m_size = 0 });
+                it = loops.end() - 1;
+                it->m_blocks.set(header);
+            }
+
+            auto worklist = acme::dynamic_cvector<std::size_t>{};
+
+            if ( it->m_blocks.test(b) == false )
+            {
+                it->m_blocks.set(b);
+                worklist.push_back(b);
+            }
+
+            while ( worklist.empty() == false )
+            {
+                const auto n = worklist.back();
+                worklist.pop_back();
+
+                for ( const auto p : preds[n] )
+                {
+                    if ( it->m_blocks.test(p) == false )
+                    {
+                        it->m_blocks.set(p);
+                        worklist.push_back(p);
+                    }
+                }
+            }
+        }
+    }
+
+    for ( auto& l : loops )
+    {
+        l.m_size = 0;
+
+        for ( const auto b : graph.m_layout )
+        {
+            l.m_size += l.m_blocks.test(b) ? 1 : 0;
+        }
+    }
+
+    return loops;
+}
+
+// Exact maximum operand stack depth of the graph.
+
+[[nodiscard]] constexpr auto max_stack_depth(const control_flow_graph& graph) -> std::size_t
+{
+    auto entry     = acme::dynamic_cvector<std::ptrdiff_t>(graph.m_blocks.size());
+    auto visited   = bit_set(graph.m_blocks.size());
+    auto worklist  = acme::dynamic_cvector<std::size_t>{};
+    auto max_depth = std::ptrdiff_t{};
+
+    if ( graph.m_layout.empty() )
+    {
+        return 0;
+    }
+
+    visited.set(graph.m_layout[0]);
+    worklist.push_back(graph.m_layout[0]);
+
+    while ( worklist.empty() == false )
+    {
+        const auto b = worklist.back();
+        worklist.pop_back();
+
+        auto depth = entry[b];
+
+        for ( const auto ins : graph.m_blocks[b].m_instructions )
+        {
+            const auto effect = stack_effect_of(ins);
+
+            depth     = std::max<std::ptrdiff_t>(depth - effect.m_pops, 0) + effect.m_pushes;
+            max_depth = std::max(max_depth, depth);
+        }
+
+        if ( graph.m_blocks[b].is_conditional() )
+        {
+            depth = std::max<std::ptrdiff_t>(depth - 1, 0);
+        }
+
+        for ( const auto s : graph.successors(b) )
+        {
+            if ( s != k_no_block && visited.test(s) == false )
+            {
+                entry[s] = depth;
+                visited.set(s);
+                worklist.push_back(s);
+            }
+        }
+    }
+
+    return static_cast<std::size_t>(max_depth);
+}
+
+} // namespace acme::opt
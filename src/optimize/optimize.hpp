@@ -0,0 +1,86 @@
+#pragma once
+
+#include "control_flow_graph.hpp"
+#include "dataflow.hpp"
+#include "passes.hpp"
+
+namespace acme::opt {
+
+enum class optimize_level : std::uint8_t
+{
+    k_O0 = 0u,
+    k_O1,
+    k_O2,
+};
+
+struct optimize_stats
+{
+    std::size_t m_instructions_before{};
+    std::size_t m_instructions_after{};
+    std::size_t m_blocks{};
+    std::size_t m_threaded_jumps{};
+    std::size_t m_unreachable_instructions{};
+    std::size_t m_dead_stores{};
+    std::size_t m_redundant_loads{};
+    std::size_t m_forwarded_stores{};
+    std::size_t m_copies{};
+    std::size_t m_hoisted_expressions{};
+};
+
+/* Optimize the bytecode emitted into the context. The instructions are split into basic
+   blocks, transformed and laid out again with the jump targets fixed up.
+
+    -O0: The bytecode is left as emitted.
+    -O1: Jump threading and removal of unreachable blocks.
+    -O2: -O1, redundant load elimination, copy propagation, dead store elimination
+         and loop-invariant code motion.
+
+    Variables remain observable after the script has run, so only stores that are
+    overwritten before the end of the script are considered dead.
+*/
+
+constexpr auto optimize(
+    emit_context&  context,
+    optimize_level level
+) -> optimize_stats
+{
+    auto stats = optimize_stats{};
+
+    stats.m_instructions_before = context.instructions().size();
+    stats.m_instructions_after  = stats.m_instructions_before;
+
+    if ( level == optimize_level::k_O0 )
+    {
+        return stats;
+    }
+
+    auto graph = build_control_flow_graph(context.instructions());
+
+    stats.m_blocks                   = graph.m_blocks.size();
+    stats.m_threaded_jumps           = thread_jumps(graph);
+    stats.m_unreachable_instructions = remove_unreachable_blocks(graph);
+
+    if ( level == optimize_level::k_O2 )
+    {
+        compute_scope_depths(graph);
+
+        const auto variables = variable_table{graph, context.number_constants()};
+        const auto values    = propagate_local_values(graph, variables, context.number_constants());
+
+        stats.m_redundant_loads     = values.m_redundant_loads;
+        stats.m_forwarded_stores    = values.m_forwarded_stores;
+        stats.m_copies              = values.m_copies;
+        stats.m_dead_stores         = remove_dead_stores(graph, variables);
+        stats.m_hoisted_expressions = hoist_loop_invariants(graph, context);
+    }
+
+    const auto max_depth = opt::max_stack_depth(graph);
+
+    context.assign_instructions(emit_control_flow_graph(graph), max_depth);
+
+    stats.m_instructions_after = context.instructions().size();
+
+    return stats;
+}
+
+} // namespace acme::opt
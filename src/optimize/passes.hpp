@@ -0,0 +1,600 @@
+#pragma once
+
+namespace acme::opt {
+
+namespace detail {
+
+[[nodiscard]] constexpr auto is_operator(opcode op) noexcept -> bool
+{
+    const auto effect = stack_effect_of(op);
+
+    return effect.m_pops > 0 && effect.m_pushes == 1 && is_pure(op) && generic_opcode(op) != opcode::load_var;
+}
+
+[[nodiscard]] constexpr auto is_load(
+    const basic_block::instructions_type& body,
+    std::size_t                           i
+) -> bool
+{
+    return i + 1 < body.size() && operand(body[i]) == opcode::constant_identifier && operand(body[i + 1]) == opcode::load_var;
+}
+
+[[nodiscard]] constexpr auto is_store(
+    const basic_block::instructions_type& body,
+    std::size_t                           i
+) -> bool
+{
+    return i + 1 < body.size() && operand(body[i]) == opcode::constant_identifier && operand(body[i + 1]) == opcode::store_var;
+}
+
+} // namespace detail
+
+// Jump threading: jumps and fall-through edges into empty blocks that only jump
+// elsewhere are redirected to the final target. Returns the number of redirected edges.
+
+constexpr auto thread_jumps(control_flow_graph& graph) -> std::size_t
+{
+    const auto forward = [&](std::size_t b)
+    {
+        for ( std::size_t steps{}; b != k_no_block && steps < graph.m_blocks.size(); steps++ )
+        {
+            const auto& block = graph.m_blocks[b];
+
+            if ( block.m_instructions.empty() == false )
+            {
+                break;
+            }
+
+            if ( block.m_terminator == opcode::jump_to )
+            {
+                b = block.m_target;
+            }
+
+            else if ( block.m_terminator == opcode::no_opearation && block.m_next != k_no_block )
+            {
+                b = block.m_next;
+            }
+
+            else
+            {
+                break;
+            }
+        }
+
+        return b;
+    };
+
+    auto count = std::size_t{};
+
+    for ( const auto b : graph.m_layout )
+    {
+        auto& block = graph.m_blocks[b];
+
+        if ( block.m_terminator != opcode::no_opearation )
+        {
+            if ( const auto target = forward(block.m_target); target != block.m_target )
+            {
+                block.m_target = target;
+                count++;
+            }
+        }
+
+        if ( block.falls_through() )
+        {
+            if ( const auto next = forward(block.m_next); next != block.m_next )
+            {
+                block.m_next = next;
+                count++;
+            }
+        }
+    }
+
+    return count;
+}
+
+// Dead code elimination of unreachable blocks. Returns the number of removed instructions.
+
+constexpr auto remove_unreachable_blocks(control_flow_graph& graph) -> std::size_t
+{
+    const auto reachable = reachable_blocks(graph);
+    const auto before    = graph.instruction_count();
+
+    auto layout = control_flow_graph::layout_type{};
+
+    for ( const auto b : graph.m_layout )
+    {
+        if ( reachable.test(b) )
+        {
+            layout.push_back(b);
+        }
+    }
+
+    graph.m_layout = std::move(layout);
+
+    return before - graph.instruction_count();
+}
+
+// Dead store elimination: a store to a variable that is not live after it is removed
+// together with the expression computing the stored value. Returns the number of removed stores.
+
+constexpr auto remove_dead_stores(
+    control_flow_graph&   graph,
+    const variable_table& variables
+) -> std::size_t
+{
+    const auto live_variables = liveness{graph, variables};
+
+    auto count = std::size_t{};
+
+    for ( const auto b : graph.m_layout )
+    {
+        auto& body    = graph.m_blocks[b].m_instructions;
+        auto  live    = live_variables.m_live_out[b];
+        auto  removed = bit_set(body.size());
+        auto  changed = false;
+
+        for ( auto i = body.size(); i > 0; i-- )
+        {
+            const auto index = i - 1;
+
+            if ( removed.test(index) )
+            {
+                continue;
+            }
+
+            if ( operand(body[index]) == opcode::store_var && index > 0 && operand(body[index - 1]) == opcode::constant_identifier )
+            {
+                const auto v     = variables.variable_of(body, index);
+                const auto first = index > 1 ? expression_begin(body, index - 2) : k_no_block;
+
+                const auto removable = v != k_no_block && live.test(v) == false && first != k_no_block && std::all_of(body.begin() + first, body.begin() + index - 1, [](const auto& ins)
+                {
+                    return detail::is_pure(operand(ins));
+                });
+
+                if ( removable )
+                {
+                    for ( auto r = first; r <= index; r++ )
+                    {
+                        removed.set(r);
+                    }
+
+                    count++;
+                    changed = true;
+                    continue;
+                }
+            }
+
+            liveness::step(body, index, variables, live);
+        }
+
+        if ( changed )
+        {
+            auto kept = basic_block::instructions_type{};
+
+            for ( std::size_t i{}; i < body.size(); i++ )
+            {
+                if ( removed.test(i) == false )
+                {
+                    kept.push_back(body[i]);
+                }
+            }
+
+            body = std::move(kept);
+        }
+    }
+
+    return count;
+}
+
+// Statistics of the local value passes.
+
+struct local_value_stats
+{
+    std::size_t m_redundant_loads{};
+    std::size_t m_forwarded_stores{};
+    std::size_t m_copies{};
+};
+
+// Block local redundant load elimination and copy propagation:
+//
+//  - A load of the variable whose value is already on top of the stack is replaced by duplicate_top.
+//  - A store immediately followed by a load of the same variable keeps a copy of the stored value.
+//  - After `y = x` loads of y read x instead, until either variable is written.
+//
+// A store to a variable that is not declared has no effect, so stores are only forwarded
+// for variables declared in the frame of the script on every path.
+
+constexpr auto propagate_local_values(
+    control_flow_graph&                      graph,
+    const variable_table&                    variables,
+    std::span<const acme::number_constant>   numbers
+) -> local_value_stats
+{
+    const auto declared = declared_variables(graph, variables);
+
+    auto stats = local_value_stats{};
+
+    // Copy of a variable: loads of m_variable read m_source through the identifier constant m_constant.
+
+    struct copy
+    {
+        std::size_t                       m_variable{};
+        std::size_t                       m_source{};
+        acme::instruction::immediate_type m_constant{};
+    };
+
+    const auto variable_at = [&](const basic_block::instructions_type& body, std::size_t i)
+    {
+        return variables.index_of(numbers[immediate(body[i])].m_hash);
+    };
+
+    for ( const auto b : graph.m_layout )
+    {
+        const auto& body        = graph.m_blocks[b].m_instructions;
+        const auto& is_declared = declared[b];
+
+        auto out    = basic_block::instructions_type{};
+        auto copies = acme::dynamic_cvector<copy>{};
+        auto top    = k_no_block; // Variable whose value is on top of the stack.
+
+        const auto invalidate = [&](std::size_t v)
+        {
+            auto kept = acme::dynamic_cvector<copy>{};
+
+            for ( const auto& c : copies )
+            {
+                if ( c.m_variable != v && c.m_source != v )
+                {
+                    kept.push_back(c);
+                }
+            }
+
+            copies = std::move(kept);
+        };
+
+        for ( std::size_t i{}; i < body.size(); )
+        {
+            const auto op = operand(body[i]);
+
+            // Load, possibly through a copy.
+
+            if ( detail::is_load(body, i) )
+            {
+                auto       id = body[i];
+                const auto v  = variable_at(body, i);
+
+                auto source = v;
+
+                for ( const auto& c : copies )
+                {
+                    if ( c.m_variable == v )
+                    {
+                        id     = acme::instruction::make(opcode::constant_identifier, c.m_constant);
+                        source = c.m_source;
+                        stats.m_copies++;
+                    }
+                }
+
+                if ( source != k_no_block && source == top )
+                {
+                    out.push_back(acme::instruction::make(opcode::duplicate_top, 0u));
+                    stats.m_redundant_loads++;
+                }
+
+                else
+                {
+                    out.push_back(id);
+                    out.push_back(body[i + 1]);
+                }
+
+                top = source;
+                i  += 2;
+                continue;
+            }
+
+            // Store followed by a load of the same variable.
+
+            if ( detail::is_store(body, i) )
+            {
+                const auto v = variable_at(body, i);
+
+                invalidate(v);
+
+                if ( v != k_no_block && is_declared.test(v) && detail::is_load(body, i + 2) && variable_at(body, i + 2) == v )
+                {
+                    out.push_back(acme::instruction::make(opcode::duplicate_top, 0u));
+                    out.push_back(body[i]);
+                    out.push_back(body[i + 1]);
+
+                    stats.m_forwarded_stores++;
+
+                    top = v;
+                    i  += 4;
+                    continue;
+                }
+
+                // y = x where x was just loaded.
+
+                if ( v != k_no_block && is_declared.test(v) && out.size() >= 2 && operand(out.back()) == opcode::load_var && operand(out[out.size() - 2]) == opcode::constant_identifier )
+                {
+                    const auto source = variable_at(out, out.size() - 2);
+
+                    if ( source != v && source != k_no_block )
+                    {
+                        copies.push_back(copy{ .m_variable = v, .m_source = source, .m_constant = immediate(out[out.size() - 2]) });
+                    }
+                }
+
+                out.push_back(body[i]);
+                out.push_back(body[i + 1]);
+
+                top = k_no_block;
+                i  += 2;
+                continue;
+            }
+
+            // Declaration of y initialized with x.
+
+            if ( op == opcode::initialize )
+            {
+                const auto v = variables.variable_of(body, i);
+
+                if ( v == k_no_block )
+                {
+                    copies.clear();
+                }
+
+                else
+                {
+                    invalidate(v);
+
+                    const auto n = out.size();
+
+                    if ( n >= 3 && operand(out[n - 1]) == opcode::load_var && operand(out[n - 2]) == opcode::constant_identifier && operand(out[n - 3]) == opcode::constant_identifier )
+                    {
+                        if ( const auto source = variable_at(out, n - 2); source != v && source != k_no_block )
+                        {
+                            copies.push_back(copy{ .m_variable = v, .m_source = source, .m_constant = immediate(out[n - 2]) });
+                        }
+                    }
+                }
+            }
+
+            else if ( op == opcode::store_var || detail::is_frame_operation(op) )
+            {
+                copies.clear();
+            }
+
+            out.push_back(body[i]);
+
+            top = k_no_block;
+            i  += 1;
+        }
+
+        graph.m_blocks[b].m_instructions = std::move(out);
+    }
+
+    return stats;
+}
+
+// Loop-invariant code motion. Expressions in a loop that only read constants and variables that
+// are not written in the loop are computed once in a preheader block into a hidden variable.
+// The hidden variables are named "@licm<n>", which is not a valid identifier in a script.
+
+constexpr auto hoist_loop_invariants(
+    control_flow_graph& graph,
+    emit_context&       context
+) -> std::size_t
+{
+    // Replacing an expression with a load of the hidden variable takes two instructions.
+
+    constexpr auto k_min_expression_length = std::size_t{4};
+
+    auto loops = find_loops(graph);
+    auto count = std::size_t{};
+
+    // Outer loops first, an expression invariant in the outer loop is invariant in the inner loops too.
+
+    std::sort(loops.begin(), loops.end(), [](const auto& a, const auto& b) { return a.m_size > b.m_size; });
+
+    for ( const auto& loop : loops )
+    {
+        // Blocks added for the preheaders of other loops are not part of the loop.
+
+        const auto in_loop = [&](std::size_t b)
+        {
+            return b < loop.m_blocks.m_count && loop.m_blocks.test(b);
+        };
+
+        const auto variables = variable_table{graph, context.number_constants()};
+
+        auto written = bit_set(variables.size());
+        auto unknown = false;
+
+        for ( const auto b : graph.m_layout )
+        {
+            if ( in_loop(b) == false )
+            {
+                continue;
+            }
+
+            const auto& body = graph.m_blocks[b].m_instructions;
+
+            for ( std::size_t i{}; i < body.size(); i++ )
+            {
+                if ( operand(body[i]) == opcode::store_var || operand(body[i]) == opcode::initialize )
+                {
+                    const auto v = variables.variable_of(body, i);
+
+                    unknown = unknown || v == k_no_block;
+
+                    if ( v != k_no_block )
+                    {
+                        written.set(v);
+                    }
+                }
+            }
+        }
+
+        if ( unknown )
+        {
+            continue;
+        }
+
+        const auto is_invariant = [&](const basic_block::instructions_type& body, std::size_t first, std::size_t last)
+        {
+            const auto numbers = context.number_constants();
+
+            for ( auto i = first; i <= last; i++ )
+            {
+                const auto op = operand(body[i]);
+
+                if ( op == opcode::constant_identifier )
+                {
+                    const auto v = variables.index_of(numbers[immediate(body[i])].m_hash);
+
+                    if ( i == last || operand(body[i + 1]) != opcode::load_var || v == k_no_block || written.test(v) )
+                    {
+                        return false;
+                    }
+                }
+
+                else if ( op == opcode::duplicate_top || detail::is_pure(op) == false )
+                {
+                    return false;
+                }
+            }
+
+            return true;
+        };
+
+        auto preheader = basic_block{};
+
+        for ( const auto b : graph.m_layout )
+        {
+            if ( in_loop(b) == false )
+            {
+                continue;
+            }
+
+            auto& body = graph.m_blocks[b].m_instructions;
+
+            for ( auto k = body.size(); k > 0; k-- )
+            {
+                const auto last = k - 1;
+
+                if ( detail::is_operator(operand(body[last])) == false )
+                {
+                    continue;
+                }
+
+                const auto first = expression_begin(body, last);
+
+                if ( first == k_no_block || last - first + 1 < k_min_expression_length || is_invariant(body, first, last) == false )
+                {
+                    continue;
+                }
+
+                // Hidden variable for the value.
+
+                char name[16]{'@', 'l', 'i', 'c', 'm'};
+                auto length = std::size_t{5};
+
+                for ( auto n = context.number_constants().size(); ; n /= 10 )
+                {
+                    name[length++] = static_cast<char>('0' + n % 10);
+
+                    if ( n < 10 )
+                    {
+                        break;
+                    }
+                }
+
+                const auto id = static_cast<acme::instruction::immediate_type>(context.add_number_constant(acme::number_constant{ .m_hash = context.symbol_id(context.symbol(std::string_view{name, length})) }));
+
+                preheader.m_instructions.push_back(acme::instruction::make(opcode::constant_identifier, id));
+
+                for ( auto i = first; i <= last; i++ )
+                {
+                    preheader.m_instructions.push_back(body[i]);
+                }
+
+                preheader.m_instructions.push_back(acme::instruction::make(opcode::initialize, 0u));
+
+                auto rewritten = basic_block::instructions_type{};
+
+                for ( std::size_t i{}; i < body.size(); i++ )
+                {
+                    if ( i == first )
+                    {
+                        rewritten.push_back(acme::instruction::make(opcode::constant_identifier, id));
+                        rewritten.push_back(acme::instruction::make(opcode::load_var, 0u));
+                    }
+
+                    if ( i < first || i > last )
+                    {
+                        rewritten.push_back(body[i]);
+                    }
+                }
+
+                body = std::move(rewritten);
+                k    = first + 1;
+                count++;
+            }
+        }
+
+        if ( preheader.m_instructions.empty() )
+        {
+            continue;
+        }
+
+        // The preheader is laid out right before the header, edges entering the loop go through it.
+
+        const auto header = loop.m_header;
+        const auto index  = graph.m_blocks.size();
+
+        preheader.m_next        = header;
+        preheader.m_scope_depth = graph.m_blocks[header].m_scope_depth;
+
+        for ( const auto b : graph.m_layout )
+        {
+            if ( in_loop(b) )
+            {
+                continue;
+            }
+
+            auto& block = graph.m_blocks[b];
+
+            if ( block.m_terminator != opcode::no_opearation && block.m_target == header )
+            {
+                block.m_target = index;
+            }
+
+            if ( block.falls_through() && block.m_next == header )
+            {
+                block.m_next = index;
+            }
+        }
+
+        graph.m_blocks.push_back(std::move(preheader));
+
+        auto layout = control_flow_graph::layout_type{};
+
+        for ( const auto b : graph.m_layout )
+        {
+            if ( b == header )
+            {
+                layout.push_back(index);
+            }
+
+            layout.push_back(b);
+        }
+
+        graph.m_layout = std::move(layout);
+    }
+
+    return count;
+}
+
+} // namespace acme::opt
@@ -81,43 +81,41 @@ template <auto k_level>
     }
 }
 
-} // namespace
-
-// UnaryExpression ::
-//  ('!' | '~'| '-'| '+'| '--'| '++' | 'typeof' | 'void' | 'delete' )
+// Binding power of the binary operators by token type, from the levels of predecense_table:
+// the tighter a level binds the higher its power. Zero for tokens that are not binary operators.
 
-constexpr auto parser::parse(state::unary_expression) -> ast::UniqueAstNode
+constexpr auto k_binding_power = []()
 {
-    // Accepted token types for an unary expression.
+    auto table = std::array<std::uint8_t, static_cast<std::size_t>(token_type::tok_yield) + 1u>{};
 
-    /* static */ constexpr auto k_expected = std::array
+    const auto level = [&](const auto& tokens, std::uint8_t power)
     {
-        token_type::tok_delete,
-        token_type::tok_void,
-        token_type::tok_typeof,
-        token_type::tok_increment,
-        token_type::tok_decrement,
+        for ( const auto t : tokens )
+        {
+            table[static_cast<std::size_t>(t)] = power;
+        }
+    };
 
-        token_type::tok_plus,
-        token_type::tok_minus,
+    level(predecense_table<4>(), 1u);
+    level(predecense_table<3>(), 2u);
+    level(predecense_table<2>(), 3u);
+    level(predecense_table<1>(), 4u);
+    level(predecense_table<0>(), 5u);
 
-        token_type::tok_bitwise_not,
-        token_type::tok_logical_not
-    };
+    return table;
+}();
 
-    const auto op_type = current_token();
+constexpr std::uint8_t k_max_binding_power = 5u;
 
-    if ( expect_one_of(k_expected, false, true) == true )
-    {
-        if ( auto right = transition(state::unary_expression{}); right.get() != nullptr )
-        {
-            return ast::UnaryExpression::make(context(), std::move(right), op_type.type(), position());
-        }
-    }
+[[nodiscard]] constexpr auto binding_power(token_type t) noexcept -> std::uint8_t
+{
+    const auto i = static_cast<std::size_t>(t);
 
-    return transition(state::postfix_expression{});
+    return i < k_binding_power.size() ? k_binding_power[i] : std::uint8_t{};
 }
 
+} // namespace
+
 // MultiplicativeExpression ::
 //  <UnaryExpression>
 //
@@ -316,76 +314,680 @@ constexpr auto parser::parse(state::logical_expression) -> ast::UniqueAstNode
     return left;
 }
 
-// <TernaryExpression> ::
-//  <Expression> '?' <Expression> ':' <Expression>
 
-constexpr auto parser::parse(state::ternary_expression, ast::UniqueAstNode condition) -> ast::UniqueAstNode
+// Expression ::
+//  <BinaryExpression>
+//  <BinaryExpression> '?' <Expression> ':' <Expression>
+//  <BinaryExpression> <AssignmentOperator> <Expression>
+//
+// BinaryExpression ::
+//  <UnaryExpression> (<BinaryOperator> <UnaryExpression>)*
+//
+// UnaryExpression ::
+//  ('!' | '~'| '-'| '+'| '--'| '++' | 'typeof' | 'void' | 'delete')* <PostfixExpression>
+//
+// PostfixExpression ::
+//  <MemberExpression> ('++' | '--')?
+//
+// MemberExpression ::
+//  (<NewExpression> | <PrimaryExpression>) ('.' <Identifier> | '(' <Arguments> ')')*
+//
+// The expressions are parsed in one loop, and what waits for a nested expression is a frame
+// on the heap instead of a call on the stack: the nesting depth is limited by the memory only,
+// and the memory used is in proportion to the depth. The frame of an expression waits for its
+// value, a group, argument, property, element, consequent, alternate or right hand side of an
+// assignment. The frames of the operators above it wait for their operands.
+//
+// Binary operators are parsed by precedence: operands wait with the operator that follows them
+// until an operator that binds as loosely, or the end of the expression, completes them. The
+// operators of a level are left-associative, so there is at most one waiting operand per level.
+// An operator without a right operand ends its level there, only operators that bind more
+// loosely continue the expression.
+//
+// The trees, and the positions of their nodes, are the same as from a descent through a state
+// per grammar rule.
+
+constexpr auto parser::parse_expression(frame_kind entry) -> ast::UniqueAstNode
 {
-    if ( expect(token_type::tok_ternary, false, true) == false )
-    {
-        return condition;
-    }
+    using namespace std::string_view_literals;
 
-    // Parse left hand side expression.
+    /* static */ constexpr auto k_unary_operators = std::array
+    {
+        token_type::tok_delete,
+        token_type::tok_void,
+        token_type::tok_typeof,
+        token_type::tok_increment,
+        token_type::tok_decrement,
 
-    auto consequent = transition(state::expression{});
+        token_type::tok_plus,
+        token_type::tok_minus,
 
-    // Expect a colon ':'.
+        token_type::tok_bitwise_not,
+        token_type::tok_logical_not
+    };
 
-    if ( expect(token_type::tok_colon, true, true) == false )
+    /* static */ constexpr auto k_postfix_operators = std::array
     {
-        return {};
-    }
+        token_type::tok_increment,
+        token_type::tok_decrement,
+    };
 
-    // Parse right hand side expression.
+    /* static */ constexpr auto k_assignment_operators = predecense_table<5>();
 
-    auto alternate = transition(state::expression{});
+    enum class step
+    {
+        k_operand,          // Prefix operators of an operand.
+        k_primary,          // New or primary expression of an operand.
+        k_suffix,           // Member and call expressions on the value.
+        k_postfix,          // Postfix operator on the value.
+        k_operand_done,     // The value is an operand for the frame on top.
+        k_expression_done,  // The value is the binary expression of the frame on top.
+        k_value,            // The value is the value of the frame on top.
+        k_property,         // Next property of the object on top.
+        k_object_end,
+        k_element,          // Next element of the array on top.
+        k_array_end,
+    };
 
-    return ast::TernaryExpression::make(context(), position(), std::move(condition), std::move(consequent), std::move(alternate));
-}
+    [[maybe_unused]] const auto base = m_frames.size();
 
-constexpr auto parser::parse(state::expression) -> ast::UniqueAstNode
-{
-    // Parse left hand side expression.
+    m_frames.push_back(frame{ .m_kind = entry });
 
-    auto left = transition(state::logical_expression{});
+    const auto list_of = [](frame& f) -> ast::AstNodeList&
+    {
+        return f.m_right.get()->deref<ast::AstNodeList>();
+    };
 
-    // Check for a ternary expression '?'.
+    auto value = ast::UniqueAstNode{};
+    auto next  = step::k_operand;
 
-    if ( expect(token_type::tok_ternary, false, false) == true )
+    while ( true )
     {
-        return transition(state::ternary_expression{}, std::move(left));
-    }
+        switch ( next )
+        {
+            case step::k_operand:
+            {
+                const auto op = current_token().type();
+
+                if ( expect_one_of(k_unary_operators, false, true) == true )
+                {
+                    m_frames.push_back(frame{ .m_kind = frame_kind::k_unary, .m_op = op });
+                    break;
+                }
+
+                next = step::k_primary;
+                break;
+            }
+
+            case step::k_primary:
+            {
+                value = {};
+                next  = step::k_suffix;
+
+                // NewExpression ::
+                //  'new' '.' 'target'
+                //  'new' <Identifier> '(' <Arguments> ')'
+
+                if ( expect(token_type::tok_new, false, true) == true )
+                {
+                    // Check for "new.target" pseudo-property.
+
+                    const bool is_new_target = [&]()
+                    {
+                        if ( expect(token_type::tok_dot, false, true) == false )
+                        {
+                            return false;
+                        }
+
+                        if ( auto key = transition(state::literal_expression{}); ast::instanceof<ast::Identifier>(key) == true )
+                        {
+                            if ( key.get()->as<ast::Identifier>()->value() == "target"sv )
+                            {
+                                return true;
+                            }
+                        }
+
+                        return false;
+                    }();
+
+                    if ( is_new_target )
+                    {
+                        value = ast::MetaProperty::make(context(), position(), ast::MetaProperty::property_type::new_target);
+                        break;
+                    }
+
+                    // Check for "new import".
+
+                    else if ( expect(token_type::tok_import, false, true) == true )
+                    {
+                        /* TODO */
+                    }
+
+                    auto identifier = transition(state::literal_expression{});
+
+                    if ( ast::instanceof<ast::Identifier>(identifier) == false )
+                    {
+                        parser_syntax_error("Expected an identifier, instead of got '%s'."sv, ast::to_string(identifier));
+                        break;
+                    }
+
+                    if ( expect(token_type::tok_opening_parenthesis, false, true) == true )
+                    {
+                        m_frames.push_back(frame{ .m_left = std::move(identifier), .m_right = ast::AstNodeList::make(context(), position()), .m_kind = frame_kind::k_argument, .m_op = token_type::tok_new });
+
+                        next = step::k_operand;
+                        break;
+                    }
+                }
+
+                // PrimaryExpression ::
+                //  '(' <Expression> ')'
+                //  'this'
+                //  '{' <PropertyList> '}'
+                //  <FunctionExpression>
+                //  '[' <ElementList> ']'
+                //  <Literal>
+
+                if ( expect(token_type::tok_opening_parenthesis, false, true) == true )
+                {
+                    m_frames.push_back(frame{ .m_kind = frame_kind::k_group });
+
+                    next = step::k_operand;
+                }
+
+                else if ( expect(token_type::tok_this, false, false) == true )
+                {
+                    value = transition(state::this_expression{});
+                }
+
+                else if ( expect(token_type::tok_opening_bracket, false, true) == true )
+                {
+                    m_frames.push_back(frame{ .m_right = ast::AstNodeList::make(context(), position()), .m_kind = frame_kind::k_property });
+
+                    next = step::k_property;
+                }
+
+                else if ( expect(token_type::tok_function, false, false) == true )
+                {
+                    value = transition(state::function_expression{});
+                }
+
+                else if ( expect(token_type::tok_arrow_function, false, false) == true )
+                {
+                    value = transition(state::arrow_function_expression{});
+                }
+
+                else if ( expect(token_type::tok_opening_square_bracket, false, true) == true )
+                {
+                    m_frames.push_back(frame{ .m_right = ast::AstNodeList::make(context(), position()), .m_kind = frame_kind::k_element });
+
+                    next = step::k_element;
+                }
+
+                else if ( current_token().is_literal() )
+                {
+                    value = transition(state::literal_expression{});
+                }
+
+                break;
+            }
+
+            case step::k_suffix:
+            {
+                next = step::k_postfix;
+
+                // Member expression.
+
+                if ( expect(token_type::tok_dot, false, true) == true )
+                {
+                    auto property = transition(state::literal_expression{});
+
+                    if ( property.get() == nullptr )
+                    {
+                        parser_syntax_error("Expected a property name after '.'"sv);
+                        value = {};
+                    }
+
+                    else if ( ast::instanceof<ast::Identifier>(property) == false )
+                    {
+                        parser_syntax_error("Expected an identifier before '.'"sv);
+                        value = {};
+                    }
+
+                    else
+                    {
+                        value = ast::MemberExpression::make(context(), position(), std::move(value), std::move(property));
+                        next  = step::k_suffix;
+                    }
+                }
+
+                // Call expression.
+
+                else if ( expect(token_type::tok_opening_parenthesis, false, true) == true )
+                {
+                    m_frames.push_back(frame{ .m_left = std::move(value), .m_right = ast::AstNodeList::make(context(), position()), .m_kind = frame_kind::k_argument, .m_op = token_type::tok_opening_parenthesis });
+
+                    next = step::k_operand;
+                }
+
+                // TODO: Bracket expression.
+
+                break;
+            }
 
-    // Accepted token types for an assignment expression.
+            case step::k_postfix:
+            {
+                const auto op = current_token().type();
 
-    /* static */ constexpr auto k_expected = std::array
-    {
-        token_type::tok_assignment,
-        token_type::tok_assignment_plus,
-        token_type::tok_assignment_minus,
-        token_type::tok_assignment_multiply,
-        token_type::tok_assignment_exponential,
-        token_type::tok_assignment_divide,
-        token_type::tok_assignment_modulo,
-        token_type::tok_assignment_left_shift,
-        token_type::tok_assignment_right_shift,
-    };
+                // Rewrite postfix addition expression 'i++' as 'i += 1'
+                // and counterwise subtraction 'i--' as 'i -= 1'.
+
+                if ( expect_one_of(k_postfix_operators, false, true) == true )
+                {
+                    auto inc_by = op == token_type::tok_increment ? 1 : -1;
+                    auto right  = ast::Literal::make(context(), ast::Integer{inc_by}, position());
 
-    // Get current token.
+                    value = ast::BinaryExpression::make(context(), std::move(value), std::move(right), token_type::tok_assignment_plus, position());
+                }
 
-    const auto op_type = current_token();
+                next = step::k_operand_done;
+                break;
+            }
 
-    // Try parse an assignment expression.
+            case step::k_operand_done:
+            {
+                if ( m_frames.back().m_kind == frame_kind::k_unary )
+                {
+                    const auto op = m_frames.pop_back().m_op;
 
-    if ( expect_one_of(k_expected, false, true) == true )
-    {
-        auto right = transition(state::expression{});
+                    // A prefix operator without an operand is skipped, and the operand after it
+                    // is parsed without prefix operators.
+
+                    if ( value.get() != nullptr )
+                    {
+                        value = ast::UnaryExpression::make(context(), std::move(value), op, position());
+                    }
+
+                    else
+                    {
+                        next = step::k_primary;
+                    }
+
+                    break;
+                }
+
+                if ( m_frames.back().m_kind == frame_kind::k_unary_result )
+                {
+                    next = step::k_value;
+                    break;
+                }
+
+                // Operators bind if their power is below the limit.
+
+                auto limit = static_cast<std::uint8_t>(k_max_binding_power + 1u);
+
+                if ( m_frames.back().m_kind == frame_kind::k_pending )
+                {
+                    if ( value.get() != nullptr )
+                    {
+                        m_frames.back().m_kind = frame_kind::k_operand;
+                    }
+
+                    else
+                    {
+                        auto pending = m_frames.pop_back();
+
+                        value = std::move(pending.m_left);
+                        limit = pending.m_power;
+                    }
+                }
+
+                const auto complete = [&]()
+                {
+                    auto operand = m_frames.pop_back();
+
+                    value = ast::BinaryExpression::make(context(), std::move(operand.m_left), std::move(value), operand.m_op, position());
+                    limit = static_cast<std::uint8_t>(operand.m_power + 1u);
+                };
+
+                const auto op    = current_token().type();
+                const auto power = binding_power(op);
+
+                // Complete the operands of the operators that bind at least as tightly.
+
+                while ( m_frames.back().m_kind == frame_kind::k_operand && m_frames.back().m_power >= power )
+                {
+                    complete();
+                }
+
+                if ( power == 0u || power >= limit )
+                {
+                    while ( m_frames.back().m_kind == frame_kind::k_operand )
+                    {
+                        complete();
+                    }
+
+                    next = step::k_expression_done;
+                    break;
+                }
+
+                next_token();
+
+                m_frames.push_back(frame{ .m_left = std::move(value), .m_kind = frame_kind::k_pending, .m_op = op, .m_power = power });
+
+                next = step::k_operand;
+                break;
+            }
+
+            case step::k_expression_done:
+            {
+                next = step::k_value;
+
+                if ( m_frames.back().m_kind == frame_kind::k_binary_result )
+                {
+                    break;
+                }
+
+                // Ternary expression.
+
+                if ( expect(token_type::tok_ternary, false, true) == true )
+                {
+                    m_frames.push_back(frame{ .m_left = std::move(value), .m_kind = frame_kind::k_consequent });
+
+                    next = step::k_operand;
+                    break;
+                }
+
+                // Assignment expression.
+
+                const auto op = current_token().type();
+
+                if ( expect_one_of(k_assignment_operators, false, true) == true )
+                {
+                    m_frames.push_back(frame{ .m_left = std::move(value), .m_kind = frame_kind::k_assignment, .m_op = op });
+
+                    next = step::k_operand;
+                }
+
+                break;
+            }
+
+            case step::k_value:
+            {
+                auto f = m_frames.pop_back();
+
+                switch ( f.m_kind )
+                {
+                    case frame_kind::k_result:
+                    case frame_kind::k_binary_result:
+                    case frame_kind::k_unary_result:
+                    {
+                        if ( std::is_constant_evaluated() == false )
+                        {
+                            assert(m_frames.size() == base);
+                        }
+
+                        return value;
+                    }
+
+                    case frame_kind::k_group:
+                    {
+                        if ( expect(token_type::tok_closing_parenthesis, true, true) == false )
+                        {
+                            value = {};
+                        }
+
+                        next = step::k_suffix;
+                        break;
+                    }
+
+                    case frame_kind::k_argument:
+                    {
+                        if ( value.get() != nullptr )
+                        {
+                            list_of(f).insert(std::move(value));
+                        }
+
+                        // Continue parsing on a comma token ','.
+
+                        if ( expect(token_type::tok_comma, false, true) == true )
+                        {
+                            m_frames.push_back(std::move(f));
+
+                            next = step::k_operand;
+                            break;
+                        }
+
+                        const auto is_new = f.m_op == token_type::tok_new;
+
+                        if ( expect(token_type::tok_closing_parenthesis, true, true) == false )
+                        {
+                            // A call expression ends the member expression, a new expression
+                            // continues it.
+
+                            value = {};
+                            next  = is_new ? step::k_suffix : step::k_postfix;
+                            break;
+                        }
+
+                        if ( is_new )
+                        {
+                            value = ast::NewExpression::make(context(), position(), std::move(f.m_left), std::move(f.m_right));
+                        }
+
+                        else
+                        {
+                            value = ast::CallExpression::make(context(), position(), std::move(f.m_left), std::move(f.m_right));
+                        }
+
+                        next = step::k_suffix;
+                        break;
+                    }
+
+                    case frame_kind::k_property:
+                    {
+                        next = step::k_object_end;
+
+                        if ( value.get() == nullptr )
+                        {
+                            parser_syntax_error("Expected a value"sv);
+                        }
+
+                        else
+                        {
+                            list_of(f).insert(ast::ObjectProperty::make(context(), std::move(f.m_left), std::move(value), position()));
+
+                            // Continue on a comma operator.
+
+                            if ( expect(token_type::tok_comma, false, true) == true )
+                            {
+                                next = step::k_property;
+                            }
+                        }
+
+                        m_frames.push_back(std::move(f));
+                        break;
+                    }
+
+                    case frame_kind::k_element:
+                    {
+                        next = step::k_array_end;
+
+                        if ( value.get() != nullptr )
+                        {
+                            list_of(f).insert(std::move(value));
+
+                            // Continue on a comma operator.
+
+                            if ( expect(token_type::tok_comma, false, true) == true )
+                            {
+                                next = step::k_element;
+                            }
+                        }
+
+                        m_frames.push_back(std::move(f));
+                        break;
+                    }
+
+                    case frame_kind::k_consequent:
+                    {
+                        // Without a colon ':' the enclosing expression has no value.
+
+                        if ( expect(token_type::tok_colon, true, true) == false )
+                        {
+                            value = {};
+                            break;
+                        }
+
+                        m_frames.push_back(frame{ .m_left = std::move(f.m_left), .m_right = std::move(value), .m_kind = frame_kind::k_alternate });
+
+                        next = step::k_operand;
+                        break;
+                    }
+
+                    case frame_kind::k_alternate:
+                    {
+                        value = ast::TernaryExpression::make(context(), position(), std::move(f.m_left), std::move(f.m_right), std::move(value));
+                        break;
+                    }
+
+                    case frame_kind::k_assignment:
+                    {
+                        value = ast::BinaryExpression::make(context(), std::move(f.m_left), std::move(value), f.m_op, position());
+                        break;
+                    }
+
+                    default:
+                    {
+                        if ( std::is_constant_evaluated() == false )
+                        {
+                            assert(false);
+                        }
+
+                        return {};
+                    }
+                }
+
+                break;
+            }
+
+            // ObjectLiteral ::
+            //  '{' (<ObjectProperty> (',' <ObjectProperty>)*)? '}'
+
+            case step::k_property:
+            {
+                next = step::k_object_end;
+
+                // Getters and setters have a function body instead of an expression.
+
+                if ( current_token().type() == token_type::tok_get || current_token().type() == token_type::tok_set )
+                {
+                    if ( auto property = transition(state::object_property{}); property.get() != nullptr )
+                    {
+                        list_of(m_frames.back()).insert(std::move(property));
+
+                        if ( expect(token_type::tok_comma, false, true) == true )
+                        {
+                            next = step::k_property;
+                        }
+                    }
 
-        return ast::BinaryExpression::make(context(), std::move(left), std::move(right), op_type.type(), position());
+                    break;
+                }
+
+                auto key = transition(state::literal_expression{});
+
+                if ( ast::instanceof<ast::Identifier>(key) == false )
+                {
+                    assert(false);
+                    parser_syntax_error("Expected an identifier, instead of got '%s'."sv, ast::to_string(key));
+                    break;
+                }
+
+                // Expect a colon ':' after the property key identifier.
+
+                if ( expect(token_type::tok_colon, false, true) == false )
+                {
+                    parser_syntax_error("Expected a value"sv);
+                    break;
+                }
+
+                m_frames.back().m_left = std::move(key);
+
+                next = step::k_operand;
+                break;
+            }
+
+            case step::k_object_end:
+            {
+                auto f = m_frames.pop_back();
+
+                value = ast::ObjectLiteral::make(context(), std::move(f.m_right), position());
+
+                if ( expect(token_type::tok_closing_bracket, true, true) == false )
+                {
+                    value = {};
+                }
+
+                next = step::k_suffix;
+                break;
+            }
+
+            // ArrayLiteral ::
+            //  '[' (<Expression>? (',' <Expression>?)*) ']'
+
+            case step::k_element:
+            {
+                const auto token = current_token().type();
+
+                if ( token != token_type::tok_comma && token != token_type::tok_closing_square_bracket )
+                {
+                    next = step::k_operand;
+                }
+
+                // An elision adds no element.
+
+                else if ( expect(token_type::tok_comma, false, true) == false )
+                {
+                    next = step::k_array_end;
+                }
+
+                break;
+            }
+
+            case step::k_array_end:
+            {
+                auto f = m_frames.pop_back();
+
+                value = ast::ArrayLiteral::make(context(), std::move(f.m_right), position());
+
+                if ( expect(token_type::tok_closing_square_bracket, true, true) == false )
+                {
+                    value = {};
+                }
+
+                next = step::k_suffix;
+                break;
+            }
+        }
     }
 
-    return left;
+    return {};
+}
+
+constexpr auto parser::parse(state::unary_expression) -> ast::UniqueAstNode
+{
+    return parse_expression(frame_kind::k_unary_result);
+}
+
+constexpr auto parser::parse(state::binary_expression) -> ast::UniqueAstNode
+{
+    return parse_expression(frame_kind::k_binary_result);
+}
+
+constexpr auto parser::parse(state::expression) -> ast::UniqueAstNode
+{
+    return parse_expression(frame_kind::k_result);
 }
 
 } // namespace acme
@@ -18,8 +18,17 @@ namespace {
         return {};
     }
 
+    // The text is hashed while it is scanned for the string pool.
+
+    auto hash = acme::detail::k_fnv1a_init;
+
     while ( true )
     {
+        if ( parser.empty() == false )
+        {
+            hash = acme::detail::hash_fnv1a_step(hash, parser.peek());
+        }
+
         parser.eat(1);
 
         if ( parser.empty() )
@@ -34,7 +43,7 @@ namespace {
     }
 
     auto raw_string      = parser.from(checkpoint);
-    auto interned_string = parser.context().get_string_pool().intern(raw_string);
+    auto interned_string = parser.context().get_string_pool().intern(raw_string, hash);
 
     parser.eat(1);
 
@@ -66,11 +75,11 @@ constexpr auto parser::parse(state::literal_expression) -> ast::UniqueAstNode
             break;
 
         case acme::token_type::tok_identifier:
-            result = ast::Identifier::make(context(), token.to_string(), parse_position);
+            result = ast::Identifier::make(context(), token.to_string(), token.hash(), parse_position);
             break;
 
         case acme::token_type::tok_string:
-            result = ast::Literal::make(context(), ast::String{context().get_string_pool().intern(token.to_string())}, parse_position);
+            result = ast::Literal::make(context(), ast::String{context().get_string_pool().intern(token.to_string(), token.hash())}, parse_position);
             break;
 
         case acme::token_type::tok_signed_number:
@@ -112,57 +121,4 @@ constexpr auto parser::parse(state::literal_expression) -> ast::UniqueAstNode
     return result;
 }
 
-// <ArrayLiteral> ::
-//    ('[' <Element> ']')
-//    ('[' <ElementList> ']')
-//    ('[' <ElementList> ',' <Element> ']')
-
-constexpr auto parser::parse(state::array_literal) -> ast::UniqueAstNode
-{
-    auto next_literal_or_null = [&]() -> ast::UniqueAstNode
-    {
-        if ( current_token().is_literal() )
-        {
-            return transition(state::literal_expression{});
-        }
-
-        return ast::Literal::make(context(), ast::Null{}, position());
-    };
-
-    auto list = ast::AstNodeList::make(context(), position());
-    assert(list.get() != nullptr);
-
-    while ( true )
-    {
-        // Get next array element.
-
-        if ( auto token = current_token(); token.is_literal() )
-        {
-            // Parse next literal or append just a Null element in case of a comma opeator.
-
-            if ( auto element = next_literal_or_null(); element.get() != nullptr )
-            {
-                list->insert(std::move(element));
-            }
-
-            // Break if no literal element was parsed.
-
-            else
-            {
-                //std::cerr << "Expected an array element\n";
-                break;
-            }
-        }
-
-        // Stop parsing if no comma operator ','.
-
-        if ( expect(token_type::tok_comma, false, true) == false )
-        {
-            break;
-        }
-    }
-
-    return ast::ArrayLiteral::make(context(), std::move(list), position());
-}
-
 } // namespace acme
@@ -4,17 +4,46 @@ namespace acme {
 
 struct parser : public acme::tokenizer<char>
 {
-    static constexpr auto k_max_parse_depth       = 64u;
     static constexpr auto k_max_token_stack_depth = 2u;
 
+    // Frames of the expression parser. The frame of an expression waits for its value and
+    // says what the value is for, the frames of the operators above it wait for their operands.
+
+    enum class frame_kind : std::uint8_t
+    {
+        k_result,           // Value of parse(state::expression).
+        k_binary_result,    // Value of parse(state::binary_expression).
+        k_unary_result,     // Value of parse(state::unary_expression).
+        k_group,            // Expression in parenthesis.
+        k_argument,         // Argument to the list m_right of the callee m_left, 'new' if m_op is.
+        k_property,         // Value of the key m_left to the property list m_right.
+        k_element,          // Element to the list m_right.
+        k_consequent,       // Consequent of the condition m_left.
+        k_alternate,        // Alternate of the condition m_left and the consequent m_right.
+        k_assignment,       // Right hand side of the assignment m_op to m_left.
+        k_operand,          // Left operand m_left of m_op, with the right operand parsed.
+        k_pending,          // Left operand m_left of m_op, waiting for the right operand.
+        k_unary,            // Operand of the prefix operator m_op.
+    };
+
+    struct frame
+    {
+        ast::UniqueAstNode m_left{};
+        ast::UniqueAstNode m_right{};
+        frame_kind         m_kind{};
+        token_type         m_op{};
+        std::uint8_t       m_power{};
+    };
+
     using base               = acme::tokenizer<char>;
     using string_type        = base::string_type;
     using token_item_type    = base::token_item_type;
     using ast_node_list_type = acme::dynamic_cvector<ast::UniqueAstNode>;
-    using stack_type         = acme::containers::stack<k_max_parse_depth, acme::transition_state>;
+    using stack_type         = acme::dynamic_cvector<acme::transition_state>;
+    using frame_stack_type   = acme::dynamic_cvector<frame>;
     using token_stack_type   = acme::containers::stack<k_max_token_stack_depth, token_item_type>;
 
-    explicit parser(
+    explicit constexpr parser(
         string_type                     input,
         platform::pmr::memory_resource* resource
     ) noexcept
@@ -23,6 +52,8 @@ struct parser : public acme::tokenizer<char>
         , m_nodes{resource}
         {}
 
+    constexpr ~parser() override {}
+
     constexpr auto parse(state::function_declaration)                             -> ast::UniqueAstNode;
     constexpr auto parse(state::function_expression)                              -> ast::UniqueAstNode;
     constexpr auto parse(state::arrow_function_expression)                        -> ast::UniqueAstNode;
@@ -32,7 +63,6 @@ struct parser : public acme::tokenizer<char>
     constexpr auto parse(state::double_quoted_literal)                            -> ast::UniqueAstNode;
     constexpr auto parse(state::parameter_list)                                   -> ast::UniqueAstNode;
 
-    constexpr auto parse(state::array_literal)                                    -> ast::UniqueAstNode;
     constexpr auto parse(state::arrow_function)                                   -> ast::UniqueAstNode;
     constexpr auto parse(state::object_property)                                  -> ast::UniqueAstNode;
     constexpr auto parse(state::logical_expression)                               -> ast::UniqueAstNode;
@@ -41,11 +71,7 @@ struct parser : public acme::tokenizer<char>
     constexpr auto parse(state::additive_expression)                              -> ast::UniqueAstNode;
     constexpr auto parse(state::multiplicative_expression)                        -> ast::UniqueAstNode;
     constexpr auto parse(state::unary_expression)                                 -> ast::UniqueAstNode;
-    constexpr auto parse(state::ternary_expression, ast::UniqueAstNode)           -> ast::UniqueAstNode;
-    constexpr auto parse(state::primary_expression)                               -> ast::UniqueAstNode;
     constexpr auto parse(state::binary_expression)                                -> ast::UniqueAstNode;
-    constexpr auto parse(state::postfix_expression)                               -> ast::UniqueAstNode;
-    constexpr auto parse(state::object_literal)                                   -> ast::UniqueAstNode;
     constexpr auto parse(state::block_statement)                                  -> ast::UniqueAstNode;
     constexpr auto parse(state::variable_statement)                               -> ast::UniqueAstNode;
     constexpr auto parse(state::if_statement)                                     -> ast::UniqueAstNode;
@@ -66,8 +92,10 @@ struct parser : public acme::tokenizer<char>
     constexpr auto parse(state::empty_statement)                                  -> ast::UniqueAstNode;
     constexpr auto parse(state::statement)                                        -> ast::UniqueAstNode;
     constexpr auto parse(state::this_expression)                                  -> ast::UniqueAstNode;
-    constexpr auto parse(state::member_expression)                                -> ast::UniqueAstNode;
-    constexpr auto parse(state::new_expression)                                   -> ast::UniqueAstNode;
+
+    // Expression parser with the nesting on the heap, from the entry frame.
+
+    constexpr auto parse_expression(frame_kind entry)                             -> ast::UniqueAstNode;
 
     template <typename... Args>
     constexpr auto parser_syntax_error(
@@ -367,6 +395,7 @@ struct parser : public acme::tokenizer<char>
     token_item_type    m_current_token{};
     token_stack_type   m_token_stack{};
     stack_type         m_stack{};
+    frame_stack_type   m_frames{};
 };
 
 } // namespace acme
@@ -6,12 +6,12 @@ struct parser_context
 {
     using memory_resource_type = platform::pmr::memory_resource;
 
-    /* constexpr */ parser_context() noexcept
+    constexpr parser_context() noexcept
         : m_resource{nullptr}
         , m_pool{nullptr}
     {}
 
-    /* constexpr */ parser_context(memory_resource_type* resource) noexcept
+    constexpr parser_context(memory_resource_type* resource) noexcept
         : m_resource{resource}
         , m_pool{resource}
     {}
@@ -23,7 +23,11 @@ struct parser_context
 
     [[nodiscard]] constexpr auto resource() const noexcept -> memory_resource_type*
     {
-        assert(m_resource != nullptr);
+        if ( std::is_constant_evaluated() == false )
+        {
+            assert(m_resource != nullptr);
+        }
+
         return m_resource;
     }
 
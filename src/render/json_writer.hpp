@@ -0,0 +1,220 @@
+#pragma once
+
+namespace acme::render {
+
+/* Streaming JSON writer with the layout of nlohmann::json::dump(2). Objects and arrays are
+   scopes on the stack of the caller, and a scope is opened lazily when its first member is
+   written: a scope without members writes nothing, or null, like an empty nlohmann::json
+   value that is left out, or assigned, by the caller.
+
+   Members have to be written in ascending key order, which is the order of the std::map of
+   nlohmann::json. With an ostream the text is flushed in chunks, so the extra memory does
+   not depend on the size of the document.
+
+       acme::render::json_writer writer{out};
+       acme::render::json_writer::scope object{};
+
+       writer.begin(object);
+       writer.string("name"sv, "value"sv);
+       writer.end(object);
+*/
+
+class json_writer
+{
+    public:
+
+    static constexpr std::size_t k_indent     = 2u;
+    static constexpr std::size_t k_flush_size = 64u * 1024u;
+
+    struct scope
+    {
+        scope*           m_parent{};
+        std::string_view m_key{};
+        std::string_view m_last_key{};
+        std::string_view m_extra_key{};     // Member inserted in key order among the others.
+        std::string_view m_extra_value{};
+        std::size_t      m_count{};
+        std::size_t      m_depth{};
+        bool             m_array{};
+        bool             m_open{};
+    };
+
+    explicit json_writer(std::string& out)
+        : m_out{std::addressof(out)}
+        {}
+
+    explicit json_writer(std::ostream& stream)
+        : m_out{std::addressof(m_buffer)}
+        , m_stream{std::addressof(stream)}
+        {}
+
+    json_writer(const json_writer&) = delete;
+    auto operator=(const json_writer&) -> json_writer& = delete;
+
+    ~json_writer()
+    {
+        flush();
+    }
+
+    // Begin an object, or an array, as a member of the current scope.
+
+    auto begin(
+        scope&           s,
+        std::string_view key   = {},
+        bool             array = false
+    ) -> void
+    {
+        s = scope{ .m_parent = m_scope, .m_key = key, .m_depth = m_scope != nullptr ? m_scope->m_depth + 1u : 0u, .m_array = array };
+
+        m_scope = std::addressof(s);
+    }
+
+    // Insert a string member when its key is reached, or replace the member with that key.
+
+    auto extra(
+        std::string_view key,
+        std::string_view value
+    ) -> void
+    {
+        m_scope->m_extra_key   = key;
+        m_scope->m_extra_value = value;
+    }
+
+    // End the scope. Returns false if nothing was written for it; with null_if_empty a null
+    // value is written instead.
+
+    auto end(
+        scope& s,
+        bool   null_if_empty = false
+    ) -> bool
+    {
+        if ( s.m_extra_key.empty() == false )
+        {
+            string(s.m_extra_key, s.m_extra_value);
+        }
+
+        m_scope = s.m_parent;
+
+        if ( s.m_open )
+        {
+            *m_out += '\n';
+            m_out->append(s.m_depth * k_indent, ' ');
+            *m_out += s.m_array ? ']' : '}';
+
+            return true;
+        }
+
+        if ( null_if_empty )
+        {
+            member(s.m_key);
+            *m_out += "null";
+
+            return true;
+        }
+
+        return false;
+    }
+
+    auto string(
+        std::string_view key,
+        std::string_view value
+    ) -> void
+    {
+        if ( m_scope != nullptr && m_scope->m_extra_key.empty() == false && m_scope->m_extra_key == key )
+        {
+            value = std::exchange(m_scope->m_extra_value, {});
+            m_scope->m_extra_key = {};
+        }
+
+        member(key);
+        acme::json::detail::append_quoted(*m_out, value);
+    }
+
+    auto flush() -> void
+    {
+        if ( m_stream != nullptr && m_buffer.empty() == false )
+        {
+            m_stream->write(m_buffer.data(), static_cast<std::streamsize>(m_buffer.size()));
+            m_buffer.clear();
+        }
+    }
+
+    private:
+
+    // Open the scope, and the scopes it is nested in, when the first member is written.
+
+    auto open(scope& s) -> void
+    {
+        if ( s.m_open )
+        {
+            return;
+        }
+
+        if ( s.m_parent != nullptr )
+        {
+            open(*s.m_parent);
+            prefix(*s.m_parent, s.m_key);
+        }
+
+        *m_out   += s.m_array ? '[' : '{';
+        s.m_open  = true;
+    }
+
+    // Separator, indentation and key of the next member of the scope.
+
+    auto prefix(
+        scope&           s,
+        std::string_view key
+    ) -> void
+    {
+        if ( s.m_array == false )
+        {
+            // The extra member goes before the first key that sorts after it.
+
+            if ( s.m_extra_key.empty() == false && s.m_extra_key < key )
+            {
+                const auto extra_key   = std::exchange(s.m_extra_key, {});
+                const auto extra_value = std::exchange(s.m_extra_value, {});
+
+                prefix(s, extra_key);
+                acme::json::detail::append_quoted(*m_out, extra_value);
+            }
+
+            assert(s.m_count == 0u || s.m_last_key < key);
+
+            s.m_last_key = key;
+        }
+
+        if ( m_stream != nullptr && m_buffer.size() >= k_flush_size )
+        {
+            flush();
+        }
+
+        *m_out += s.m_count++ == 0u ? "\n" : ",\n";
+        m_out->append((s.m_depth + 1u) * k_indent, ' ');
+
+        if ( s.m_array == false )
+        {
+            acme::json::detail::append_quoted(*m_out, key);
+            *m_out += ": ";
+        }
+    }
+
+    auto member(std::string_view key) -> void
+    {
+        if ( m_scope == nullptr )
+        {
+            return;
+        }
+
+        open(*m_scope);
+        prefix(*m_scope, key);
+    }
+
+    std::string   m_buffer{};
+    std::string*  m_out{};
+    std::ostream* m_stream{};
+    scope*        m_scope{};
+};
+
+} // namespace acme::render
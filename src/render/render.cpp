@@ -8,7 +8,10 @@
 #include "tokenizer/tokenizer.hpp"
 #include "ast/ast.hpp"
 #include "parse/parse.hpp" // FIXME
+#include "json/json_escape.hpp"
 #include "render.hpp"
+#include "json_writer.hpp"
+#include "to_json_stream.hpp"
 #include "to_json.hpp"
 
 #if __has_include(<nlohmann/json.hpp>)
@@ -22,32 +25,67 @@ auto to_json(const ast::UniqueAstNode& p) -> nlohmann::json
 
 } // namespace acme::render
 
-namespace acme {
+#endif /* __has_include(<nlohmann/json.hpp>) */
 
-auto to_json(const acme::parser::ast_node_list_type& ast_nodes) -> std::string
+namespace acme::render {
+
+auto to_json(
+    const acme::parser::ast_node_list_type& ast_nodes,
+    render::json_writer&                    writer
+) -> void
 {
     using namespace std::string_view_literals;
 
-    nlohmann::json result{};
+    json_writer::scope nodes{};
+
+    writer.begin(nodes, {}, true);
 
     for ( const auto& p : ast_nodes )
     {
-        auto sub      = render::to_json(p);
-        sub["type"sv] = ast::to_string(p);
+        json_writer::scope node{};
 
-        result += sub;
+        writer.begin(node);
+        writer.extra("type"sv, ast::to_string(p));
+
+        ast::visit(render::json_stream_printer{writer}, p);
+
+        writer.end(node, true);
     }
 
-    return result.dump(2);
+    writer.end(nodes, true);
 }
 
-} // namespace acme
+} // namespace acme::render
 
-#else
+namespace acme {
 
 auto to_json(const acme::parser::ast_node_list_type& ast_nodes) -> std::string
 {
-    return {};
+    auto result = std::string{};
+
+    to_json(ast_nodes, result);
+
+    return result;
 }
 
-#endif /* __has_include(<nlohmann/json.hpp>) */
+auto to_json(
+    const acme::parser::ast_node_list_type& ast_nodes,
+    std::string&                            out
+) -> void
+{
+    render::json_writer writer{out};
+
+    render::to_json(ast_nodes, writer);
+}
+
+auto to_json(
+    const acme::parser::ast_node_list_type& ast_nodes,
+    std::ostream&                           out
+) -> void
+{
+    render::json_writer writer{out};
+
+    render::to_json(ast_nodes, writer);
+}
+
+} // namespace acme
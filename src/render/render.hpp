@@ -4,4 +4,10 @@ namespace acme {
 
 auto to_json(const acme::parser::ast_node_list_type&) -> std::string;
 
+// Write the same text to the end of a buffer, or to a stream in chunks, without building
+// a document first.
+
+auto to_json(const acme::parser::ast_node_list_type&, std::string&) -> void;
+auto to_json(const acme::parser::ast_node_list_type&, std::ostream&) -> void;
+
 } // namespace acme
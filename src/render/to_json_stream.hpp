@@ -0,0 +1,329 @@
+#pragma once
+
+namespace acme::render {
+
+/* The printer of to_json.hpp writing to a json_writer instead of building a nlohmann::json
+   value per node. Members are written in key order, and a member is left out, or written
+   as null, under the same conditions as in json_printer, so the text is identical to the
+   dump(2) of the document json_printer builds.
+*/
+
+struct json_stream_printer
+{
+    // Member that json_printer assigns if the pointer is set: an empty node is written as null.
+
+    auto member(
+        std::string_view          key,
+        const ast::UniqueAstNode& p
+    ) const -> void
+    {
+        if ( p.get() != nullptr )
+        {
+            node(key, p, true);
+        }
+    }
+
+    // Member that json_printer assigns if the value is not empty().
+
+    auto optional_member(
+        std::string_view          key,
+        const ast::UniqueAstNode& p
+    ) const -> void
+    {
+        node(key, p, false);
+    }
+
+    auto node(
+        std::string_view          key,
+        const ast::UniqueAstNode& p,
+        bool                      null_if_empty
+    ) const -> void
+    {
+        json_writer::scope s{};
+
+        m_writer.begin(s, key);
+        ast::visit(*this, p);
+        m_writer.end(s, null_if_empty);
+    }
+
+    auto operator()(const ast::Identifier& v) const -> void
+    {
+        using namespace std::string_view_literals;
+
+        if ( const auto name = v.value().view(); name.empty() == false )
+        {
+            m_writer.string("name"sv, name);
+        }
+    }
+
+    auto operator()(const ast::DeclarationKind& v) const -> std::string_view
+    {
+        using namespace std::string_view_literals;
+
+        switch ( v.value() )
+        {
+            case token_type::tok_var:
+                return "var"sv;
+
+            case token_type::tok_let:
+                return "let"sv;
+
+            case token_type::tok_const:
+                return "const"sv;
+
+            default:
+                break;
+        }
+
+        return {};
+    }
+
+    auto operator()(const ast::Literal& lit) const -> void
+    {
+        using namespace std::string_view_literals;
+        using namespace acme::ast;
+
+        const auto& value = lit.value();
+
+        if ( std::holds_alternative<String>(value) )
+        {
+            m_writer.string("type"sv, "string"sv);
+            m_writer.string("value"sv, std::get<String>(value).value().view());
+        }
+
+        if ( std::holds_alternative<Float>(value) )
+        {
+            m_writer.string("type"sv, "float"sv);
+            m_writer.string("value"sv, std::to_string(std::get<Float>(value).value()));
+        }
+
+        if ( std::holds_alternative<UnsignedInteger>(value) )
+        {
+            m_writer.string("type"sv, "uint"sv);
+            m_writer.string("value"sv, std::to_string(std::get<UnsignedInteger>(value).value()));
+        }
+
+        if ( std::holds_alternative<Integer>(value) )
+        {
+            m_writer.string("type"sv, "int"sv);
+            m_writer.string("value"sv, std::to_string(std::get<Integer>(value).value()));
+        }
+
+        if ( std::holds_alternative<Boolean>(value) )
+        {
+            m_writer.string("type"sv, "boolean"sv);
+            m_writer.string("value"sv, std::get<Boolean>(value).value() ? "true"sv : "false"sv);
+        }
+
+        if ( std::holds_alternative<Null>(value) )
+        {
+            m_writer.string("type"sv, "null"sv);
+            m_writer.string("value"sv, "null"sv);
+        }
+    }
+
+    auto operator()(const ast::ArrayLiteral& lit) const -> void
+    {
+        using namespace std::string_view_literals;
+
+        member("elements"sv, lit.elements());
+    }
+
+    auto operator()(const ast::FunctionDeclaration& v) const -> void
+    {
+        using namespace std::string_view_literals;
+
+        optional_member("body"sv, v.body());
+        optional_member("identifier"sv, v.identifier());
+        optional_member("parameters"sv, v.parameters());
+    }
+
+    auto operator()(const ast::FunctionExpression& v) const -> void
+    {
+        using namespace std::string_view_literals;
+
+        optional_member("body"sv, v.body());
+        optional_member("parameters"sv, v.parameters());
+    }
+
+    auto operator()(const ast::VariableDeclaration& v) const -> void
+    {
+        using namespace std::string_view_literals;
+
+        optional_member("identifier"sv, v.identifier());
+        optional_member("init"sv, v.initializer());
+
+        if ( const auto kind = operator()(v.kind()); kind.empty() == false )
+        {
+            m_writer.string("kind"sv, kind);
+        }
+    }
+
+    auto operator()(const ast::BinaryExpression& v) const -> void
+    {
+        using namespace std::string_view_literals;
+
+        member("left"sv, v.left());
+
+        if ( const auto op = v.operand(); op != token_type::tok_none )
+        {
+            m_writer.string("operand"sv, token_table::to_string(op));
+        }
+
+        member("right"sv, v.right());
+    }
+
+    auto operator()(const ast::UnaryExpression& v) const -> void
+    {
+        using namespace std::string_view_literals;
+
+        member("argument"sv, v.expression());
+
+        if ( const auto op = v.operand(); op != token_type::tok_none )
+        {
+            m_writer.string("operand"sv, token_table::to_string(op));
+        }
+    }
+
+    auto operator()(const ast::BlockStatement& v) const -> void
+    {
+        using namespace std::string_view_literals;
+
+        member("body"sv, v.body());
+    }
+
+    auto operator()(const ast::MemberExpression& v) const -> void
+    {
+        using namespace std::string_view_literals;
+
+        member("object"sv, v.object());
+        member("property"sv, v.property());
+    }
+
+    auto operator()(const ast::AstNodeList& v) const -> void
+    {
+        using namespace std::string_view_literals;
+
+        if ( const auto& list = v.nodes(); list.empty() == false )
+        {
+            json_writer::scope nodes{};
+
+            m_writer.begin(nodes, "nodes"sv, true);
+
+            for ( const auto& p : list )
+            {
+                node({}, p, true);
+            }
+
+            m_writer.end(nodes);
+        }
+    }
+
+    auto operator()(const ast::ObjectLiteral& v) const -> void
+    {
+        using namespace std::string_view_literals;
+
+        member("properties"sv, v.properties());
+    }
+
+    auto operator()(const ast::ObjectPropertySetter& v) const -> void
+    {
+        using namespace std::string_view_literals;
+
+        member("body"sv, v.function_body());
+        member("formals"sv, v.formals());
+    }
+
+    auto operator()(const ast::ObjectPropertyGetter& v) const -> void
+    {
+        using namespace std::string_view_literals;
+
+        member("body"sv, v.function_body());
+    }
+
+    auto operator()(const ast::ObjectProperty& v) const -> void
+    {
+        using namespace std::string_view_literals;
+
+        const auto property_type_string = [](const ast::UniqueAstNode& n)
+        {
+            if ( ast::instanceof<ast::ObjectPropertySetter>(n) ) { return "setter"sv; }
+            if ( ast::instanceof<ast::ObjectPropertyGetter>(n) ) { return "getter"sv; }
+
+            return "key/value"sv;
+        }(v.value());
+
+        member("key"sv, v.key());
+        m_writer.string("property type string"sv, property_type_string);
+        member("value"sv, v.value());
+    }
+
+    auto operator()(const ast::ThisExpression&) const -> void
+    {
+    }
+
+    auto operator()(const ast::IfStatement& v) const -> void
+    {
+        using namespace std::string_view_literals;
+
+        member("alternate"sv, v.alternate());
+        member("condition"sv, v.condition());
+        member("consequent"sv, v.consequent());
+    }
+
+    auto operator()(const ast::TernaryExpression& v) const -> void
+    {
+        using namespace std::string_view_literals;
+
+        member("alternate"sv, v.alternate());
+        member("condition"sv, v.condition());
+        member("consequent"sv, v.consequent());
+    }
+
+    auto operator()(const ast::LoopStatement& v) const -> void
+    {
+        using namespace std::string_view_literals;
+
+        member("body"sv, v.body());
+        member("condition"sv, v.condition());
+        member("initializers"sv, v.initializer());
+        member("update"sv, v.update());
+    }
+
+    auto operator()(const ast::SimpleStatement& v) const -> void
+    {
+        using namespace std::string_view_literals;
+
+        member("argument"sv, v.argument());
+    }
+
+    auto operator()(const ast::CallExpression& v) const -> void
+    {
+        using namespace std::string_view_literals;
+
+        member("arguments"sv, v.arguments());
+        member("callee"sv, v.callee());
+    }
+
+    auto operator()(const ast::NewExpression& v) const -> void
+    {
+        using namespace std::string_view_literals;
+
+        member("arguments"sv, v.arguments());
+        member("callee"sv, v.callee());
+    }
+
+    auto operator()(const ast::MetaProperty& v) const -> void
+    {
+        using namespace std::string_view_literals;
+
+        if ( v.type() == ast::MetaProperty::property_type::new_target )
+        {
+            m_writer.string("arguments"sv, "new.target"sv);
+        }
+    }
+
+    json_writer& m_writer;
+};
+
+} // namespace acme::render
@@ -1,5 +1,7 @@
 #pragma once
 
+#include "numeric/numeric.hpp"
+
 namespace acme {
 
 struct string_pool
@@ -80,6 +82,19 @@ struct string_pool
             return m_hash;
         }
 
+        // Numeric value of the string. Parsed on first use and cached for later conversions.
+
+        [[nodiscard]] constexpr auto to_number() noexcept -> double
+        {
+            if ( m_has_number == false )
+            {
+                m_number     = numeric::string_to_number(view());
+                m_has_number = true;
+            }
+
+            return m_number;
+        }
+
         [[nodiscard]] constexpr const auto reference_count() const
         {
             // return m_ref_count.load();
@@ -93,7 +108,7 @@ struct string_pool
 
         [[nodiscard]] constexpr auto operator==(const string_header& rhs) const noexcept
         {
-            return operator==(rhs.hash());
+            return operator==(rhs.hash()) && view() == rhs.view();
         }
 
         [[nodiscard]] constexpr auto data() -> char*
@@ -123,6 +138,8 @@ struct string_pool
         hash_type                m_hash{};
         // std::atomic<std::size_t> m_ref_count{};
         std::size_t              m_ref_count{};
+        double                   m_number{};
+        bool                     m_has_number{};
         value_type               m_data[1]{};
     };
 
@@ -156,11 +173,21 @@ struct string_pool
 
         constexpr void acquire()
         {
-            m_header->acquire();
+            if ( m_header != nullptr )
+            {
+                m_header->acquire();
+            }
         }
 
         constexpr string_ref() noexcept = default;
 
+        // A string that is not owned by any pool. Used during constant evaluation
+        // where the text refers to the script source itself.
+
+        explicit constexpr string_ref(view_type text) noexcept
+            : base{text}
+        {}
+
         constexpr string_ref(string_header* header) noexcept
             : base{header->view()}
             , m_header{header}
@@ -169,30 +196,46 @@ struct string_pool
         }
 
         constexpr string_ref(const string_ref& other) noexcept
-            : string_ref{other.m_header}
-        {}
+            : base{other}
+            , m_header{other.m_header}
+        {
+            acquire();
+        }
 
         constexpr string_ref& operator=(const string_ref& other)
         {
+            if ( this == std::addressof(other) )
+            {
+                return *this;
+            }
+
             release(m_header);
 
+            base::operator=(other);
             m_header = other.m_header;
             acquire();
             return *this;
         }
 
         constexpr string_ref(string_ref&& other) noexcept
-            : m_header{std::exchange(other.m_header, nullptr)}
+            : base{std::exchange(static_cast<base&>(other), base{})}
+            , m_header{std::exchange(other.m_header, nullptr)}
         {}
 
         constexpr string_ref& operator=(string_ref&& other) noexcept
         {
+            std::swap(static_cast<base&>(*this), static_cast<base&>(other));
             std::swap(m_header, other.m_header);
             return *this;
         }
 
         [[nodiscard]] constexpr auto operator==(const string_ref& rhs) const noexcept
         {
+            if ( m_header == nullptr || rhs.m_header == nullptr )
+            {
+                return view() == rhs.view();
+            }
+
             return m_header == rhs.m_header;
         }
 
@@ -209,12 +252,38 @@ struct string_pool
             std::exchange(other.m_header, m_header);
         }
 
-        [[nodiscard]] constexpr const auto view() const
+        [[nodiscard]] constexpr auto view() const -> view_type
         {
-            assert(m_header != nullptr);
+            if ( m_header == nullptr )
+            {
+                return view_type{*this};
+            }
+
             return m_header->view();
         }
 
+        // Hash of the text, from the pool unless the string is not owned by one.
+
+        [[nodiscard]] constexpr auto hash() const noexcept -> string_header::hash_type
+        {
+            if ( m_header == nullptr )
+            {
+                return acme::detail::hash_fnv1a(view());
+            }
+
+            return m_header->hash();
+        }
+
+        [[nodiscard]] constexpr auto to_number() const noexcept -> double
+        {
+            if ( m_header == nullptr )
+            {
+                return numeric::string_to_number(view());
+            }
+
+            return m_header->to_number();
+        }
+
         [[nodiscard]] constexpr const auto reference_count() const
         {
             assert(m_header != nullptr);
@@ -270,7 +339,7 @@ struct string_pool
     {
         assert(m_resource != nullptr);
 
-        auto* ptr = m_resource->allocate(sizeof(string_header) + 1 + (strings.length(), ...), alignof(string_header));
+        auto* ptr = m_resource->allocate(sizeof(string_header) + 1 + (strings.length() + ...), alignof(string_header));
         assert(ptr != nullptr);
 
         union
@@ -292,13 +361,17 @@ struct string_pool
             return;
         }
 
-        const auto erased = acme::erase_if(m_map, [hash = h->hash()](auto* s)
+        const auto erased = acme::erase_if(m_map, [h](auto* s)
         {
-            return s->hash() == hash;
+            return s == h;
         });
 
         assert(erased == 1);
-        m_resource->deallocate(h, alignof(string_header));
+
+        const auto size = sizeof(string_header) + h->view().length() + 1;
+
+        std::destroy_at(h);
+        m_resource->deallocate(h, size, alignof(string_header));
     }
 
     template <typename I>
@@ -307,12 +380,24 @@ struct string_pool
         return *it;
     }
 
-    [[nodiscard]] constexpr auto find(string_header::hash_type hash) -> acme::string_pool::string_header*
+    // Interned string with the hash and the text of left and right concatenated. The text is
+    // compared in full, so strings with the same hash are different strings.
+
+    [[nodiscard]] constexpr auto find(
+        string_header::hash_type hash,
+        std::string_view         left,
+        std::string_view         right = {}
+    ) -> acme::string_pool::string_header*
     {
 #if 1
         for ( auto* it : m_map )
         {
-            if ( it->hash() == hash )
+            if ( it->hash() != hash )
+            {
+                continue;
+            }
+
+            if ( const auto v = it->view(); v.length() == left.length() + right.length() && v.starts_with(left) && v.ends_with(right) )
             {
                 return it;
             }
@@ -333,7 +418,7 @@ struct string_pool
 
     public:
 
-    string_pool(platform::pmr::memory_resource* resource)
+    constexpr string_pool(platform::pmr::memory_resource* resource)
         : m_map{resource},
           m_resource{resource}
         {}
@@ -353,7 +438,7 @@ struct string_pool
 
         // Search within interned strings with a given hash value.
 
-        if ( auto* it = find(hash2); it != nullptr )
+        if ( auto* it = find(hash2, left, right); it != nullptr )
         {
             return string_ref{it};
         }
@@ -369,17 +454,40 @@ struct string_pool
     }
 
     [[nodiscard]] constexpr auto intern(std::string_view text) -> string_ref
+    {
+        // No hash is needed for the empty string, or without pool memory.
+
+        if ( text.empty() || std::is_constant_evaluated() )
+        {
+            return intern(text, string_header::hash_type{});
+        }
+
+        return intern(text, acme::detail::hash_fnv1a(text));
+    }
+
+    // Intern a string with the hash of its text, e.g. computed by the tokenizer while the text
+    // was scanned.
+
+    [[nodiscard]] constexpr auto intern(
+        std::string_view         text,
+        string_header::hash_type hash
+    ) -> string_ref
     {
         if ( text.empty() )
         {
             return {};
         }
 
-        const auto hash = acme::detail::hash_fnv1a(text);
+        // Pool memory is not available during constant evaluation.
+
+        if ( std::is_constant_evaluated() )
+        {
+            return string_ref{text};
+        }
 
         // Search within interned strings with a given hash value.
 
-        if ( auto* it = find(hash); it != nullptr )
+        if ( auto* it = find(hash, text); it != nullptr )
         {
             return string_ref{it};
         }
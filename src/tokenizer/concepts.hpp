@@ -15,6 +15,7 @@ concept tokenizer = requires(T tokenizer)
     { tokenizer.peek()             } -> std::same_as<typename T::char_traits::char_type>;
     { tokenizer.eol()              } -> std::same_as<bool>;
     { tokenizer.next()             } -> std::same_as<typename T::token_item_type>;
+    { tokenizer.remaining()        } -> std::same_as<typename T::string_type>;
 
     requires requires(typename T::size_type index)
     {
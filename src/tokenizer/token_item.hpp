@@ -12,6 +12,7 @@ struct token_item
     using string_type          = std::basic_string_view<char_type, char_traits>;
     using predicate_type       = bool (*)(char_type);
     using value_type           = std::variant<string_type, unsigned_number_type, signed_number_type, float_number_type>;
+    using hash_type            = decltype(acme::detail::hash_fnv1a(string_type{}));
 
     [[nodiscard]] constexpr /* explicit */ operator token_type() const noexcept
     {
@@ -88,6 +89,13 @@ struct token_item
         return {};
     }
 
+    // FNV-1a hash of the text of an identifier or a string, computed while it was scanned.
+
+    [[nodiscard]] constexpr auto hash() const noexcept -> hash_type
+    {
+        return m_hash;
+    }
+
     [[nodiscard]] constexpr auto length() const noexcept -> string_type::size_type
     {
         return to_string().size();
@@ -122,15 +130,26 @@ struct token_item
             is_match = input.starts_with(to_string());
         }
 
-        if ( is_match && m_right_side_predicate != nullptr )
+        // The predicate is never null: comparing function pointers is not a constant
+        // expression when building with -fsanitize=null.
+
+        if ( is_match )
         {
-            return (input.size() >= length()) && std::invoke(m_right_side_predicate, input[length()]);
+            return (input.size() == length()) || std::invoke(m_right_side_predicate, input[length()]);
         }
 
         return is_match;
     }
 
     [[nodiscard]] static constexpr auto make(token_item::string_type s) -> token_item
+    {
+        return make(s, acme::detail::hash_fnv1a(s));
+    }
+
+    [[nodiscard]] static constexpr auto make(
+        token_item::string_type s,
+        hash_type               hash
+    ) -> token_item
     {
         auto type = token_type::tok_string;
 
@@ -149,7 +168,7 @@ struct token_item
             type = token_type::tok_identifier;
         }
 
-        return { s, match_any, type, token_flags::literal };
+        return { s, match_any, type, token_flags::literal, hash };
     }
 
     [[nodiscard]] static constexpr auto make(token_item::unsigned_number_type n) -> token_item
@@ -168,9 +187,10 @@ struct token_item
     }
 
     value_type     m_value{};
-    predicate_type m_right_side_predicate{};
+    predicate_type m_right_side_predicate{match_any};
     token_type     m_type{token_type::tok_none};
     token_flags    m_flags{};
+    hash_type      m_hash{};
 };
 
 } // namespace acme
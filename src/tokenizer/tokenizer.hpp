@@ -11,6 +11,7 @@
 #include "token_item.hpp"
 
 #include "token_table.hpp"
+#include "numeric/numeric.hpp"
 #include "tokenize_number.hpp"
 
 namespace acme {
@@ -35,7 +36,7 @@ struct tokenizer
     constexpr tokenizer& operator=(const tokenizer&) noexcept = default;
     constexpr tokenizer& operator=(tokenizer&&)      noexcept = default;
 
-    virtual ~tokenizer() = default;
+    constexpr virtual ~tokenizer() = default;
 
     [[nodiscard]] constexpr auto available() const noexcept
     {
@@ -62,6 +63,11 @@ struct tokenizer
         return m_position;
     }
 
+    [[nodiscard]] constexpr auto remaining() const noexcept -> string_type
+    {
+        return m_input;
+    }
+
     [[nodiscard]] constexpr auto from(size_type first, size_type last) const -> string_type
     {
         const auto count = last - first;
@@ -237,7 +243,29 @@ struct tokenizer
             }
         }
 
-        // String literal.
+        // String literal. The text is hashed while it is scanned, so the parser, the string pool
+        // and the emitter do not hash it again.
+
+        auto hash = acme::detail::k_fnv1a_init;
+
+        // The characters of an identifier can not start a token, so they are scanned without
+        // matching the token table at each of them.
+
+        if ( match_identifier(peek()) )
+        {
+            while ( empty() == false )
+            {
+                const auto c = peek();
+
+                if ( codepoint::is_alphanumeric(c) == false && c != '_' && c != '$' )
+                {
+                    break;
+                }
+
+                hash = acme::detail::hash_fnv1a_step(hash, c);
+                eat(1u);
+            }
+        }
 
         while ( true )
         {
@@ -250,12 +278,17 @@ struct tokenizer
 
             if ( auto c = match<token_table>(m_input); c.has_value() && c.value().is_keyword() == false )
             {
-                return token_item::make(from(checkpoint));
+                return token_item::make(from(checkpoint), hash);
             }
 
             if ( auto c = consume(); c.has_value() == false )
             {
-                return token_item::make(from(checkpoint));
+                return token_item::make(from(checkpoint), hash);
+            }
+
+            else
+            {
+                hash = acme::detail::hash_fnv1a_step(hash, c.value());
             }
         }
 
@@ -0,0 +1,770 @@
+#pragma once
+
+namespace acme {
+
+// Input column of a batch: the value of a variable for every record. Numeric inputs are
+// passed unboxed, other inputs as script values.
+
+struct batch_input
+{
+    acme::identifier                    m_id{};
+    std::span<const double>             m_numbers{};
+    std::span<const acme::script_value> m_values{};
+};
+
+// Output column of a batch: receives the value of a variable for every record after the
+// script has run, undefined if the variable was not declared for the record.
+
+struct batch_output
+{
+    acme::identifier              m_id{};
+    std::span<acme::script_value> m_values{};
+};
+
+// Values of one operand stack slot or variable for every lane of a batch. Numbers and
+// booleans are kept unboxed so that arithmetic and comparisons run as loops over doubles.
+
+struct lane_column
+{
+    enum class kind : std::uint8_t
+    {
+        k_number = 0u,
+        k_boolean,
+        k_boxed,
+    };
+
+    using numbers_type = acme::dynamic_cvector<double>;
+    using kinds_type   = acme::dynamic_cvector<kind>;
+    using values_type  = acme::dynamic_cvector<acme::script_value>;
+
+    constexpr explicit lane_column(std::size_t lanes = 0)
+        : m_numbers(lanes)
+        , m_kinds(lanes)
+        , m_values(lanes)
+    {}
+
+    [[nodiscard]] constexpr auto get(std::size_t lane) const -> acme::script_value
+    {
+        switch ( m_kinds[lane] )
+        {
+            case kind::k_number:
+                return acme::script_value{acme::number{m_numbers[lane]}};
+
+            case kind::k_boolean:
+                return acme::script_value{acme::boolean{m_numbers[lane] != 0.0}};
+
+            case kind::k_boxed:
+                break;
+        }
+
+        return m_values[lane];
+    }
+
+    constexpr auto set(std::size_t lane, acme::script_value value) -> void
+    {
+        if ( is_number(value) )
+        {
+            m_numbers[lane] = to_double(value);
+            m_kinds[lane]   = kind::k_number;
+        }
+
+        else if ( value.type() == acme::boolean_type )
+        {
+            m_numbers[lane] = to_boolean(value) ? 1.0 : 0.0;
+            m_kinds[lane]   = kind::k_boolean;
+        }
+
+        else
+        {
+            m_values[lane] = value;
+            m_kinds[lane]  = kind::k_boxed;
+        }
+    }
+
+    constexpr auto copy(std::size_t lane, const lane_column& from) -> void
+    {
+        m_numbers[lane] = from.m_numbers[lane];
+        m_kinds[lane]   = from.m_kinds[lane];
+
+        if ( from.m_kinds[lane] == kind::k_boxed )
+        {
+            m_values[lane] = from.m_values[lane];
+        }
+    }
+
+    [[nodiscard]] constexpr auto truthy(std::size_t lane) const -> bool
+    {
+        const auto n = m_numbers[lane];
+
+        switch ( m_kinds[lane] )
+        {
+            case kind::k_number:
+                return n == n && n != 0.0;
+
+            case kind::k_boolean:
+                return n != 0.0;
+
+            case kind::k_boxed:
+                break;
+        }
+
+        return to_boolean(m_values[lane]);
+    }
+
+    numbers_type m_numbers{};
+    kinds_type   m_kinds{};
+    values_type  m_values{};
+};
+
+/* Interpreter that runs one script over many records at once. Each instruction is dispatched
+   once for a group of lanes, one lane per record, instead of once per record.
+
+    The lanes of a group share a program counter. A conditional jump splits a group by the
+    selection of lanes taking the branch. The group with the lowest program counter runs
+    next and groups reaching the same instruction are merged again, which rejoins the lanes
+    after an if statement or a loop exit.
+
+    Stack frames of lexical blocks are not supported, see supports().
+*/
+
+struct batch_virtual_machine
+{
+    static constexpr std::size_t k_lanes = 1024;
+
+    using selection_type = acme::dynamic_cvector<std::uint16_t>;
+    using kind           = lane_column::kind;
+
+    struct lane_group
+    {
+        std::size_t    m_pc{};
+        std::size_t    m_depth{};
+        selection_type m_lanes{};  // Sorted lane indices.
+    };
+
+    struct variable
+    {
+        acme::identifier                    m_id{};
+        lane_column                         m_column{};
+        acme::dynamic_cvector<std::uint8_t> m_declared{};
+    };
+
+    batch_virtual_machine()
+        : batch_virtual_machine{platform::pmr::get_default_resource()}
+        {}
+
+    batch_virtual_machine(platform::pmr::memory_resource* resource)
+        : m_context{resource}
+        {}
+
+    // Bytecode the batch interpreter can run: every instruction except stack frames, native
+    // calls, host objects and parameters of prepared expressions, inputs are bound as variables instead.
+
+    [[nodiscard]] static constexpr auto supports(const bytecode& code) -> bool
+    {
+        for ( const auto ins : code.instructions() )
+        {
+            if ( const auto op = operand(ins); op == opcode::push_stack_frame || op == opcode::pop_stack_frame || op == opcode::load_param || op == opcode::call_native || op == opcode::load_host_field )
+            {
+                return false;
+            }
+        }
+
+        return true;
+    }
+
+    // Run the script once for each of the records. The inputs are declared as variables
+    // before the script runs. Boxed outputs that refer to strings stay valid while the
+    // batch virtual machine is alive.
+
+    auto execute(
+        const bytecode&               code,
+        std::span<const batch_input>  inputs,
+        std::span<const batch_output> outputs,
+        std::size_t                   records
+    ) -> void
+    {
+        if ( std::is_constant_evaluated() == false )
+        {
+            assert(supports(code));
+        }
+
+        m_bytecode = code;
+
+        while ( m_stack.size() < code.max_stack_depth() + 1 )
+        {
+            m_stack.emplace_back(k_lanes);
+        }
+
+        for ( std::size_t first{}; first < records; first += k_lanes )
+        {
+            const auto lanes = std::min(k_lanes, records - first);
+
+            begin_batch(inputs, first, lanes);
+            run_batch(lanes);
+            end_batch(outputs, first, lanes);
+        }
+    }
+
+    // Number of times an instruction was dispatched for a group of lanes.
+
+    [[nodiscard]] constexpr auto dispatch_count() const noexcept -> std::size_t
+    {
+        return m_dispatch_count;
+    }
+
+    private:
+
+    auto begin_batch(std::span<const batch_input> inputs, std::size_t first, std::size_t lanes) -> void
+    {
+        for ( auto& var : m_variables )
+        {
+            std::fill(var.m_declared.begin(), var.m_declared.end(), std::uint8_t{0});
+        }
+
+        for ( const auto& input : inputs )
+        {
+            auto& var = declare(input.m_id);
+
+            for ( std::size_t lane{}; lane < lanes; lane++ )
+            {
+                if ( input.m_numbers.empty() == false )
+                {
+                    var.m_column.m_numbers[lane] = input.m_numbers[first + lane];
+                    var.m_column.m_kinds[lane]   = kind::k_number;
+                }
+
+                else
+                {
+                    var.m_column.set(lane, input.m_values[first + lane]);
+                }
+
+                var.m_declared[lane] = 1;
+            }
+        }
+    }
+
+    auto end_batch(std::span<const batch_output> outputs, std::size_t first, std::size_t lanes) -> void
+    {
+        for ( const auto& output : outputs )
+        {
+            const auto* var = find(output.m_id);
+
+            for ( std::size_t lane{}; lane < lanes; lane++ )
+            {
+                output.m_values[first + lane] = var != nullptr && var->m_declared[lane] ? var->m_column.get(lane) : acme::script_value{acme::undefined{}};
+            }
+        }
+    }
+
+    [[nodiscard]] auto find(acme::identifier id) -> variable*
+    {
+        for ( auto& var : m_variables )
+        {
+            if ( var.m_id == id )
+            {
+                return std::addressof(var);
+            }
+        }
+
+        return nullptr;
+    }
+
+    auto declare(acme::identifier id) -> variable&
+    {
+        if ( auto* var = find(id); var != nullptr )
+        {
+            return *var;
+        }
+
+        auto& var = m_variables.emplace_back();
+
+        var.m_id       = id;
+        var.m_column   = lane_column{k_lanes};
+        var.m_declared = acme::dynamic_cvector<std::uint8_t>(k_lanes);
+
+        return var;
+    }
+
+    auto run_batch(std::size_t lanes) -> void
+    {
+        auto all = lane_group{};
+
+        all.m_lanes.reserve(lanes);
+
+        for ( std::size_t lane{}; lane < lanes; lane++ )
+        {
+            all.m_lanes.push_back(static_cast<std::uint16_t>(lane));
+        }
+
+        m_groups.clear();
+        m_groups.push_back(std::move(all));
+
+        while ( m_groups.empty() == false )
+        {
+            auto group = next_group();
+
+            run_group(group, lanes);
+        }
+    }
+
+    // Take the group with the lowest program counter and merge the groups waiting at the same instruction.
+
+    auto next_group() -> lane_group
+    {
+        auto lowest = std::size_t{};
+
+        for ( std::size_t i = 1; i < m_groups.size(); i++ )
+        {
+            if ( m_groups[i].m_pc < m_groups[lowest].m_pc )
+            {
+                lowest = i;
+            }
+        }
+
+        auto group = std::move(m_groups[lowest]);
+        m_groups.remove_at(lowest);
+
+        for ( std::size_t i{}; i < m_groups.size(); )
+        {
+            if ( m_groups[i].m_pc != group.m_pc )
+            {
+                i++;
+                continue;
+            }
+
+            auto merged = selection_type{};
+
+            merged.resize(group.m_lanes.size() + m_groups[i].m_lanes.size());
+            std::merge(group.m_lanes.begin(), group.m_lanes.end(), m_groups[i].m_lanes.begin(), m_groups[i].m_lanes.end(), merged.begin());
+
+            group.m_lanes = std::move(merged);
+            m_groups.remove_at(i);
+        }
+
+        return group;
+    }
+
+    // Apply f to each lane of the group. A group with every lane of the batch is iterated
+    // as a contiguous range, which the compiler vectorizes for the unboxed loops.
+
+    template <typename F>
+    static constexpr auto for_each_lane(const lane_group& group, std::size_t lanes, F&& f) -> void
+    {
+        if ( group.m_lanes.size() == lanes )
+        {
+            for ( std::size_t lane{}; lane < lanes; lane++ )
+            {
+                f(lane);
+            }
+        }
+
+        else
+        {
+            for ( const auto lane : group.m_lanes )
+            {
+                f(lane);
+            }
+        }
+    }
+
+    auto run_group(lane_group& group, std::size_t lanes) -> void
+    {
+        const auto code = m_bytecode.instructions();
+
+        while ( group.m_pc < code.size() )
+        {
+            const auto ins = code[group.m_pc];
+            const auto op  = generic_opcode(operand(ins));
+            const auto imm = immediate(ins);
+
+            m_dispatch_count += 1;
+            group.m_pc       += 1;
+
+            switch ( op )
+            {
+                case opcode::jump_if_false:
+                case opcode::jump_if_true:
+                {
+                    if ( branch(group, lanes, imm, op == opcode::jump_if_true) )
+                    {
+                        return;
+                    }
+
+                    break;
+                }
+
+                case opcode::jump_to:
+                {
+                    // Yield so that groups left behind can catch up and merge.
+
+                    group.m_pc = imm;
+                    m_groups.push_back(std::move(group));
+
+                    return;
+                }
+
+                case opcode::no_opearation:
+                case opcode::push_stack_frame:
+                case opcode::pop_stack_frame:
+                    break;
+
+                default:
+                    run_op(group, lanes, op, imm);
+                    break;
+            }
+        }
+    }
+
+    // Split the group on a conditional jump. Returns true if the group does not continue.
+
+    auto branch(lane_group& group, std::size_t lanes, std::size_t target, bool jump_if) -> bool
+    {
+        group.m_depth -= 1;
+
+        const auto& cond = m_stack[group.m_depth];
+
+        auto taken = lane_group{ .m_pc = target, .m_depth = group.m_depth, .m_lanes = {} };
+        auto next  = selection_type{};
+
+        for_each_lane(group, lanes, [&](std::size_t lane)
+        {
+            (cond.truthy(lane) == jump_if ? taken.m_lanes : next).push_back(static_cast<std::uint16_t>(lane));
+        });
+
+        if ( taken.m_lanes.empty() )
+        {
+            return false;
+        }
+
+        if ( next.empty() == false )
+        {
+            auto fall = lane_group{ .m_pc = group.m_pc, .m_depth = group.m_depth, .m_lanes = std::move(next) };
+            m_groups.push_back(std::move(fall));
+        }
+
+        m_groups.push_back(std::move(taken));
+
+        return true;
+    }
+
+    auto run_op(lane_group& group, std::size_t lanes, opcode op, std::size_t imm) -> void
+    {
+        auto& depth = group.m_depth;
+
+        switch ( op )
+        {
+            case opcode::constant_double:
+            case opcode::constant_i32:
+            case opcode::constant_u32:
+            {
+                const auto value = to_double(constant(op, imm));
+                auto&      out   = m_stack[depth++];
+
+                for_each_lane(group, lanes, [&](std::size_t lane)
+                {
+                    out.m_numbers[lane] = value;
+                    out.m_kinds[lane]   = kind::k_number;
+                });
+
+                break;
+            }
+
+            case opcode::push_bool_true:
+            case opcode::push_bool_false:
+            {
+                const auto value = op == opcode::push_bool_true ? 1.0 : 0.0;
+                auto&      out   = m_stack[depth++];
+
+                for_each_lane(group, lanes, [&](std::size_t lane)
+                {
+                    out.m_numbers[lane] = value;
+                    out.m_kinds[lane]   = kind::k_boolean;
+                });
+
+                break;
+            }
+
+            case opcode::constant_identifier:
+            case opcode::constant_string:
+            case opcode::push_null:
+            case opcode::push_undefined:
+            {
+                const auto value = constant(op, imm);
+                auto&      out   = m_stack[depth++];
+
+                for_each_lane(group, lanes, [&](std::size_t lane)
+                {
+                    out.m_values[lane] = value;
+                    out.m_kinds[lane]  = kind::k_boxed;
+                });
+
+                break;
+            }
+
+            case opcode::duplicate_top:
+            {
+                const auto& top = m_stack[depth - 1];
+                auto&       out = m_stack[depth++];
+
+                for_each_lane(group, lanes, [&](std::size_t lane)
+                {
+                    out.copy(lane, top);
+                });
+
+                break;
+            }
+
+            case opcode::load_var:
+            {
+                auto& slot = m_stack[depth - 1];
+
+                for_each_var(group, lanes, slot, [&](std::size_t lane, variable* var)
+                {
+                    if ( var != nullptr && var->m_declared[lane] )
+                    {
+                        slot.copy(lane, var->m_column);
+                    }
+
+                    else
+                    {
+                        slot.m_values[lane] = acme::script_value{acme::undefined{}};
+                        slot.m_kinds[lane]  = kind::k_boxed;
+                    }
+                });
+
+                break;
+            }
+
+            case opcode::store_var:
+            {
+                const auto& value = m_stack[depth - 2];
+
+                for_each_var(group, lanes, m_stack[depth - 1], [&](std::size_t lane, variable* var)
+                {
+                    if ( var != nullptr && var->m_declared[lane] )
+                    {
+                        var->m_column.copy(lane, value);
+                    }
+                });
+
+                depth -= 2;
+                break;
+            }
+
+            case opcode::initialize:
+            {
+                const auto& value = m_stack[depth - 1];
+
+                for_each_var<true>(group, lanes, m_stack[depth - 2], [&](std::size_t lane, variable* var)
+                {
+                    var->m_column.copy(lane, value);
+                    var->m_declared[lane] = 1;
+                });
+
+                depth -= 2;
+                break;
+            }
+
+            case opcode::unary_negate:
+            case opcode::typeof_value:
+            case opcode::unary_delete:
+            {
+                auto& slot = m_stack[depth - 1];
+
+                for_each_lane(group, lanes, [&](std::size_t lane)
+                {
+                    slot.set(lane, unary(op, slot.get(lane)));
+                });
+
+                break;
+            }
+
+            default:
+                binary(group, lanes, op);
+                depth -= 1;
+                break;
+        }
+    }
+
+    // Apply f to each lane with the variable named by the identifier in the slot. Emitted
+    // code names the same variable in every lane, which is looked up once.
+
+    template <bool k_declare = false, typename F>
+    auto for_each_var(const lane_group& group, std::size_t lanes, const lane_column& ids, F&& f) -> void
+    {
+        const auto id_of = [&](std::size_t lane) -> acme::identifier
+        {
+            auto value = ids.m_values[lane];
+            return value.as<acme::identifier>();
+        };
+
+        const auto lookup = [&](acme::identifier id) -> variable*
+        {
+            return k_declare ? std::addressof(declare(id)) : find(id);
+        };
+
+        const auto first   = id_of(group.m_lanes.front());
+        auto       uniform = true;
+
+        for_each_lane(group, lanes, [&](std::size_t lane)
+        {
+            uniform = uniform && id_of(lane) == first;
+        });
+
+        if ( uniform )
+        {
+            auto* var = lookup(first);
+
+            for_each_lane(group, lanes, [&](std::size_t lane)
+            {
+                f(lane, var);
+            });
+
+            return;
+        }
+
+        for_each_lane(group, lanes, [&](std::size_t lane)
+        {
+            f(lane, lookup(id_of(lane)));
+        });
+    }
+
+    // Binary operators. Lanes holding numbers in both operands run as a loop over doubles,
+    // other lanes run the operator of the virtual machine on boxed values.
+
+    auto binary(const lane_group& group, std::size_t lanes, opcode op) -> void
+    {
+        const auto& left  = m_stack[group.m_depth - 1];
+        auto&       right = m_stack[group.m_depth - 2];
+
+        auto numbers = true;
+
+        for_each_lane(group, lanes, [&](std::size_t lane)
+        {
+            numbers = numbers && left.m_kinds[lane] == kind::k_number && right.m_kinds[lane] == kind::k_number;
+        });
+
+        if ( numbers && numeric(group, lanes, op, left, right) )
+        {
+            return;
+        }
+
+        for_each_lane(group, lanes, [&](std::size_t lane)
+        {
+            right.set(lane, scalar_binary(op, left.get(lane), right.get(lane)));
+        });
+    }
+
+    [[nodiscard]] auto numeric(
+        const lane_group&  group,
+        std::size_t        lanes,
+        opcode             op,
+        const lane_column& left,
+        lane_column&       right
+    ) -> bool
+    {
+        const auto* l   = left.m_numbers.data();
+        auto*       r   = right.m_numbers.data();
+        auto*       out = right.m_kinds.data();
+
+        const auto apply = [&](kind result_kind, auto&& f)
+        {
+            for_each_lane(group, lanes, [&](std::size_t lane)
+            {
+                r[lane]   = f(l[lane], r[lane]);
+                out[lane] = result_kind;
+            });
+
+            return true;
+        };
+
+        const auto as_bool = [](bool b) { return b ? 1.0 : 0.0; };
+
+        switch ( op )
+        {
+            case opcode::binary_add:
+                return apply(kind::k_number, [](double a, double b) { return a + b; });
+
+            case opcode::binary_sub:
+                return apply(kind::k_number, [](double a, double b) { return a - b; });
+
+            case opcode::binary_mul:
+                return apply(kind::k_number, [](double a, double b) { return a * b; });
+
+            case opcode::compare_less_than:
+                return apply(kind::k_boolean, [&](double a, double b) { return as_bool(b > a); });
+
+            case opcode::compare_less_than_or_equal:
+                return apply(kind::k_boolean, [&](double a, double b) { return as_bool(b >= a); });
+
+            case opcode::compare_greater_than:
+                return apply(kind::k_boolean, [&](double a, double b) { return as_bool(a > b); });
+
+            case opcode::compare_greater_than_or_equal:
+                return apply(kind::k_boolean, [&](double a, double b) { return as_bool(a >= b); });
+
+            case opcode::compare_equal:
+            case opcode::compare_strict_equal:
+                return apply(kind::k_boolean, [&](double a, double b) { return as_bool(a == b); });
+
+            default:
+                return false;
+        }
+    }
+
+    [[nodiscard]] auto constant(opcode op, std::size_t imm) const -> acme::script_value
+    {
+        switch ( op )
+        {
+            case opcode::constant_double:     return m_bytecode.constant<double>(imm);
+            case opcode::constant_i32:        return m_bytecode.constant<std::int32_t>(imm);
+            case opcode::constant_u32:        return m_bytecode.constant<std::uint32_t>(imm);
+            case opcode::constant_identifier: return m_bytecode.constant<acme::identifier>(imm);
+            case opcode::constant_string:     return m_bytecode.constant<acme::string>(imm);
+            case opcode::push_null:           return acme::script_value{std::nullptr_t{}};
+            default:                          return acme::script_value{acme::undefined{}};
+        }
+    }
+
+    [[nodiscard]] static auto unary(opcode op, acme::script_value v) -> acme::script_value
+    {
+        switch ( op )
+        {
+            case opcode::unary_negate: return op_negate(v);
+            case opcode::typeof_value: return value_typeof_s(v);
+            default:                   return acme::script_value{acme::boolean{true}};
+        }
+    }
+
+    [[nodiscard]] auto scalar_binary(opcode op, acme::script_value left, acme::script_value right) -> acme::script_value
+    {
+        switch ( op )
+        {
+            case opcode::binary_add:                    return op_add(m_context, left, right);
+            case opcode::binary_sub:                    return op_sub(left, right);
+            case opcode::binary_mul:                    return op_mul(left, right);
+            case opcode::binary_div:                    return op_div(left, right);
+            case opcode::binary_mod:                    return op_mod(left, right);
+            case opcode::binary_pow:                    return op_pow(left, right);
+            case opcode::compare_strict_equal:          return op_strict_equal(m_context, left, right);
+            case opcode::compare_equal:                 return op_equal(m_context, left, right);
+            case opcode::compare_less_than:             return op_greater_than(right, left);
+            case opcode::compare_less_than_or_equal:    return op_greater_than_or_equal(right, left);
+            case opcode::compare_greater_than:          return op_greater_than(left, right);
+            case opcode::compare_greater_than_or_equal: return op_greater_than_or_equal(left, right);
+            case opcode::compare_instanceof:            return op_instanceof(left, right);
+            default:                                    return {};
+        }
+    }
+
+    // Strings created by the operators are interned in the pool of this virtual machine.
+
+    acme::virtual_machine              m_context{};
+    bytecode                           m_bytecode{};
+    acme::dynamic_cvector<lane_column> m_stack{};
+    acme::dynamic_cvector<variable>    m_variables{};
+    acme::dynamic_cvector<lane_group>  m_groups{};
+    std::size_t                        m_dispatch_count{};
+};
+
+} // namespace acme
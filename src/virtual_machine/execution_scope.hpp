@@ -2,16 +2,69 @@
 
 namespace acme {
 
+// Variables of all active scopes are stored back to back in one array. A scope only
+// records where its own variables begin, entering or leaving a scope is an index update.
+
 struct execution_scope
 {
-    using var_stack_type = acme::containers::var_stack<24>;
+    std::size_t m_locals_begin{};
+};
+
+// Variables declared in one scope. A view over the locals array of the virtual machine
+// that is valid until a scope is entered or left.
+
+struct scope_locals
+{
+    using item_type          = std::pair<acme::identifier, acme::script_value>;
+    using locals_type        = acme::dynamic_cvector<item_type>;
+    using index_type         = std::size_t;
+    using optional_reference = std::optional<std::reference_wrapper<acme::script_value>>;
+
+    // Declare a variable in the scope. Declaring it again in the same scope assigns the value,
+    // so a declaration in a loop body does not add a variable in each iteration.
+
+    template <typename V>
+    constexpr void push(acme::identifier id, V&& value)
+    {
+        if ( auto var = get(id); var.has_value() )
+        {
+            var.value().get().assign(acme::script_value{std::forward<V>(value)});
+            return;
+        }
+
+        m_locals->emplace_back(id, acme::script_value{std::forward<V>(value)});
+    }
+
+    [[nodiscard]] constexpr auto get(acme::identifier id) const -> optional_reference
+    {
+        for ( auto i = m_locals->size(); i > m_begin; --i )
+        {
+            if ( auto& [idc, v] = (*m_locals)[i - 1]; idc == id )
+            {
+                return std::reference_wrapper{v};
+            }
+        }
+
+        return {};
+    }
+
+    [[nodiscard]] constexpr auto operator[](index_type i) const -> item_type&
+    {
+        return (*m_locals)[m_begin + i];
+    }
+
+    [[nodiscard]] constexpr auto size() const noexcept
+    {
+        return m_locals->size() - m_begin;
+    }
 
-    [[nodiscard]] auto locals() -> var_stack_type&
+    [[nodiscard]] constexpr bool empty() const noexcept
     {
-        return m_locals;
+        return size() == 0;
     }
 
-    var_stack_type m_locals{};
+    locals_type* m_locals{};
+    index_type   m_begin{};
 };
 
 } // namespace acme
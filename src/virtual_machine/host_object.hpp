@@ -0,0 +1,170 @@
+#pragma once
+
+namespace acme {
+
+// Getter of a host type, called with the address of the host object.
+
+using host_getter = acme::script_value (*)(acme::virtual_machine&, const void*);
+
+// Host object bound to a slot of the virtual machine. The memory is read in place.
+
+struct host_object
+{
+    const void*        m_data{};
+    const host_getter* m_getters{};
+};
+
+namespace detail {
+
+template <typename M>
+[[nodiscard]] consteval auto host_field_type_for() -> acme::host_field_type
+{
+    static_assert(std::is_arithmetic_v<M>, "Unsupported host field type");
+
+    if constexpr ( std::is_same_v<M, bool> )
+    {
+        return acme::host_field_type::k_bool;
+    }
+
+    else if constexpr ( std::is_same_v<M, double> )
+    {
+        return acme::host_field_type::k_f64;
+    }
+
+    else if constexpr ( std::is_same_v<M, float> )
+    {
+        return acme::host_field_type::k_f32;
+    }
+
+    else if constexpr ( sizeof(M) == 8u )
+    {
+        return std::is_signed_v<M> ? acme::host_field_type::k_i64 : acme::host_field_type::k_u64;
+    }
+
+    else if constexpr ( sizeof(M) == 4u )
+    {
+        return std::is_signed_v<M> ? acme::host_field_type::k_i32 : acme::host_field_type::k_u32;
+    }
+
+    else if constexpr ( sizeof(M) == 2u )
+    {
+        return std::is_signed_v<M> ? acme::host_field_type::k_i16 : acme::host_field_type::k_u16;
+    }
+
+    else
+    {
+        return std::is_signed_v<M> ? acme::host_field_type::k_i8 : acme::host_field_type::k_u8;
+    }
+}
+
+template <typename T>
+struct host_member_traits;
+
+template <typename M, typename T>
+struct host_member_traits<M T::*>
+{
+    using member_type = M;
+    using class_type  = T;
+};
+
+} // namespace detail
+
+/* Description of a C++ type whose objects scripts read in place:
+
+       struct order { double price; std::int32_t quantity; };
+
+       acme::host_type<order> order_type{};
+       order_type.field<&order::price>("price");
+       order_type.field<&order::quantity>("quantity");
+       order_type.getter<[](const order& o) { return o.price * o.quantity; }>("total");
+
+       const acme::host_binding bindings[] = { order_type.binding("o") };
+       context.host_objects(bindings);                                  // Before emitting "o.price > 10".
+
+       const acme::host_object objects[] = { order_type.object(record) };
+       vm.host_objects(objects);                                        // Before executing it.
+
+    The emitter resolves o.price to a load of the slot and the byte offset of the field, no
+    names are looked up and no values are copied into script objects when the script runs.
+*/
+
+template <typename T>
+struct host_type
+{
+    static_assert(std::is_standard_layout_v<T>, "Host types must have a standard layout");
+
+    // Field described by a pointer to a data member.
+
+    template <auto k_member>
+    auto field(std::string_view name) -> host_type&
+    {
+        using traits = detail::host_member_traits<decltype(k_member)>;
+
+        static_assert(std::is_same_v<typename traits::class_type, T>);
+
+        alignas(T) std::byte storage[sizeof(T)]{};
+
+        const auto* object = reinterpret_cast<const T*>(storage);
+        const auto  offset = reinterpret_cast<const std::byte*>(std::addressof(object->*k_member)) - storage;
+
+        return field(name, static_cast<std::size_t>(offset), detail::host_field_type_for<std::remove_cv_t<typename traits::member_type>>());
+    }
+
+    // Field at a byte offset of the object.
+
+    auto field(
+        std::string_view      name,
+        std::size_t           offset,
+        acme::host_field_type type
+    ) -> host_type&
+    {
+        if ( std::is_constant_evaluated() == false )
+        {
+            assert(offset <= acme::k_max_host_field_offset);
+        }
+
+        m_fields.push_back(acme::host_field{ .m_name = acme::identifier{name}, .m_type = type, .m_offset = static_cast<std::uint16_t>(offset) });
+
+        return *this;
+    }
+
+    // Field computed by a function of the object, e.g. a lambda or a const member function.
+
+    template <auto k_getter>
+    auto getter(std::string_view name) -> host_type&
+    {
+        m_fields.push_back(acme::host_field{ .m_name = acme::identifier{name}, .m_type = acme::host_field_type::k_getter, .m_offset = static_cast<std::uint16_t>(m_getters.size()) });
+        m_getters.push_back([](acme::virtual_machine& vm, const void* data) -> acme::script_value
+        {
+            return detail::native_result(vm, std::invoke(k_getter, *static_cast<const T*>(data)));
+        });
+
+        return *this;
+    }
+
+    [[nodiscard]] auto fields() const noexcept -> std::span<const acme::host_field>
+    {
+        return std::span{m_fields};
+    }
+
+    // Binding for the emitter. The host type must outlive the emitter.
+
+    [[nodiscard]] auto binding(std::string_view name) const noexcept -> acme::host_binding
+    {
+        return acme::host_binding{ .m_name = acme::identifier{name}, .m_fields = fields() };
+    }
+
+    // Host object for the virtual machine. The record and the host type must outlive the execution.
+
+    [[nodiscard]] auto object(const T& record) const noexcept -> acme::host_object
+    {
+        return acme::host_object{ .m_data = std::addressof(record), .m_getters = m_getters.data() };
+    }
+
+    private:
+
+    acme::dynamic_cvector<acme::host_field> m_fields{};
+    acme::dynamic_cvector<host_getter>      m_getters{};
+};
+
+} // namespace acme
@@ -0,0 +1,175 @@
+#pragma once
+
+#if defined(ACME_JS_JIT)
+
+namespace acme::jit {
+
+// Minimal x86-64 encoder for the handful of instructions used by the baseline compiler.
+
+struct x64_assembler
+{
+    using code_type = acme::dynamic_cvector<std::uint8_t>;
+
+    [[nodiscard]] auto position() const noexcept
+    {
+        return m_code.size();
+    }
+
+    [[nodiscard]] auto code() const -> std::span<const std::uint8_t>
+    {
+        return {m_code.data(), m_code.size()};
+    }
+
+    void bytes(std::initializer_list<std::uint8_t> b)
+    {
+        for ( auto v : b )
+        {
+            m_code.push_back(v);
+        }
+    }
+
+    void imm32(std::uint32_t v)
+    {
+        for ( auto i = 0u; i < 4u; ++i )
+        {
+            m_code.push_back(static_cast<std::uint8_t>(v >> (i * 8u)));
+        }
+    }
+
+    void imm64(std::uint64_t v)
+    {
+        for ( auto i = 0u; i < 8u; ++i )
+        {
+            m_code.push_back(static_cast<std::uint8_t>(v >> (i * 8u)));
+        }
+    }
+
+    void patch32(std::size_t at, std::uint32_t v)
+    {
+        for ( auto i = 0u; i < 4u; ++i )
+        {
+            m_code[at + i] = static_cast<std::uint8_t>(v >> (i * 8u));
+        }
+    }
+
+    void align(std::size_t alignment)
+    {
+        while ( position() % alignment != 0 )
+        {
+            bytes({ 0xCC });
+        }
+    }
+
+    // push rbx
+
+    void push_rbx() { bytes({ 0x53 }); }
+
+    // pop rbx
+
+    void pop_rbx() { bytes({ 0x5B }); }
+
+    // ret
+
+    void ret() { bytes({ 0xC3 }); }
+
+    // mov rbx, rdi
+
+    void mov_rbx_rdi() { bytes({ 0x48, 0x89, 0xFB }); }
+
+    // mov rdi, rbx
+
+    void mov_rdi_rbx() { bytes({ 0x48, 0x89, 0xDF }); }
+
+    // mov esi, imm32
+
+    void mov_esi(std::uint32_t v)
+    {
+        bytes({ 0xBE });
+        imm32(v);
+    }
+
+    // mov edx, imm32
+
+    void mov_edx(std::uint32_t v)
+    {
+        bytes({ 0xBA });
+        imm32(v);
+    }
+
+    // mov rax, imm64 ; call rax
+
+    void call(auto* target)
+    {
+        bytes({ 0x48, 0xB8 });
+        imm64(reinterpret_cast<std::uintptr_t>(target));
+        bytes({ 0xFF, 0xD0 });
+    }
+
+    // test al, al
+
+    void test_al() { bytes({ 0x84, 0xC0 }); }
+
+    // jmp rel32, returns the offset of the displacement to patch.
+
+    [[nodiscard]] auto jmp() -> std::size_t
+    {
+        bytes({ 0xE9 });
+        imm32(0);
+
+        return position() - 4;
+    }
+
+    // je rel32, returns the offset of the displacement to patch.
+
+    [[nodiscard]] auto je() -> std::size_t
+    {
+        bytes({ 0x0F, 0x84 });
+        imm32(0);
+
+        return position() - 4;
+    }
+
+    // jne rel32, returns the offset of the displacement to patch.
+
+    [[nodiscard]] auto jne() -> std::size_t
+    {
+        bytes({ 0x0F, 0x85 });
+        imm32(0);
+
+        return position() - 4;
+    }
+
+    // lea rax, [rip + disp32], returns the offset of the displacement to patch.
+
+    [[nodiscard]] auto lea_rax_rip() -> std::size_t
+    {
+        bytes({ 0x48, 0x8D, 0x05 });
+        imm32(0);
+
+        return position() - 4;
+    }
+
+    // movsxd rcx, dword [rax + rsi * 4] ; add rax, rcx ; jmp rax
+
+    void jmp_table_rax_rsi()
+    {
+        bytes({ 0x48, 0x63, 0x0C, 0xB0 });
+        bytes({ 0x48, 0x01, 0xC8 });
+        bytes({ 0xFF, 0xE0 });
+    }
+
+    // Patch a rel32 displacement at `at` to branch to `target`.
+
+    void bind(std::size_t at, std::size_t target)
+    {
+        patch32(at, static_cast<std::uint32_t>(static_cast<std::int64_t>(target) - static_cast<std::int64_t>(at + 4)));
+    }
+
+    private:
+
+    code_type m_code{};
+};
+
+} // namespace acme::jit
+
+#endif /* ACME_JS_JIT */
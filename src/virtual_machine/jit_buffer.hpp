@@ -0,0 +1,97 @@
+#pragma once
+
+#if defined(ACME_JS_ENABLE_JIT) && defined(__x86_64__) && defined(__linux__)
+#define ACME_JS_JIT 1
+#endif
+
+#if defined(ACME_JS_JIT)
+
+#include <sys/mman.h>
+
+namespace acme::jit {
+
+struct executable_buffer
+{
+    constexpr executable_buffer() = default;
+
+    explicit executable_buffer(std::span<const std::uint8_t> code)
+    {
+        // Map the pages writable first and flip them to executable once the code is copied.
+
+        auto* ptr = ::mmap(nullptr, code.size(), PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+
+        if ( ptr == MAP_FAILED )
+        {
+            return;
+        }
+
+        std::memcpy(ptr, code.data(), code.size());
+
+        if ( ::mprotect(ptr, code.size(), PROT_READ | PROT_EXEC) != 0 )
+        {
+            ::munmap(ptr, code.size());
+            return;
+        }
+
+        m_data = static_cast<std::uint8_t*>(ptr);
+        m_size = code.size();
+    }
+
+    executable_buffer(const executable_buffer&) = delete;
+    executable_buffer& operator=(const executable_buffer&) = delete;
+
+    executable_buffer(executable_buffer&& other) noexcept
+        : m_data{std::exchange(other.m_data, nullptr)}
+        , m_size{std::exchange(other.m_size, 0)}
+    {}
+
+    executable_buffer& operator=(executable_buffer&& other) noexcept
+    {
+        reset();
+
+        m_data = std::exchange(other.m_data, nullptr);
+        m_size = std::exchange(other.m_size, 0);
+
+        return *this;
+    }
+
+    ~executable_buffer()
+    {
+        reset();
+    }
+
+    void reset()
+    {
+        if ( m_data != nullptr )
+        {
+            ::munmap(m_data, m_size);
+        }
+
+        m_data = nullptr;
+        m_size = 0;
+    }
+
+    [[nodiscard]] auto data() const noexcept -> const std::uint8_t*
+    {
+        return m_data;
+    }
+
+    [[nodiscard]] auto size() const noexcept
+    {
+        return m_size;
+    }
+
+    [[nodiscard]] auto empty() const noexcept
+    {
+        return m_data == nullptr;
+    }
+
+    private:
+
+    std::uint8_t* m_data{};
+    std::size_t   m_size{};
+};
+
+} // namespace acme::jit
+
+#endif /* ACME_JS_JIT */
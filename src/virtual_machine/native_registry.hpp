@@ -0,0 +1,235 @@
+#pragma once
+
+namespace acme {
+
+namespace detail {
+
+// Signature of a native function: a function pointer, or a callable object with one call operator.
+
+template <typename F>
+struct native_traits : native_traits<decltype(&F::operator())> {};
+
+template <typename R, typename... A>
+struct native_traits<R (*)(A...)>
+{
+    using signature_type = std::type_identity<R (A...)>;
+
+    static constexpr auto k_arity = static_cast<std::uint8_t>(sizeof...(A));
+};
+
+template <typename R, typename... A>
+struct native_traits<R (*)(A...) noexcept> : native_traits<R (*)(A...)> {};
+
+template <typename R, typename C, typename... A>
+struct native_traits<R (C::*)(A...)> : native_traits<R (*)(A...)> {};
+
+template <typename R, typename C, typename... A>
+struct native_traits<R (C::*)(A...) const> : native_traits<R (*)(A...)> {};
+
+template <typename R, typename C, typename... A>
+struct native_traits<R (C::*)(A...) noexcept> : native_traits<R (*)(A...)> {};
+
+template <typename R, typename C, typename... A>
+struct native_traits<R (C::*)(A...) const noexcept> : native_traits<R (*)(A...)> {};
+
+// Conversion of an operand stack value to an argument of a native function. Strings are
+// passed as views, numbers converted to a string are formatted into the buffer.
+
+template <typename T>
+struct native_argument
+{
+    using buffer_type = std::monostate;
+
+    static_assert(std::is_same_v<T, acme::script_value> || std::is_arithmetic_v<T>, "Unsupported native argument type");
+
+    [[nodiscard]] static constexpr auto get(const acme::script_value& v, buffer_type&) -> T
+    {
+        if constexpr ( std::is_same_v<T, acme::script_value> )
+        {
+            return v;
+        }
+
+        else if constexpr ( std::is_same_v<T, bool> )
+        {
+            return to_boolean(v);
+        }
+
+        else
+        {
+            return static_cast<T>(to_double(v));
+        }
+    }
+};
+
+template <>
+struct native_argument<std::string_view>
+{
+    using buffer_type = numeric::number_string_buffer;
+
+    [[nodiscard]] static constexpr auto get(const acme::script_value& v, buffer_type& buffer) -> std::string_view
+    {
+        return to_string(v, buffer);
+    }
+};
+
+// Conversion of the value returned by a native function.
+
+template <typename R>
+[[nodiscard]] constexpr auto native_result(acme::virtual_machine& vm, R&& result) -> acme::script_value
+{
+    using type = std::remove_cvref_t<R>;
+
+    if constexpr ( std::is_same_v<type, acme::script_value> )
+    {
+        return result;
+    }
+
+    else if constexpr ( std::is_same_v<type, bool> )
+    {
+        return acme::script_value{acme::boolean{result}};
+    }
+
+    else if constexpr ( std::is_arithmetic_v<type> )
+    {
+        return acme::script_value{acme::number{static_cast<double>(result)}};
+    }
+
+    else
+    {
+        static_assert(std::is_convertible_v<const type&, std::string_view>, "Unsupported native result type");
+
+        if ( const auto text = std::string_view{result}; text.empty() == false )
+        {
+            return acme::script_value{acme::string{vm.string_pool().intern(text)}};
+        }
+
+        return acme::script_value{acme::string{std::string_view{}}};
+    }
+}
+
+// Call the function with the arguments on top of the operand stack and replace them with the result.
+
+template <typename F, typename R, typename... A>
+constexpr auto invoke_native(
+    acme::virtual_machine& vm,
+    F&&                    f,
+    std::type_identity<R (A...)>
+) -> void
+{
+    auto&      stack   = vm.stack();
+    const auto base    = stack.size() - sizeof...(A);
+    auto       buffers = std::tuple<typename native_argument<std::remove_cvref_t<A>>::buffer_type...>{};
+
+    auto result = [&]<std::size_t... I>(std::index_sequence<I...>) -> acme::script_value
+    {
+        if constexpr ( std::is_void_v<R> )
+        {
+            f(native_argument<std::remove_cvref_t<A>>::get(stack.get(base + I), std::get<I>(buffers))...);
+            return acme::script_value{acme::undefined{}};
+        }
+
+        else
+        {
+            return native_result(vm, f(native_argument<std::remove_cvref_t<A>>::get(stack.get(base + I), std::get<I>(buffers))...));
+        }
+    }(std::index_sequence_for<A...>{});
+
+    for ( std::size_t i{}; i < sizeof...(A); i++ )
+    {
+        stack.pop_back();
+    }
+
+    stack.push_back(std::move(result));
+}
+
+} // namespace detail
+
+/* Native functions callable from scripts with call_native. Each function is called through a
+   trampoline generated for its signature, which converts the arguments on the operand stack
+   and pushes the result:
+
+       static auto distance(double x, double y) -> double { return std::hypot(x, y); }
+
+       acme::native_registry natives{};
+       natives.add<&distance>("distance");
+
+       context.natives(natives.signatures());  // Before emitting the script.
+       vm.natives(std::addressof(natives));     // Before executing it.
+
+    Arguments are numbers, booleans, std::string_view or acme::script_value. Results are
+    numbers, booleans, strings or acme::script_value, void functions return undefined.
+*/
+
+struct native_registry
+{
+    using trampoline_type = void (*)(acme::virtual_machine&, void*);
+
+    struct binding
+    {
+        trampoline_type m_trampoline{};
+        void*           m_state{};
+    };
+
+    // Register a function known at compile time.
+
+    template <auto k_function>
+    auto add(std::string_view name) -> std::size_t
+    {
+        using traits = detail::native_traits<std::remove_cvref_t<decltype(k_function)>>;
+
+        return add(name, traits::k_arity, [](acme::virtual_machine& vm, void*)
+        {
+            detail::invoke_native(vm, k_function, typename traits::signature_type{});
+        }, nullptr);
+    }
+
+    // Register a callable object. The registry keeps a reference to it.
+
+    template <typename F>
+    auto add(std::string_view name, F& callable) -> std::size_t
+    {
+        using traits = detail::native_traits<std::remove_cvref_t<F>>;
+
+        return add(name, traits::k_arity, [](acme::virtual_machine& vm, void* state)
+        {
+            detail::invoke_native(vm, *static_cast<F*>(state), typename traits::signature_type{});
+        }, const_cast<void*>(static_cast<const void*>(std::addressof(callable))));
+    }
+
+    [[nodiscard]] auto signatures() const noexcept -> std::span<const acme::native_signature>
+    {
+        return std::span{m_signatures};
+    }
+
+    [[nodiscard]] auto size() const noexcept -> std::size_t
+    {
+        return m_bindings.size();
+    }
+
+    auto call(acme::virtual_machine& vm, std::size_t index) const -> void
+    {
+        const auto& binding = m_bindings[index];
+
+        binding.m_trampoline(vm, binding.m_state);
+    }
+
+    private:
+
+    auto add(
+        std::string_view name,
+        std::uint8_t     arity,
+        trampoline_type  trampoline,
+        void*            state
+    ) -> std::size_t
+    {
+        m_signatures.push_back(acme::native_signature{ .m_name = acme::identifier{name}, .m_arity = arity });
+        m_bindings.push_back(binding{ .m_trampoline = trampoline, .m_state = state });
+
+        return m_bindings.size() - 1;
+    }
+
+    acme::dynamic_cvector<acme::native_signature> m_signatures{};
+    acme::dynamic_cvector<binding>                m_bindings{};
+};
+
+} // namespace acme
@@ -0,0 +1,171 @@
+#pragma once
+
+namespace acme {
+
+enum class object_kind : std::uint8_t
+{
+    k_object = 0u,
+    k_array,
+};
+
+// Storage of an object or array. Properties of an object are kept in insertion order with the
+// keys parallel to the values, a key added again shadows the earlier one.
+
+struct object_data
+{
+    using keys_type   = acme::dynamic_cvector<acme::string>;
+    using values_type = acme::dynamic_cvector<acme::script_value>;
+
+    explicit constexpr object_data(object_kind kind) noexcept
+        : m_kind{kind}
+        {}
+
+    [[nodiscard]] constexpr auto kind() const noexcept -> object_kind
+    {
+        return m_kind;
+    }
+
+    [[nodiscard]] constexpr auto is_array() const noexcept -> bool
+    {
+        return m_kind == object_kind::k_array;
+    }
+
+    // Number of properties or array elements.
+
+    [[nodiscard]] constexpr auto size() const noexcept -> std::size_t
+    {
+        return m_values.size();
+    }
+
+    [[nodiscard]] constexpr auto keys() const noexcept -> std::span<const acme::string>
+    {
+        return std::span{m_keys};
+    }
+
+    [[nodiscard]] constexpr auto values() const noexcept -> std::span<const acme::script_value>
+    {
+        return std::span{m_values};
+    }
+
+    // Property of an object, undefined if missing.
+
+    [[nodiscard]] constexpr auto get(std::string_view key) const -> acme::script_value
+    {
+        for ( auto i = m_keys.size(); i > 0; --i )
+        {
+            if ( m_keys[i - 1].value() == key )
+            {
+                return m_values[i - 1];
+            }
+        }
+
+        return acme::script_value{acme::undefined{}};
+    }
+
+    // Element of an array, undefined if out of range.
+
+    [[nodiscard]] constexpr auto at(std::size_t index) const -> acme::script_value
+    {
+        if ( index >= m_values.size() )
+        {
+            return acme::script_value{acme::undefined{}};
+        }
+
+        return m_values[index];
+    }
+
+    constexpr auto reserve(std::size_t count)
+    {
+        if ( m_kind == object_kind::k_object )
+        {
+            m_keys.reserve(count);
+        }
+
+        m_values.reserve(count);
+    }
+
+    constexpr auto push_back(acme::script_value value)
+    {
+        if ( std::is_constant_evaluated() == false )
+        {
+            assert(m_kind == object_kind::k_array);
+        }
+
+        m_values.push_back(std::move(value));
+    }
+
+    constexpr auto insert(
+        acme::string       key,
+        acme::script_value value
+    )
+    {
+        if ( std::is_constant_evaluated() == false )
+        {
+            assert(m_kind == object_kind::k_object);
+        }
+
+        m_keys.push_back(std::move(key));
+        m_values.push_back(std::move(value));
+    }
+
+    private:
+
+    object_kind m_kind{};
+    keys_type   m_keys{};
+    values_type m_values{};
+};
+
+/* Objects and arrays created by a virtual machine. Objects are released with the heap, or all at
+   once with clear(), there is no collection of unreachable objects. Values referring to an
+   object must not be used after it is released.
+*/
+
+struct object_heap
+{
+    using objects_type = acme::dynamic_cvector<acme::unique_ptr<acme::object_data>>;
+
+    constexpr object_heap() = default;
+
+    explicit constexpr object_heap(platform::pmr::memory_resource* resource) noexcept
+        : m_resource{resource}
+        {}
+
+    object_heap(const object_heap&)            = delete;
+    object_heap& operator=(const object_heap&) = delete;
+
+    [[nodiscard]] auto make_object() -> acme::object
+    {
+        return make(object_kind::k_object);
+    }
+
+    [[nodiscard]] auto make_array() -> acme::object
+    {
+        return make(object_kind::k_array);
+    }
+
+    [[nodiscard]] constexpr auto size() const noexcept -> std::size_t
+    {
+        return m_objects.size();
+    }
+
+    constexpr auto clear()
+    {
+        m_objects.clear();
+    }
+
+    private:
+
+    auto make(object_kind kind) -> acme::object
+    {
+        auto* resource = m_resource != nullptr ? m_resource : platform::pmr::get_default_resource();
+
+        m_objects.push_back(acme::make_unique<acme::object_data>(resource, kind));
+
+        return acme::object{m_objects.back().get()};
+    }
+
+    platform::pmr::memory_resource* m_resource{};
+    objects_type                    m_objects{};
+};
+
+} // namespace acme
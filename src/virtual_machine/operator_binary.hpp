@@ -2,7 +2,7 @@
 
 namespace acme {
 
-template<opcode k_op>
+template<opcode k_op, bool k_checked = true>
 constexpr void binary_op(virtual_machine& vm)
 {
     /* BinaryExpression:
@@ -15,8 +15,15 @@ constexpr void binary_op(virtual_machine& vm)
             [result]
     */
 
-    auto left  = vm.stack().pop_back();
-    auto right = vm.stack().pop_back();
+    auto left  = vm.stack().pop_back<k_checked>();
+    auto right = vm.stack().pop_back<k_checked>();
+
+    // Record operand types, the instruction is quickened once the feedback is monomorphic.
+
+    if constexpr ( quickened_opcode(k_op, operand_types::numbers) != k_op )
+    {
+        vm.record_feedback(k_op, left, right);
+    }
 
     auto result = [&]() -> acme::script_value
     {
@@ -113,7 +120,7 @@ constexpr void binary_op(virtual_machine& vm)
 
     }();
 
-    vm.stack().push_back(result);
+    vm.stack().push_back<k_checked>(result);
 }
 
 } // namespace acme
@@ -2,7 +2,7 @@
 
 namespace acme {
 
-template<opcode k_op>
+template<opcode k_op, bool k_checked = true>
 void constant_op(virtual_machine& vm)
 {
     const auto offset = vm.current_immediate();
@@ -11,40 +11,40 @@ void constant_op(virtual_machine& vm)
 
     if constexpr ( k_op == opcode::constant_double )
     {
-        auto v = vm.constant<double>(offset);
-        vm.stack().push_back(v);
+        auto v = vm.constant<double, k_checked>(offset);
+        vm.stack().push_back<k_checked>(v);
     }
 
     // Load signed 32-bit integer from the program memory.
 
     else if constexpr ( k_op == opcode::constant_i32 )
     {
-        auto v = vm.constant<std::int32_t>(offset);
-        vm.stack().push_back(v);
+        auto v = vm.constant<std::int32_t, k_checked>(offset);
+        vm.stack().push_back<k_checked>(v);
     }
 
     // Load unsigned 32-bit integer from the program memory.
 
     else if constexpr ( k_op == opcode::constant_u32 )
     {
-        auto v = vm.constant<std::uint32_t>(offset);
-        vm.stack().push_back(v);
+        auto v = vm.constant<std::uint32_t, k_checked>(offset);
+        vm.stack().push_back<k_checked>(v);
     }
 
     // Load identifier from the program memory.
 
     else if constexpr ( k_op == opcode::constant_identifier )
     {
-        auto v = vm.constant<acme::identifier>(offset);
-        vm.stack().push_back(v);
+        auto v = vm.constant<acme::identifier, k_checked>(offset);
+        vm.stack().push_back<k_checked>(v);
     }
 
     // Load string literal from the program memory.
 
     else if constexpr ( k_op == opcode::constant_string )
     {
-        auto v = vm.constant<acme::string>(offset);
-        vm.stack().push_back(v);
+        auto v = vm.constant<acme::string, k_checked>(offset);
+        vm.stack().push_back<k_checked>(v);
     }
 }
 
@@ -0,0 +1,98 @@
+#pragma once
+
+namespace acme {
+
+namespace detail {
+
+template <typename T>
+[[nodiscard]] inline auto load_host_value(const std::byte* data) noexcept -> T
+{
+    T value;
+    std::memcpy(std::addressof(value), data, sizeof(T));
+
+    return value;
+}
+
+} // namespace detail
+
+// Load a field of a host object. The slot and offset were resolved by the emitter. Host objects
+// are bound at run time, so a missing one is checked for even in verified bytecode.
+
+template <bool k_checked = true>
+void host_op(virtual_machine& vm)
+{
+    const auto imm     = vm.current_immediate();
+    const auto slot    = host_field_slot(imm);
+    const auto objects = vm.host_objects();
+
+    if ( slot >= objects.size() || objects[slot].m_data == nullptr )
+    {
+        vm.stack().push_back<k_checked>(acme::script_value{acme::undefined{}});
+        return;
+    }
+
+    const auto& object = objects[slot];
+    const auto* data   = static_cast<const std::byte*>(object.m_data) + host_field_offset(imm);
+
+    const auto number = [&]<typename T>(std::type_identity<T>)
+    {
+        vm.stack().push_back<k_checked>(acme::script_value{acme::number{static_cast<double>(detail::load_host_value<T>(data))}});
+    };
+
+    switch ( host_field_type_of(imm) )
+    {
+        case host_field_type::k_f64:
+            number(std::type_identity<double>{});
+            break;
+
+        case host_field_type::k_f32:
+            number(std::type_identity<float>{});
+            break;
+
+        case host_field_type::k_i64:
+            number(std::type_identity<std::int64_t>{});
+            break;
+
+        case host_field_type::k_u64:
+            number(std::type_identity<std::uint64_t>{});
+            break;
+
+        case host_field_type::k_i32:
+            number(std::type_identity<std::int32_t>{});
+            break;
+
+        case host_field_type::k_u32:
+            number(std::type_identity<std::uint32_t>{});
+            break;
+
+        case host_field_type::k_i16:
+            number(std::type_identity<std::int16_t>{});
+            break;
+
+        case host_field_type::k_u16:
+            number(std::type_identity<std::uint16_t>{});
+            break;
+
+        case host_field_type::k_i8:
+            number(std::type_identity<std::int8_t>{});
+            break;
+
+        case host_field_type::k_u8:
+            number(std::type_identity<std::uint8_t>{});
+            break;
+
+        case host_field_type::k_bool:
+            vm.stack().push_back<k_checked>(acme::script_value{acme::boolean{detail::load_host_value<bool>(data)}});
+            break;
+
+        case host_field_type::k_getter:
+            vm.stack().push_back<k_checked>(object.m_getters[host_field_offset(imm)](vm, object.m_data));
+            break;
+
+        default:
+            vm.stack().push_back<k_checked>(acme::script_value{acme::undefined{}});
+            break;
+    }
+}
+
+} // namespace acme
@@ -0,0 +1,29 @@
+#pragma once
+
+namespace acme {
+
+// Call a native function with the arguments on top of the operand stack. Calls to functions
+// missing from the registry of the virtual machine replace the arguments with undefined.
+
+template <bool k_checked = true>
+void native_op(virtual_machine& vm)
+{
+    const auto index    = native_call_index(vm.current_immediate());
+    const auto arity    = native_call_arity(vm.current_immediate());
+    const auto registry = vm.natives();
+
+    if ( registry == nullptr || index >= registry->size() )
+    {
+        for ( std::size_t i{}; i < arity; i++ )
+        {
+            vm.stack().pop_back<k_checked>();
+        }
+
+        vm.stack().push_back<k_checked>(acme::script_value{acme::undefined{}});
+        return;
+    }
+
+    registry->call(vm, index);
+}
+
+} // namespace acme
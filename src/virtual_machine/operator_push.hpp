@@ -2,7 +2,7 @@
 
 namespace acme {
 
-template <opcode k_op>
+template <opcode k_op, bool k_checked = true>
 void push_op(virtual_machine& vm)
 {
     auto result = [&]() constexpr -> acme::script_value
@@ -36,7 +36,7 @@ void push_op(virtual_machine& vm)
         }
     }();
 
-    vm.stack().push_back(result);
+    vm.stack().push_back<k_checked>(result);
 }
 
 } // namespace acme
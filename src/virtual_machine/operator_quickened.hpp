@@ -0,0 +1,128 @@
+#pragma once
+
+namespace acme {
+
+template<opcode k_op, bool k_checked = true>
+void quickened_op(virtual_machine& vm)
+{
+    /* Quickened BinaryExpression:
+
+        Stack on entry:
+            [left]
+            [right]
+
+        Stack on exit
+            [result]
+    */
+
+    constexpr auto k_generic_op = generic_opcode(k_op);
+
+    const auto& stack = vm.stack();
+    const auto& left  = stack.get(stack.size() - 1);
+    const auto& right = stack.get(stack.size() - 2);
+
+    // Guard the operand types. On mismatch restore the generic instruction and execute it instead.
+
+    const auto guard = [&]()
+    {
+        if constexpr ( k_op == opcode::binary_add_string )
+        {
+            return is_string(left) && is_string(right);
+        }
+
+        else
+        {
+            return is_number(left) && is_number(right);
+        }
+    }();
+
+    if ( guard == false )
+    {
+        vm.dequicken();
+        binary_op<k_generic_op, k_checked>(vm);
+
+        return;
+    }
+
+    acme::script_value lhs = vm.stack().pop_back<k_checked>();
+    acme::script_value rhs = vm.stack().pop_back<k_checked>();
+
+    auto result = [&]() -> acme::script_value
+    {
+        // Binary '+' operator for strings.
+
+        if constexpr ( k_op == opcode::binary_add_string )
+        {
+            auto s1 = lhs.as<acme::string>().value();
+            auto s2 = rhs.as<acme::string>().value();
+
+            return acme::script_value{ acme::string{ vm.string_pool().concatanate(s1, s2) } };
+        }
+
+        else
+        {
+            const auto n1 = lhs.as<acme::number>().value();
+            const auto n2 = rhs.as<acme::number>().value();
+
+            // Binary '+' operator for numbers.
+
+            if constexpr ( k_op == opcode::binary_add_number )
+            {
+                return acme::script_value{ acme::number{ n1 + n2 } };
+            }
+
+            // Binary '-' operator for numbers.
+
+            else if constexpr ( k_op == opcode::binary_sub_number )
+            {
+                return acme::script_value{ acme::number{ n1 - n2 } };
+            }
+
+            // Binary '*' operator for numbers.
+
+            else if constexpr ( k_op == opcode::binary_mul_number )
+            {
+                return acme::script_value{ acme::number{ n1 * n2 } };
+            }
+
+            // Binary '===' operator for numbers.
+
+            else if constexpr ( k_op == opcode::compare_strict_equal_number )
+            {
+                return acme::script_value{ acme::boolean{ n1 == n2 } };
+            }
+
+            // Binary '<' operator for numbers.
+
+            else if constexpr ( k_op == opcode::compare_less_than_number )
+            {
+                return acme::script_value{ acme::boolean{ n2 > n1 } };
+            }
+
+            // Binary '<=' operator for numbers.
+
+            else if constexpr ( k_op == opcode::compare_less_than_or_equal_number )
+            {
+                return acme::script_value{ acme::boolean{ n2 >= n1 } };
+            }
+
+            // Binary '>' operator for numbers.
+
+            else if constexpr ( k_op == opcode::compare_greater_than_number )
+            {
+                return acme::script_value{ acme::boolean{ n1 > n2 } };
+            }
+
+            // Binary '>=' operator for numbers.
+
+            else if constexpr ( k_op == opcode::compare_greater_than_or_equal_number )
+            {
+                return acme::script_value{ acme::boolean{ n1 >= n2 } };
+            }
+        }
+    }();
+
+    vm.stack().push_back<k_checked>(result);
+}
+
+} // namespace acme
@@ -2,7 +2,7 @@
 
 namespace acme {
 
-template<opcode k_op>
+template<opcode k_op, bool k_checked = true>
 void stack_op(virtual_machine& vm)
 {
     // Jump if the value on top of the stack is true.
@@ -10,11 +10,11 @@ void stack_op(virtual_machine& vm)
     if constexpr ( k_op == opcode::jump_if_true )
     {
         const auto offset = vm.current_immediate();
-        auto cond         = vm.stack().pop_back();
+        auto cond         = vm.stack().pop_back<k_checked>();
 
         if ( to_boolean(cond) == true )
         {
-            vm.jump_to(offset);
+            vm.jump_to<k_checked>(offset);
         }
     }
 
@@ -23,11 +23,11 @@ void stack_op(virtual_machine& vm)
     else if constexpr ( k_op == opcode::jump_if_false  )
     {
         const auto offset = vm.current_immediate();
-        auto cond         = vm.stack().pop_back();
+        auto cond         = vm.stack().pop_back<k_checked>();
 
         if ( to_boolean(cond) == false )
         {
-            vm.jump_to(offset);
+            vm.jump_to<k_checked>(offset);
         }
     }
 
@@ -36,7 +36,7 @@ void stack_op(virtual_machine& vm)
     else if constexpr ( k_op == opcode::jump_to )
     {
         const auto offset = vm.current_immediate();
-        vm.jump_to(offset);
+        vm.jump_to<k_checked>(offset);
     }
 
     else if constexpr ( k_op == opcode::push_stack_frame )
@@ -55,7 +55,7 @@ void stack_op(virtual_machine& vm)
     else if constexpr ( k_op == opcode::duplicate_top )
     {
         auto top = vm.stack().top();
-        vm.stack().push_back(top);
+        vm.stack().push_back<k_checked>(top);
     }
 }
 
@@ -2,10 +2,10 @@
 
 namespace acme {
 
-template<opcode k_op>
+template<opcode k_op, bool k_checked = true>
 void unary_op(virtual_machine& vm)
 {
-    auto right  = vm.stack().pop_back();
+    auto right  = vm.stack().pop_back<k_checked>();
     auto result = [&]() -> acme::script_value
     {
         // Negate the value on top of the stack.
@@ -27,7 +27,7 @@ void unary_op(virtual_machine& vm)
 
     }();
 
-    vm.stack().push_back(result);
+    vm.stack().push_back<k_checked>(result);
 }
 
 } // namespace acme
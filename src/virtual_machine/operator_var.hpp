@@ -2,13 +2,13 @@
 
 namespace acme {
 
-template<opcode k_op>
+template<opcode k_op, bool k_checked = true>
 void var_op(virtual_machine& vm)
 {
     if constexpr ( k_op == opcode::store_var )
     {
-        auto id    = vm.stack().pop_back();
-        auto value = vm.stack().pop_back();
+        acme::script_value id    = vm.stack().pop_back<k_checked>();
+        acme::script_value value = vm.stack().pop_back<k_checked>();
 
         if ( auto var = vm.get_var(id.as<acme::identifier>()); var.has_value() )
         {
@@ -19,21 +19,80 @@ void var_op(virtual_machine& vm)
 
     else if constexpr ( k_op == opcode::load_var )
     {
-        auto id = vm.stack().pop_back();
+        acme::script_value id = vm.stack().pop_back<k_checked>();
+
+        // Undeclared variables load undefined so that the instruction always pushes one value.
 
         if ( auto var = vm.get_var(id.as<acme::identifier>()); var.has_value() )
         {
             auto ref = var.value().get();
-            vm.stack().push_back(ref);
+            vm.stack().push_back<k_checked>(ref);
+        }
+
+        else
+        {
+            vm.stack().push_back<k_checked>(acme::script_value{acme::undefined{}});
         }
     }
 
     else if constexpr ( k_op == opcode::initialize )
     {
-        auto value = vm.stack().pop_back();
-        auto id    = vm.stack().pop_back();
+        acme::script_value value = vm.stack().pop_back<k_checked>();
+        acme::script_value id    = vm.stack().pop_back<k_checked>();
 
         vm.locals().push(id.as<acme::identifier>(), value);
+
+        // A declaration in the script scope may shadow a variable the global slots resolved.
+
+        if ( vm.in_global_scope() )
+        {
+            vm.invalidate_globals();
+        }
+    }
+
+    // Variables of the script scope, the immediate is one plus the symbol id.
+
+    else if constexpr ( k_op == opcode::load_global )
+    {
+        acme::script_value id = vm.stack().pop_back<k_checked>();
+
+        if ( auto var = vm.get_global(vm.current_immediate() - 1u, id.as<acme::identifier>()); var.has_value() )
+        {
+            auto ref = var.value().get();
+            vm.stack().push_back<k_checked>(ref);
+        }
+
+        else
+        {
+            vm.stack().push_back<k_checked>(acme::script_value{acme::undefined{}});
+        }
+    }
+
+    else if constexpr ( k_op == opcode::store_global )
+    {
+        acme::script_value id    = vm.stack().pop_back<k_checked>();
+        acme::script_value value = vm.stack().pop_back<k_checked>();
+
+        if ( auto var = vm.get_global(vm.current_immediate() - 1u, id.as<acme::identifier>()); var.has_value() )
+        {
+            auto& ref = var.value().get();
+            ref.assign(value);
+        }
+    }
+
+    else if constexpr ( k_op == opcode::initialize_global )
+    {
+        acme::script_value value = vm.stack().pop_back<k_checked>();
+        acme::script_value id    = vm.stack().pop_back<k_checked>();
+
+        vm.declare_global(vm.current_immediate() - 1u, id.as<acme::identifier>(), std::move(value));
+    }
+
+    // Push the argument bound to a parameter slot of a prepared expression.
+
+    else if constexpr ( k_op == opcode::load_param )
+    {
+        vm.stack().push_back<k_checked>(vm.parameter<k_checked>(vm.current_immediate()));
     }
 }
 
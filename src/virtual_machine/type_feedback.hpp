@@ -0,0 +1,111 @@
+#pragma once
+
+namespace acme {
+
+enum class operand_types : std::uint8_t
+{
+    none    = 0b0000,
+    numbers = 0b0001,
+    strings = 0b0010,
+    mixed   = 0b0100,
+};
+
+} // namespace acme
+
+template <>
+struct acme::is_bitmask_enum <acme::operand_types> : std::true_type {};
+
+namespace acme {
+
+[[nodiscard]] constexpr auto classify(
+    const acme::script_value& lhs,
+    const acme::script_value& rhs
+) noexcept -> acme::operand_types
+{
+    if ( is_number(lhs) && is_number(rhs) )
+    {
+        return operand_types::numbers;
+    }
+
+    if ( is_string(lhs) && is_string(rhs) )
+    {
+        return operand_types::strings;
+    }
+
+    return operand_types::mixed;
+}
+
+[[nodiscard]] constexpr auto quickened_opcode(
+    acme::opcode        op,
+    acme::operand_types seen
+) noexcept -> acme::opcode
+{
+    // Only specialize instructions that have observed a single operand type pair.
+
+    if ( seen == operand_types::strings && op == opcode::binary_add )
+    {
+        return opcode::binary_add_string;
+    }
+
+    if ( seen != operand_types::numbers )
+    {
+        return op;
+    }
+
+    switch ( op )
+    {
+        case opcode::binary_add:
+            return opcode::binary_add_number;
+
+        case opcode::binary_sub:
+            return opcode::binary_sub_number;
+
+        case opcode::binary_mul:
+            return opcode::binary_mul_number;
+
+        case opcode::compare_strict_equal:
+            return opcode::compare_strict_equal_number;
+
+        case opcode::compare_less_than:
+            return opcode::compare_less_than_number;
+
+        case opcode::compare_less_than_or_equal:
+            return opcode::compare_less_than_or_equal_number;
+
+        case opcode::compare_greater_than:
+            return opcode::compare_greater_than_number;
+
+        case opcode::compare_greater_than_or_equal:
+            return opcode::compare_greater_than_or_equal_number;
+
+        default:
+            return op;
+    }
+}
+
+struct type_feedback
+{
+    // Accumulates the operand types seen by a generic instruction and returns the opcode
+    // the instruction should be rewritten to. Once an instruction has observed more than
+    // one operand type pair it stays generic.
+
+    [[nodiscard]] constexpr auto record(
+        acme::opcode              op,
+        const acme::script_value& lhs,
+        const acme::script_value& rhs
+    ) noexcept -> acme::opcode
+    {
+        m_seen = m_seen | classify(lhs, rhs);
+
+        return quickened_opcode(op, m_seen);
+    }
+
+    [[nodiscard]] constexpr auto seen() const noexcept
+    {
+        return m_seen;
+    }
+
+    acme::operand_types m_seen{};
+};
+
+} // namespace acme
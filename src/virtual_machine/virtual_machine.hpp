@@ -2,7 +2,15 @@
 
 #include "var_stack.hpp"
 #include "execution_scope.hpp"
+#include "type_feedback.hpp"
+#include "object_heap.hpp"
+#include "jit_buffer.hpp"
+#include "jit_assembler_x64.hpp"
 #include "virtual_machine_context.hpp"
 #include "virtual_machine_converions.hpp"
 #include "virtual_machine_operations.hpp"
+#include "native_registry.hpp"
+#include "host_object.hpp"
 #include "virtual_machine_execute.hpp"
+#include "virtual_machine_jit.hpp"
+#include "batch_virtual_machine.hpp"
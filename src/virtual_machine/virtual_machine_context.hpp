@@ -2,21 +2,108 @@
 
 namespace acme {
 
+struct native_registry;
+struct host_object;
+
+// Result of running a script with an instruction budget.
+
+enum class execution_status : std::uint8_t
+{
+    k_completed = 0u,
+    k_suspended,
+    k_out_of_memory,
+};
+
 struct virtual_machine
 {
-    using exec_scope_stack     = acme::dynamic_cvector<acme::execution_scope>;
+    // Largest operand stack depth accepted by the verifier.
+
+    static constexpr std::size_t k_max_stack_depth = 1u << 16;
+
+    using exec_scope_stack     = acme::dynamic_cvector<acme::execution_scope, 8u>;
+    using code_type            = acme::dynamic_cvector<acme::instruction>;
+    using feedback_type        = acme::dynamic_cvector<acme::type_feedback>;
     using program_counter_type = std::size_t;
-    using stack_type           = acme::containers::stack<24, acme::script_value>;
-    using var_stack_type       = acme::containers::var_stack<24>;
+    using stack_type           = acme::containers::stack<std::dynamic_extent, acme::script_value>;
+    using locals_type          = acme::scope_locals::locals_type;
+    using global_slots_type    = acme::dynamic_cvector<std::size_t>;
     using immediate_type       = acme::instruction::immediate_type;
+    using native_script        = void (*)(acme::virtual_machine&);
+    using budget_type          = std::int64_t;
+
+    static constexpr std::size_t   k_unresolved       = std::numeric_limits<std::size_t>::max();
+    static constexpr std::size_t   k_undeclared       = k_unresolved - 1u;
+    static constexpr std::uint32_t k_jit_threshold    = 1000;
+    static constexpr budget_type   k_unlimited_budget = std::numeric_limits<budget_type>::max();
 
     constexpr virtual_machine() = default;
 
     virtual_machine(platform::pmr::memory_resource* resource)
         : m_string_pool{resource}
+        , m_heap{resource}
+        , m_resource{resource}
+        {}
+
+    // Allocate the string pool, the object heap and the operand stack through the subsystems
+    // of the accounting resource. An allocation that fails while a script runs abandons the
+    // script, see out_of_memory().
+
+    explicit virtual_machine(acme::accounting_resource& memory)
+        : m_string_pool{memory.resource(memory_subsystem::k_string_pool)}
+        , m_heap{memory.resource(memory_subsystem::k_object_heap)}
+        , m_resource{memory.resource(memory_subsystem::k_vm_stack)}
+        , m_memory{std::addressof(memory)}
         {}
 
+    virtual_machine(const virtual_machine&)            = delete;
+    virtual_machine& operator=(const virtual_machine&) = delete;
+
+    ~virtual_machine()
+    {
+        m_stack.clear();
+        deallocate_stack(m_stack.storage());
+    }
+
     inline auto execute(const bytecode& code);
+    inline auto execute(native_script script);
+
+    // Resumable execution. start() prepares the script and each resume() runs it until it
+    // completes or the budget runs out. The budget is counted in instructions and charged
+    // on loop back-edges, straight-line code is bounded by the size of the code.
+
+    inline auto start(const bytecode& code) -> void;
+    inline auto resume(budget_type budget) -> execution_status;
+
+    // Run bytecode with the arguments bound to its parameter slots and return the value the
+    // code leaves on the operand stack. Variables declared by the code are released.
+
+    inline auto evaluate(const bytecode& code, std::span<const acme::script_value> arguments) -> acme::script_value;
+
+    // Abandon a suspended execution. The operand stack and the scopes entered by the script
+    // are released, the variables of the script scope remain.
+
+    inline auto cancel() -> void;
+
+    [[nodiscard]] auto suspended() const noexcept -> bool
+    {
+        return m_pc < m_code.size();
+    }
+
+    // True if the last script was abandoned because an allocation failed. The operand stack
+    // and the scopes entered by the script were released, the variables of the script scope
+    // declared before the failure remain.
+
+    [[nodiscard]] auto out_of_memory() const noexcept -> bool
+    {
+        return m_out_of_memory;
+    }
+
+    // Memory statistics and quota, or null if the virtual machine has no accounting resource.
+
+    [[nodiscard]] auto memory() const noexcept -> const acme::accounting_resource*
+    {
+        return m_memory;
+    }
 
     [[nodiscard]] auto program_counter() -> program_counter_type&
     {
@@ -25,7 +112,7 @@ struct virtual_machine
 
     constexpr auto push_scope()
     {
-        m_scope_stack.push_back({});
+        m_scope_stack.push_back(execution_scope{ .m_locals_begin = m_locals.size() });
     }
 
     constexpr auto pop_scope()
@@ -35,51 +122,202 @@ struct virtual_machine
             assert(m_scope_stack.empty() == false);
         }
 
-        auto s = m_scope_stack.pop_back();
-        s.locals().clear();
+        // Release the variables declared in the scope.
+
+        const auto begin = m_scope_stack.back().m_locals_begin;
+
+        m_scope_stack.pop_back();
+        m_locals.erase(m_locals.begin() + begin, m_locals.end());
     }
 
-    [[nodiscard]] auto get_var(acme::identifier id) -> var_stack_type::optional_reference
+    // Innermost declaration of the variable. The reference is valid until the next declaration.
+
+    [[nodiscard]] auto get_var(acme::identifier id) -> scope_locals::optional_reference
     {
-        for ( auto it = m_scope_stack.rbegin(); it != m_scope_stack.rend(); ++it )
+        for ( auto i = m_locals.size(); i > 0; --i )
         {
-            if ( auto var = (*it).locals().get(id); var.has_value() == true )
+            if ( auto& [idc, v] = m_locals[i - 1]; idc == id )
             {
-                return var;
+                return std::reference_wrapper{v};
             }
         }
 
         return {};
     }
 
+    // Variables of the script scope, and of the scopes below it, addressed by symbol id. The
+    // index of a variable in the locals array is resolved on its first access and kept until
+    // the script scope is entered again: the script scope only grows at the end of the array,
+    // so the index stays valid while stack frames are entered and left.
+    //
+    // The identifier is the one on the operand stack. An access whose identifier is not the
+    // one of the symbol, e.g. after copy propagation, looks the variable up by identifier.
+
+    [[nodiscard]] auto get_global(
+        std::size_t      symbol,
+        acme::identifier id
+    ) -> scope_locals::optional_reference
+    {
+        if ( id != m_bytecode.symbols()[symbol].m_id )
+        {
+            return get_var(id);
+        }
+
+        if ( const auto index = global_index(symbol); index != k_undeclared )
+        {
+            return std::reference_wrapper{m_locals[index].second};
+        }
+
+        return {};
+    }
+
+    // Declare a variable in the script scope, or assign it if the scope declares it already.
+
+    auto declare_global(
+        std::size_t        symbol,
+        acme::identifier   id,
+        acme::script_value value
+    ) -> void
+    {
+        if ( id != m_bytecode.symbols()[symbol].m_id )
+        {
+            locals().push(id, std::move(value));
+            invalidate_globals();
+
+            return;
+        }
+
+        if ( const auto index = global_index(symbol); index != k_undeclared && index >= m_scope_stack.back().m_locals_begin )
+        {
+            m_locals[index].second.assign(value);
+            return;
+        }
+
+        m_locals.emplace_back(id, std::move(value));
+        m_global_slots[symbol] = m_locals.size() - 1u;
+    }
+
+    [[nodiscard]] auto in_global_scope() const noexcept -> bool
+    {
+        return m_scope_stack.size() == m_global_scope + 1u;
+    }
+
+    auto invalidate_globals() -> void
+    {
+        std::fill(m_global_slots.begin(), m_global_slots.end(), k_unresolved);
+    }
+
     [[nodiscard]] auto stack() -> stack_type&
     {
         return m_stack;
     }
 
-    [[nodiscard]] auto locals() -> var_stack_type&
+    // Make room for the given number of values on top of the current operand stack. The
+    // storage is allocated from the memory resource of the virtual machine and reused by
+    // later executions that fit in it.
+
+    auto reserve_stack(std::size_t depth) -> void
+    {
+        const auto required = m_stack.size() + depth;
+
+        if ( required <= m_stack.capacity() )
+        {
+            return;
+        }
+
+        auto* resource = stack_resource();
+        auto* storage  = static_cast<acme::script_value*>(resource->allocate(required * sizeof(acme::script_value), alignof(acme::script_value)));
+
+        deallocate_stack(m_stack.relocate(std::span{storage, required}));
+    }
+
+    [[nodiscard]] auto locals() -> scope_locals
     {
         if ( std::is_constant_evaluated() == false )
         {
             assert(m_scope_stack.empty() == false);
         }
 
-        return m_scope_stack.back().locals();
+        return scope_locals{ .m_locals = std::addressof(m_locals), .m_begin = m_scope_stack.back().m_locals_begin };
+    }
+
+    template <bool k_checked = true>
+    [[nodiscard]] constexpr auto parameter(std::size_t slot) const -> acme::script_value
+    {
+        if ( k_checked && slot >= m_parameters.size() )
+        {
+            return acme::script_value{acme::undefined{}};
+        }
+
+        return m_parameters[slot];
     }
 
-    template <typename T>
+    // Native functions called by call_native. The registry must outlive the execution.
+
+    constexpr auto natives(const native_registry* registry) noexcept -> void
+    {
+        m_natives = registry;
+    }
+
+    [[nodiscard]] constexpr auto natives() const noexcept -> const native_registry*
+    {
+        return m_natives;
+    }
+
+    // Host objects read by load_host_field, the index is the slot the emitter resolved. The
+    // objects must outlive the execution.
+
+    constexpr auto host_objects(std::span<const host_object> objects) noexcept -> void
+    {
+        m_host_objects = objects;
+    }
+
+    [[nodiscard]] constexpr auto host_objects() const noexcept -> std::span<const host_object>
+    {
+        return m_host_objects;
+    }
+
+    template <typename T, bool k_checked = true>
     [[nodiscard]] auto constant(std::integral auto offset) const
     {
-        return m_bytecode.constant<T>(offset);
+        return m_bytecode.constant<T, k_checked>(offset);
     }
 
+    template <bool k_checked = true>
     constexpr auto jump_to(program_counter_type offset)
     {
-        if ( std::is_constant_evaluated() == false )
+        if ( k_checked && std::is_constant_evaluated() == false )
         {
             assert(offset < m_bytecode.instructions().size());
         }
 
+        // A back-edge charges the instructions of the loop to the budget. Running out of
+        // budget ends the dispatch loop with the loop head as the resume point.
+
+        if ( offset < m_pc && m_budget != k_unlimited_budget )
+        {
+            m_budget -= static_cast<budget_type>(m_pc - offset);
+
+            if ( m_budget <= 0 )
+            {
+                m_pc       = offset;
+                m_code_end = 0;
+                return;
+            }
+        }
+
+#if defined(ACME_JS_JIT)
+
+        // Count loop back-edges, a hot loop continues in native code. Native code does not
+        // charge the budget, so budgeted executions stay in the interpreter.
+
+        if ( std::is_constant_evaluated() == false && offset < m_pc && m_budget == k_unlimited_budget && enter_jit(offset) )
+        {
+            return;
+        }
+
+#endif /* ACME_JS_JIT */
+
         m_pc = offset;
     }
 
@@ -98,15 +336,239 @@ struct virtual_machine
         return m_string_pool;
     }
 
+    [[nodiscard]] constexpr auto heap() -> acme::object_heap&
+    {
+        return m_heap;
+    }
+
+    [[nodiscard]] constexpr auto code() const -> const code_type&
+    {
+        return m_code;
+    }
+
+    constexpr auto record_feedback(
+        acme::opcode              op,
+        const acme::script_value& lhs,
+        const acme::script_value& rhs
+    )
+    {
+        // Rewrite the current instruction in place if the recorded feedback allows it.
+
+        const auto offset = m_pc - 1;
+
+        if ( auto quickened = m_feedback[offset].record(op, lhs, rhs); quickened != operand(m_code[offset]) )
+        {
+            m_code[offset].m_code = quickened;
+        }
+    }
+
+    constexpr auto dequicken()
+    {
+        // Guard of a quickened instruction failed, restore the generic instruction.
+
+        const auto offset = m_pc - 1;
+
+        m_code[offset].m_code = generic_opcode(m_current_op);
+    }
+
+#if defined(ACME_JS_JIT)
+
+    constexpr auto set_jit_threshold(std::uint32_t threshold)
+    {
+        m_jit_threshold = threshold;
+    }
+
+    [[nodiscard]] auto jit_compiled() const
+    {
+        return m_native.empty() == false;
+    }
+
+    auto prepare_instruction(
+        opcode               op,
+        immediate_type       imm,
+        program_counter_type next
+    )
+    {
+        // Compiled code keeps the interpreter state up to date for the instruction handlers.
+
+        m_pc          = next;
+        m_current_op  = op;
+        m_current_imm = imm;
+
+        grow_stack_if_full();
+    }
+
+    inline auto enter_jit(program_counter_type pc) -> bool;
+
+#endif /* ACME_JS_JIT */
+
     private:
 
+    [[nodiscard]] auto stack_resource() const -> platform::pmr::memory_resource*
+    {
+        return m_resource != nullptr ? m_resource : platform::pmr::get_default_resource();
+    }
+
+    // Reserve the operand stack of a script, the script is abandoned if it cannot be allocated.
+
+    auto reserve_script_stack(std::size_t depth) -> void
+    {
+        try
+        {
+            reserve_stack(depth);
+        }
+
+        catch ( const std::bad_alloc& )
+        {
+            abandon_out_of_memory();
+        }
+    }
+
+    // Release what the script holds after an allocation failed and stop the script.
+
+    auto abandon_out_of_memory() -> void
+    {
+        m_stack.clear();
+
+        while ( m_scope_stack.size() > m_global_scope + 1u )
+        {
+            pop_scope();
+        }
+
+        m_pc            = m_code.size();
+        m_out_of_memory = true;
+    }
+
+    auto deallocate_stack(stack_type::storage_type storage) -> void
+    {
+        if ( storage.empty() == false )
+        {
+            stack_resource()->deallocate(storage.data(), storage.size_bytes(), alignof(acme::script_value));
+        }
+    }
+
+    // Grow a full operand stack. Only bytecode that was not verified may exceed its recorded depth.
+
+    auto grow_stack_if_full() -> void
+    {
+        if ( m_stack.size() == m_stack.capacity() )
+        {
+            reserve_stack(std::max<std::size_t>(m_stack.capacity(), 8));
+        }
+    }
+
+    constexpr auto load_code(const bytecode& code)
+    {
+        // Each virtual machine quickens its own copy of the instructions so that the
+        // bytecode can be shared. Type feedback is kept while the same bytecode is executed.
+
+        const auto instructions = code.instructions();
+
+        if ( m_bytecode.instructions().data() == instructions.data() && m_code.size() == instructions.size() )
+        {
+            return;
+        }
+
+        m_code.clear();
+        m_code.reserve(instructions.size());
+
+        for ( const auto& ins : instructions )
+        {
+            m_code.push_back(ins);
+        }
+
+        m_feedback.clear();
+        m_feedback.resize(instructions.size());
+
+        // Link the variable accesses the emitter resolved to the script scope, the immediate
+        // holds one plus the symbol id.
+
+        for ( auto& ins : m_code )
+        {
+            if ( const auto imm = immediate(ins); imm == 0u || imm > code.symbols().size() )
+            {
+                continue;
+            }
+
+            switch ( operand(ins) )
+            {
+                case opcode::load_var:
+                    ins.m_code = opcode::load_global;
+                    break;
+
+                case opcode::store_var:
+                    ins.m_code = opcode::store_global;
+                    break;
+
+                case opcode::initialize:
+                    ins.m_code = opcode::initialize_global;
+                    break;
+
+                default:
+                    break;
+            }
+        }
+
+#if defined(ACME_JS_JIT)
+        m_native.reset();
+        m_hotness = 0;
+#endif /* ACME_JS_JIT */
+    }
+
+    // Enter the scope of a script. Global slots are resolved again for its variables.
+
+    auto enter_global_scope() -> void
+    {
+        m_global_scope = m_scope_stack.size();
+
+        m_global_slots.resize(m_bytecode.symbols().size());
+        invalidate_globals();
+
+        push_scope();
+    }
+
+    // Index of the innermost declaration below the stack frames of the script.
+
+    [[nodiscard]] auto global_index(std::size_t symbol) -> std::size_t
+    {
+        auto& slot = m_global_slots[symbol];
+
+        if ( slot != k_unresolved )
+        {
+            return slot;
+        }
+
+        const auto id  = m_bytecode.symbols()[symbol].m_id;
+        const auto end = m_global_scope + 1u < m_scope_stack.size() ? m_scope_stack[m_global_scope + 1u].m_locals_begin : m_locals.size();
+
+        slot = k_undeclared;
+
+        for ( auto i = end; i > 0; --i )
+        {
+            if ( m_locals[i - 1].first == id )
+            {
+                slot = i - 1;
+                break;
+            }
+        }
+
+        return slot;
+    }
+
+    template <bool k_checked>
+    inline auto run();
+
+    inline auto run_code() -> void;
+
     [[nodiscard]] auto load_instruction() -> std::optional<acme::instruction>
     {
-        if ( auto instruction = m_bytecode.instruction(m_pc); instruction.has_value() )
+        if ( m_pc < m_code_end )
         {
+            const auto instruction = m_code[m_pc];
+
             m_pc         += 1;
-            m_current_op  = operand(instruction.value());
-            m_current_imm = immediate(instruction.value());
+            m_current_op  = operand(instruction);
+            m_current_imm = immediate(instruction);
 
             return instruction;
         }
@@ -114,13 +576,35 @@ struct virtual_machine
         return {};
     }
 
-    program_counter_type m_pc{};
-    stack_type           m_stack{};
-    bytecode             m_bytecode{};
-    exec_scope_stack     m_scope_stack{};
-    opcode               m_current_op{};
-    immediate_type       m_current_imm{};
-    acme::string_pool    m_string_pool{nullptr};
+    // Declared first so that interned strings held by the stack, scopes and objects are released before the pool.
+
+    acme::string_pool               m_string_pool{nullptr};
+    acme::object_heap               m_heap{};
+    platform::pmr::memory_resource* m_resource{};
+    acme::accounting_resource*      m_memory{};
+    bool                            m_out_of_memory{};
+    program_counter_type            m_pc{};
+    program_counter_type            m_code_end{};   // Dispatch stops at this offset, zero when suspended.
+    budget_type                     m_budget{k_unlimited_budget};
+    stack_type                      m_stack{};
+    bytecode                        m_bytecode{};
+    std::span<const script_value>   m_parameters{};
+    const native_registry*          m_natives{};
+    std::span<const host_object>    m_host_objects{};
+    code_type                       m_code{};
+    feedback_type                   m_feedback{};
+    exec_scope_stack                m_scope_stack{};
+    locals_type                     m_locals{};
+    global_slots_type               m_global_slots{};
+    std::size_t                     m_global_scope{};
+    opcode                          m_current_op{};
+    immediate_type                  m_current_imm{};
+
+#if defined(ACME_JS_JIT)
+    jit::executable_buffer m_native{};
+    std::uint32_t          m_hotness{};
+    std::uint32_t          m_jit_threshold{k_jit_threshold};
+#endif /* ACME_JS_JIT */
 };
 
 } // namespace acme
@@ -1,7 +1,10 @@
 
 #include "operator_binary.hpp"
 #include "operator_constant.hpp"
+#include "operator_host.hpp"
+#include "operator_native.hpp"
 #include "operator_push.hpp"
+#include "operator_quickened.hpp"
 #include "operator_stack.hpp"
 #include "operator_unary.hpp"
 #include "operator_var.hpp"
@@ -10,6 +13,7 @@ namespace acme {
 
 namespace {
 
+template <bool k_checked = true>
 constexpr auto run_op(
     virtual_machine&  vm,
     acme::instruction ins
@@ -19,83 +23,107 @@ constexpr auto run_op(
     switch ( op )
     {
         case opcode::binary_add:
-            binary_op<opcode::binary_add>(vm);
+            binary_op<opcode::binary_add, k_checked>(vm);
             break;
 
         case opcode::binary_sub:
-            binary_op<opcode::binary_sub>(vm);
+            binary_op<opcode::binary_sub, k_checked>(vm);
             break;
 
         case opcode::binary_mul:
-            binary_op<opcode::binary_mul>(vm);
+            binary_op<opcode::binary_mul, k_checked>(vm);
             break;
 
         case opcode::binary_div:
-            binary_op<opcode::binary_div>(vm);
+            binary_op<opcode::binary_div, k_checked>(vm);
             break;
 
         case opcode::binary_mod:
-            binary_op<opcode::binary_mod>(vm);
+            binary_op<opcode::binary_mod, k_checked>(vm);
             break;
 
         case opcode::binary_pow:
-            binary_op<opcode::binary_pow>(vm);
+            binary_op<opcode::binary_pow, k_checked>(vm);
             break;
 
         case opcode::compare_equal:
-            binary_op<opcode::compare_equal>(vm);
+            binary_op<opcode::compare_equal, k_checked>(vm);
             break;
 
         case opcode::compare_less_than:
-            binary_op<opcode::compare_less_than>(vm);
+            binary_op<opcode::compare_less_than, k_checked>(vm);
             break;
 
         case opcode::compare_less_than_or_equal:
-            binary_op<opcode::compare_less_than_or_equal>(vm);
+            binary_op<opcode::compare_less_than_or_equal, k_checked>(vm);
             break;
 
         case opcode::compare_greater_than:
-            binary_op<opcode::compare_greater_than>(vm);
+            binary_op<opcode::compare_greater_than, k_checked>(vm);
             break;
 
         case opcode::compare_greater_than_or_equal:
-            binary_op<opcode::compare_greater_than_or_equal>(vm);
+            binary_op<opcode::compare_greater_than_or_equal, k_checked>(vm);
             break;
 
         case opcode::compare_instanceof:
-            binary_op<opcode::compare_instanceof>(vm);
+            binary_op<opcode::compare_instanceof, k_checked>(vm);
             break;
 
         case opcode::compare_strict_equal:
-            binary_op<opcode::compare_strict_equal>(vm);
+            binary_op<opcode::compare_strict_equal, k_checked>(vm);
             break;
 
         case opcode::typeof_value:
-            unary_op<opcode::typeof_value>(vm);
+            unary_op<opcode::typeof_value, k_checked>(vm);
             break;
 
         case opcode::unary_delete:
-            unary_op<opcode::unary_delete>(vm);
+            unary_op<opcode::unary_delete, k_checked>(vm);
             break;
 
         case opcode::unary_negate:
-            unary_op<opcode::unary_negate>(vm);
+            unary_op<opcode::unary_negate, k_checked>(vm);
             break;
 
         case opcode::load_var:
-            var_op<opcode::load_var>(vm);
+            var_op<opcode::load_var, k_checked>(vm);
             break;
 
         case opcode::store_var:
-            var_op<opcode::store_var>(vm);
+            var_op<opcode::store_var, k_checked>(vm);
             break;
 
         case opcode::initialize:
-            var_op<opcode::initialize>(vm);
+            var_op<opcode::initialize, k_checked>(vm);
+            break;
+
+        case opcode::load_param:
+            var_op<opcode::load_param, k_checked>(vm);
+            break;
+
+        case opcode::load_global:
+            var_op<opcode::load_global, k_checked>(vm);
+            break;
+
+        case opcode::store_global:
+            var_op<opcode::store_global, k_checked>(vm);
+            break;
+
+        case opcode::initialize_global:
+            var_op<opcode::initialize_global, k_checked>(vm);
+            break;
+
+        case opcode::call_native:
+            native_op<k_checked>(vm);
+            break;
+
+        case opcode::load_host_field:
+            host_op<k_checked>(vm);
             break;
 
         case opcode::constant_double:
-            constant_op<opcode::constant_double>(vm);
+            constant_op<opcode::constant_double, k_checked>(vm);
             break;
 
         case opcode::constant_i32:
@@ -107,80 +135,268 @@ constexpr auto run_op(
             break;
 
         case opcode::constant_identifier:
-            constant_op<opcode::constant_identifier>(vm);
+            constant_op<opcode::constant_identifier, k_checked>(vm);
             break;
 
         case opcode::constant_string:
-            constant_op<opcode::constant_string>(vm);
+            constant_op<opcode::constant_string, k_checked>(vm);
             break;
 
         case opcode::push_bool_true:
-            push_op<opcode::push_bool_true>(vm);
+            push_op<opcode::push_bool_true, k_checked>(vm);
             break;
 
         case opcode::push_bool_false:
-            push_op<opcode::push_bool_false>(vm);
+            push_op<opcode::push_bool_false, k_checked>(vm);
             break;
 
         case opcode::push_null:
-            push_op<opcode::push_null>(vm);
+            push_op<opcode::push_null, k_checked>(vm);
             break;
 
         case opcode::push_undefined:
-            push_op<opcode::push_undefined>(vm);
+            push_op<opcode::push_undefined, k_checked>(vm);
             break;
 
         case opcode::duplicate_top:
-            stack_op<opcode::duplicate_top>(vm);
+            stack_op<opcode::duplicate_top, k_checked>(vm);
             break;
 
         case opcode::push_stack_frame:
-            stack_op<opcode::push_stack_frame>(vm);
+            stack_op<opcode::push_stack_frame, k_checked>(vm);
             break;
 
         case opcode::pop_stack_frame:
-            stack_op<opcode::pop_stack_frame>(vm);
+            stack_op<opcode::pop_stack_frame, k_checked>(vm);
             break;
 
         case opcode::jump_if_false:
-            stack_op<opcode::jump_if_false>(vm);
+            stack_op<opcode::jump_if_false, k_checked>(vm);
             break;
 
         case opcode::jump_if_true:
-            stack_op<opcode::jump_if_true>(vm);
+            stack_op<opcode::jump_if_true, k_checked>(vm);
             break;
 
         case opcode::jump_to:
-            stack_op<opcode::jump_to>(vm);
+            stack_op<opcode::jump_to, k_checked>(vm);
             break;
 
         case opcode::no_opearation:
             break;
+
+        case opcode::binary_add_number:
+            quickened_op<opcode::binary_add_number, k_checked>(vm);
+            break;
+
+        case opcode::binary_add_string:
+            quickened_op<opcode::binary_add_string, k_checked>(vm);
+            break;
+
+        case opcode::binary_sub_number:
+            quickened_op<opcode::binary_sub_number, k_checked>(vm);
+            break;
+
+        case opcode::binary_mul_number:
+            quickened_op<opcode::binary_mul_number, k_checked>(vm);
+            break;
+
+        case opcode::compare_strict_equal_number:
+            quickened_op<opcode::compare_strict_equal_number, k_checked>(vm);
+            break;
+
+        case opcode::compare_less_than_number:
+            quickened_op<opcode::compare_less_than_number, k_checked>(vm);
+            break;
+
+        case opcode::compare_less_than_or_equal_number:
+            quickened_op<opcode::compare_less_than_or_equal_number, k_checked>(vm);
+            break;
+
+        case opcode::compare_greater_than_number:
+            quickened_op<opcode::compare_greater_than_number, k_checked>(vm);
+            break;
+
+        case opcode::compare_greater_than_or_equal_number:
+            quickened_op<opcode::compare_greater_than_or_equal_number, k_checked>(vm);
+            break;
     }
 }
 
 } // namespace
 
-auto virtual_machine::execute(const bytecode& code)
+template <bool k_checked>
+auto virtual_machine::run()
 {
-    m_bytecode = code;
+    if constexpr ( k_checked )
+    {
+        while ( true )
+        {
+            if ( const auto ins = load_instruction(); ins.has_value() )
+            {
+                grow_stack_if_full();
+                run_op<true>(*this, ins.value());
+            }
+
+            else
+            {
+                break;
+            }
+        }
+    }
 
-    push_scope();
+    else
+    {
+        const auto* code = m_code.data();
+
+        while ( m_pc < m_code_end )
+        {
+            const auto ins = code[m_pc];
 
-    while ( true )
+            m_pc         += 1;
+            m_current_op  = operand(ins);
+            m_current_imm = immediate(ins);
+
+            run_op<false>(*this, ins);
+        }
+    }
+}
+
+auto virtual_machine::run_code() -> void
+{
+    m_code_end = m_code.size();
+
+    // An allocation that fails, e.g. over the quota of the memory resource, abandons the
+    // script instead of the process.
+
+    try
     {
-        if ( const auto ins = load_instruction(); ins.has_value() )
+        // Verified bytecode runs without bounds and stack depth checks.
+
+        if ( m_bytecode.verified() )
         {
-            run_op(*this, ins.value());
+            run<false>();
         }
 
         else
         {
-            break;
+            run<true>();
         }
     }
 
+    catch ( const std::bad_alloc& )
+    {
+        abandon_out_of_memory();
+    }
+}
+
+auto virtual_machine::start(const bytecode& code) -> void
+{
+    load_code(code);
+
+    m_bytecode      = code;
+    m_pc            = 0;
+    m_out_of_memory = false;
+
+    enter_global_scope();
+    reserve_script_stack(code.max_stack_depth());
+}
+
+auto virtual_machine::resume(budget_type budget) -> execution_status
+{
+    if ( std::is_constant_evaluated() == false )
+    {
+        assert(budget > 0 && budget != k_unlimited_budget);
+    }
+
+    m_budget = budget;
+
+    run_code();
+
+    m_budget = k_unlimited_budget;
+
+    if ( m_out_of_memory )
+    {
+        return execution_status::k_out_of_memory;
+    }
+
+    return suspended() ? execution_status::k_suspended : execution_status::k_completed;
+}
+
+auto virtual_machine::evaluate(const bytecode& code, std::span<const acme::script_value> arguments) -> acme::script_value
+{
+    load_code(code);
+
+    m_bytecode      = code;
+    m_parameters    = arguments;
+    m_pc            = 0;
+    m_out_of_memory = false;
+
+    const auto base  = m_stack.size();
+    const auto scope = m_scope_stack.size();
+
+    enter_global_scope();
+    reserve_script_stack(code.max_stack_depth());
+    run_code();
+
+    auto result = m_stack.size() > base ? m_stack.pop_back() : acme::script_value{acme::undefined{}};
+
+    while ( m_stack.size() > base )
+    {
+        m_stack.pop_back();
+    }
+
+    while ( m_scope_stack.size() > scope )
+    {
+        pop_scope();
+    }
+
+    m_parameters = {};
+
+    return result;
+}
+
+auto virtual_machine::cancel() -> void
+{
+    m_stack.clear();
+
+    while ( m_scope_stack.size() > 1 )
+    {
+        pop_scope();
+    }
+
+    m_pc = m_code.size();
+}
+
+auto virtual_machine::execute(const bytecode& code)
+{
+    start(code);
+
+#if defined(ACME_JS_JIT)
+
+    // Hot bytecode is executed in native code from the entry point.
+
+    if ( enter_jit(m_pc) )
+    {
+        return;
+    }
+
+#endif /* ACME_JS_JIT */
+
+    run_code();
+
     //pop_scope();
 }
 
+auto virtual_machine::execute(native_script script)
+{
+    // Run a script compiled ahead of time by acme_aotc.
+
+    m_pc = 0;
+
+    push_scope();
+
+    script(*this);
+}
+
 } // namespace acme
@@ -0,0 +1,178 @@
+#pragma once
+
+#if defined(ACME_JS_JIT)
+
+namespace acme::jit {
+
+/* Baseline compiler.
+
+    Each instruction is translated into a direct call to the handler of its opcode,
+    removing the fetch and dispatch of the interpreter loop. Control flow is native:
+    jumps become relative branches between the translated instructions and
+    conditional jumps test the value returned by a helper that pops the condition.
+
+    Compiled code has the signature `void(virtual_machine*, std::uint64_t pc)` and
+    may be entered at any instruction through a table of offsets, which allows
+    switching from the interpreter on a hot loop back-edge.
+*/
+
+using entry_type   = void (*)(acme::virtual_machine*, std::uint64_t);
+using handler_type = void (*)(acme::virtual_machine*, std::uint32_t, std::uint32_t);
+
+template <opcode k_op>
+void handler(
+    acme::virtual_machine* vm,
+    std::uint32_t          imm,
+    std::uint32_t          next
+)
+{
+    vm->prepare_instruction(k_op, imm, next);
+    run_op(*vm, instruction::make(k_op, imm));
+}
+
+inline auto condition(acme::virtual_machine* vm) -> bool
+{
+    return to_boolean(vm->stack().pop_back());
+}
+
+inline constexpr auto k_handlers = []<std::size_t... I>(std::index_sequence<I...>)
+{
+    return std::to_array<handler_type>({ &handler<static_cast<opcode>(I)>... });
+}(std::make_index_sequence<k_opcode_count>{});
+
+[[nodiscard]] inline auto compile(std::span<const acme::instruction> code) -> executable_buffer
+{
+    struct branch
+    {
+        std::size_t m_at;
+        std::size_t m_target;
+    };
+
+    x64_assembler                    as{};
+    acme::dynamic_cvector<std::size_t> offsets(code.size() + 1);
+    acme::dynamic_cvector<branch>      branches{};
+
+    const auto target_of = [&](acme::instruction ins)
+    {
+        return std::min<std::size_t>(immediate(ins), code.size());
+    };
+
+    // Prologue, keep the virtual machine in a callee saved register and jump to the entry instruction.
+
+    as.push_rbx();
+    as.mov_rbx_rdi();
+
+    const auto table_at = as.lea_rax_rip();
+
+    as.jmp_table_rax_rsi();
+
+    for ( std::size_t pc{}; pc < code.size(); ++pc )
+    {
+        const auto ins = code[pc];
+
+        offsets[pc] = as.position();
+
+        switch ( operand(ins) )
+        {
+            case opcode::jump_to:
+            {
+                branches.push_back({ as.jmp(), target_of(ins) });
+                break;
+            }
+
+            case opcode::jump_if_false:
+            case opcode::jump_if_true:
+            {
+                as.mov_rdi_rbx();
+                as.call(&condition);
+                as.test_al();
+
+                const auto at = operand(ins) == opcode::jump_if_false ? as.je() : as.jne();
+                branches.push_back({ at, target_of(ins) });
+                break;
+            }
+
+            case opcode::no_opearation:
+                break;
+
+            default:
+            {
+                as.mov_rdi_rbx();
+                as.mov_esi(immediate(ins));
+                as.mov_edx(static_cast<std::uint32_t>(pc + 1));
+                as.call(k_handlers[static_cast<std::size_t>(operand(ins))]);
+                break;
+            }
+        }
+    }
+
+    // Epilogue.
+
+    offsets[code.size()] = as.position();
+
+    as.pop_rbx();
+    as.ret();
+
+    for ( const auto& [at, target] : branches )
+    {
+        as.bind(at, offsets[target]);
+    }
+
+    // Entry table of 32-bit offsets relative to the table itself.
+
+    as.align(4);
+
+    const auto table = as.position();
+
+    as.bind(table_at, table);
+
+    for ( const auto offset : offsets )
+    {
+        as.imm32(static_cast<std::uint32_t>(static_cast<std::int64_t>(offset) - static_cast<std::int64_t>(table)));
+    }
+
+    return executable_buffer{as.code()};
+}
+
+} // namespace acme::jit
+
+namespace acme {
+
+inline auto virtual_machine::enter_jit(program_counter_type pc) -> bool
+{
+    // Native code has no unwind information, an allocation over the quota could not be
+    // recovered from in it.
+
+    if ( m_memory != nullptr && m_memory->quota() != acme::accounting_resource::k_unlimited )
+    {
+        return false;
+    }
+
+    if ( m_native.empty() )
+    {
+        if ( m_hotness++ < m_jit_threshold )
+        {
+            return false;
+        }
+
+        m_native = jit::compile({m_code.data(), m_code.size()});
+
+        if ( m_native.empty() )
+        {
+            m_jit_threshold = std::numeric_limits<std::uint32_t>::max();
+            return false;
+        }
+    }
+
+    const auto entry = reinterpret_cast<jit::entry_type>(m_native.data());
+
+    entry(this, pc);
+
+    m_pc = m_code.size();
+
+    return true;
+}
+
+} // namespace acme
+
+#endif /* ACME_JS_JIT */
@@ -94,12 +94,20 @@ namespace acme {
         return acme::script_value { acme::boolean { n1 == n2 } };
     }
 
+    // A string compared to a number or boolean is converted to a number.
+
+    if ( lhs.type() == acme::string_type && (rhs.type() == acme::number_type || rhs.type() == acme::boolean_type) )
+    {
+        return acme::script_value { acme::boolean { to_double(lhs) == to_double(rhs) } };
+    }
+
     if ( lhs.type() == acme::string_type )
     {
-        // TODO: Ignore leading zeros.
+        auto buffer1 = numeric::number_string_buffer{};
+        auto buffer2 = numeric::number_string_buffer{};
 
-        auto b1 = to_string(vm, lhs);
-        auto b2 = to_string(vm, rhs);
+        auto b1 = to_string(lhs, buffer1);
+        auto b2 = to_string(rhs, buffer2);
 
         return acme::script_value { acme::boolean { b1 == b2 } };
     }
@@ -146,10 +154,15 @@ namespace acme {
     const acme::script_value rhs
 ) noexcept -> acme::script_value
 {
-    if ( lhs.type() == acme::string_type && rhs.type() == acme::string_type )
+    // String concatenation if either operand is a string.
+
+    if ( lhs.type() == acme::string_type || rhs.type() == acme::string_type )
     {
-        auto s1 = to_string(vm, lhs);
-        auto s2 = to_string(vm, rhs);
+        auto buffer1 = numeric::number_string_buffer{};
+        auto buffer2 = numeric::number_string_buffer{};
+
+        auto s1 = to_string(lhs, buffer1);
+        auto s2 = to_string(rhs, buffer2);
 
         return acme::script_value{ acme::string{  vm.string_pool().concatanate(s1, s2) } };
     }
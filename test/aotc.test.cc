@@ -0,0 +1,95 @@
+#if defined(__clang__)
+#pragma clang diagnostic push
+#pragma clang diagnostic ignored "-Wextra-semi"
+#endif /* __clang__ */
+
+#define TTS_MAIN
+#include <tts/tts.hpp>
+
+#if defined(__clang__)
+#pragma clang diagnostic pop
+#endif /* __clang__ */
+
+#include <iostream>
+
+#include "memory/memory.hpp"
+#include "memory/fixed_buffer_resource.hpp"
+#include "base/base.hpp"
+#include "string_pool/string_pool.hpp"
+
+#include "tokenizer/tokenizer.hpp"
+#include "var/script_value.hpp"
+#include "parse/parser_context.hpp"
+#include "ast/ast.hpp"
+#include "parse/parse.hpp"
+#include "bytecode/bytecode.hpp"
+#include "virtual_machine/virtual_machine.hpp"
+#include "emit/emit.hpp"
+
+// Generated from test/aotc/*.js by acme_aotc.
+
+void aot_arithmetic(acme::virtual_machine&);
+void aot_branches(acme::virtual_machine&);
+void aot_loops(acme::virtual_machine&);
+
+namespace {
+
+auto do_test(std::string_view file_name, acme::virtual_machine::native_script script)
+{
+    // Run the script in the interpreter and the ahead-of-time compiled version and compare the resulting variables.
+
+    std::ifstream input{std::filesystem::path{ACME_AOTC_SCRIPT_DIR} / file_name, std::ios::binary};
+    TTS_EXPECT(input.is_open() == true);
+
+    const auto source = std::string{std::istreambuf_iterator<char>{input}, std::istreambuf_iterator<char>{}};
+
+    std::byte buffer[8192];
+    acme::fixed_buffer_resource mbr{buffer, sizeof(buffer)};
+
+    acme::parser script_parser{source, std::addressof(mbr)};
+    script_parser.parse_all();
+
+    acme::emit_context context{};
+    acme::emit(script_parser.ast_nodes(), context);
+
+    std::byte vm_buffer[2][1024];
+    acme::fixed_buffer_resource interpreted_mbr{vm_buffer[0], sizeof(vm_buffer[0])};
+    acme::fixed_buffer_resource compiled_mbr{vm_buffer[1], sizeof(vm_buffer[1])};
+
+    acme::virtual_machine interpreted{std::addressof(interpreted_mbr)};
+    acme::virtual_machine compiled{std::addressof(compiled_mbr)};
+
+    interpreted.execute(context.bytecode());
+    compiled.execute(script);
+
+    const auto expected = interpreted.locals();
+    const auto actual   = compiled.locals();
+
+    TTS_EXPECT(expected.size() != 0u);
+    TTS_EXPECT(expected.size() == actual.size());
+
+    for ( std::size_t i{}; i < expected.size(); ++i )
+    {
+        TTS_EXPECT(expected[i].first  == actual[i].first);
+        TTS_EXPECT(expected[i].second == actual[i].second);
+    }
+
+    TTS_EXPECT(interpreted.stack().size() == compiled.stack().size());
+}
+
+} // namespace
+
+TTS_CASE("Ahead-of-time arithmetic")
+{
+    do_test("arithmetic.js", &aot_arithmetic);
+};
+
+TTS_CASE("Ahead-of-time branches")
+{
+    do_test("branches.js", &aot_branches);
+};
+
+TTS_CASE("Ahead-of-time loops")
+{
+    do_test("loops.js", &aot_loops);
+};
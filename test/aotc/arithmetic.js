@@ -0,0 +1,9 @@
+var i = 1 + 9;
+var foo = 110 + i;
+i = 20;
+
+var n = i + foo;
+var s = i - foo;
+var m = n * 2.5 / 4 - 3 % 2;
+var t = typeof n;
+var neg = -n;
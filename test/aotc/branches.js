@@ -0,0 +1,28 @@
+var i, n;
+
+if ( true )
+{
+    i = 10;
+}
+
+else
+{
+    i = 40;
+}
+
+if ( false )
+{
+    n = undefined;
+}
+
+else
+{
+    n = 20;
+}
+
+const foo = 120;
+
+let x = foo > 140 ? "success" : "fail";
+let y = foo < 140 ? "success" : "fail";
+let z = foo == "120";
+let w = foo === "120";
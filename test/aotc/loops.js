@@ -0,0 +1,24 @@
+var foo = 0;
+
+for ( var i = 0; i < 10; i++ )
+{
+    foo += (1+1);
+}
+
+var bar = 0;
+
+while ( true )
+{
+    let j = 0;
+
+    while ( j < 5 )
+    {
+        bar += (1+1);
+        j++;
+    }
+
+    if ( bar == 20 )
+    {
+        break;
+    }
+}
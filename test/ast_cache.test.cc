@@ -0,0 +1,170 @@
+#if defined(__clang__)
+#pragma clang diagnostic push
+#pragma clang diagnostic ignored "-Wextra-semi"
+#endif /* __clang__ */
+
+#define TTS_MAIN
+#include <tts/tts.hpp>
+
+#if defined(__clang__)
+#pragma clang diagnostic pop
+#endif /* __clang__ */
+
+#include <random>
+
+#include "memory/memory.hpp"
+#include "base/base.hpp"
+#include "string_pool/string_pool.hpp"
+
+#include "tokenizer/tokenizer.hpp"
+#include "var/script_value.hpp"
+#include "parse/parser_context.hpp"
+#include "ast/ast.hpp"
+#include "parse/parse.hpp"
+#include "ast/ast_cache.hpp"
+#include "render/render.hpp"
+
+namespace {
+
+constexpr std::string_view k_script =
+R"(
+    var i = 1;
+    const s = "Test";
+    var b = false;
+    var f = 1.5;
+
+    var ter = i > 10 ? i : 11;
+    i += 2;
+
+    if ( (i + 10)++ ) { var n = i; } else if ( !false ) { var n = -i; } else { var n = i; }
+
+    for ( var i = 0; i < 10; i ++ ) { /* NOP */ }
+    while ( i > 0 ) { i--; }
+
+    blaah (a,b,10)().aa;
+    var car1 = new Car (123, -1234, "BLAAH" );
+    if ( new.target ) { /* NOP */ }
+
+    function calcRectArea(width, height)
+    {
+        if ( width ) { return 10; }
+        return width * height;
+    }
+
+    var arr = [, 20, "some string",, 30];
+
+    for ( let i = 0; i < 10; i ++ )
+    {
+        some_label:
+        if ( i > 1 ) { break; } else if ( i == 3 ) { continue some_label; }
+    }
+
+    var obj = { a: "foo", b: 42, c: { h : 10, set b(c) { var a = 10; }, get s() { a; } } };
+)";
+
+auto write(const acme::parser::ast_node_list_type& nodes) -> std::string
+{
+    auto cache = std::string{};
+
+    acme::ast::write_cache(nodes, cache);
+
+    return cache;
+}
+
+} // namespace
+
+TTS_CASE("AST cache round trip")
+{
+    platform::pmr::monotonic_buffer_resource resource{};
+
+    acme::parser script_parser{k_script, std::addressof(resource)};
+    script_parser.parse_all();
+
+    const auto& parsed = script_parser.ast_nodes();
+    const auto  cache  = write(parsed);
+
+    acme::parser_context    context{std::addressof(resource)};
+    acme::ast::cache_reader reader{};
+
+    const auto result = reader.read(context, cache);
+
+    TTS_EXPECT(static_cast<bool>(result));
+    TTS_EXPECT(result.m_nodes.size() == parsed.size());
+    TTS_EXPECT(acme::to_json(result.m_nodes) == acme::to_json(parsed));
+
+    // Positions are kept.
+
+    for ( std::size_t i{}; i < parsed.size(); i++ )
+    {
+        const auto& expected = parsed[i].get()->location();
+        const auto& loaded   = result.m_nodes[i].get()->location();
+
+        TTS_EXPECT(loaded.line() == expected.line());
+        TTS_EXPECT(loaded.column() == expected.column());
+        TTS_EXPECT(loaded.index() == expected.index());
+    }
+
+    // Written again, the cache is the same.
+
+    TTS_EXPECT(write(result.m_nodes) == cache);
+};
+
+TTS_CASE("Reject corrupted AST caches")
+{
+    using acme::ast::cache_error;
+
+    platform::pmr::monotonic_buffer_resource resource{};
+
+    acme::parser script_parser{k_script, std::addressof(resource)};
+    script_parser.parse_all();
+
+    const auto cache = write(script_parser.ast_nodes());
+
+    acme::parser_context    context{std::addressof(resource)};
+    acme::ast::cache_reader reader{};
+
+    const auto error = [&](std::string_view data) { return reader.read(context, data).m_error; };
+
+    TTS_EXPECT(error("") == cache_error::bad_magic);
+    TTS_EXPECT(error("ACAX\x01") == cache_error::bad_magic);
+    TTS_EXPECT(error("ACAC\x02") == cache_error::unsupported_version);
+    TTS_EXPECT(error(cache + "x") == cache_error::invalid_value);
+
+    // Every truncated cache is rejected.
+
+    auto rejected = true;
+
+    for ( std::size_t size{}; size < cache.size(); size++ )
+    {
+        rejected = rejected && error(std::string_view{cache}.substr(0u, size)) != cache_error::none;
+    }
+
+    TTS_EXPECT(rejected);
+
+    // Damaged bytes give an error or another valid program, never a crash.
+
+    auto random = std::mt19937{3};
+
+    for ( int i{}; i < 2000; i++ )
+    {
+        auto damaged = cache;
+
+        damaged[random() % damaged.size()] = static_cast<char>(random());
+
+        [[maybe_unused]] const auto result = reader.read(context, damaged);
+    }
+
+    // Nesting deeper than the reader accepts.
+
+    auto deep = std::string{"ACAC\x01\x00\x01", 7u};
+
+    for ( std::size_t i{}; i <= acme::ast::cache_reader::k_max_depth; i++ )
+    {
+        deep += static_cast<char>(acme::ast::cache_tag::k_block_statement);
+        deep += std::string_view{"\x00\x00\x00", 3u};
+    }
+
+    deep += static_cast<char>(acme::ast::cache_tag::k_none);
+
+    TTS_EXPECT(error(deep) == cache_error::too_deep);
+};
@@ -0,0 +1,233 @@
+#if defined(__clang__)
+#pragma clang diagnostic push
+#pragma clang diagnostic ignored "-Wextra-semi"
+#endif /* __clang__ */
+
+#define TTS_MAIN
+#include <tts/tts.hpp>
+
+#if defined(__clang__)
+#pragma clang diagnostic pop
+#endif /* __clang__ */
+
+#include "memory/memory.hpp"
+#include "memory/fixed_buffer_resource.hpp"
+#include "base/base.hpp"
+#include "string_pool/string_pool.hpp"
+
+#include "tokenizer/tokenizer.hpp"
+#include "var/script_value.hpp"
+#include "parse/parser_context.hpp"
+#include "ast/ast.hpp"
+#include "parse/parse.hpp"
+#include "bytecode/bytecode.hpp"
+#include "virtual_machine/virtual_machine.hpp"
+#include "emit/emit.hpp"
+
+namespace {
+
+// Equality of results that also holds for NaN and for strings interned in different pools.
+
+auto same_value(acme::script_value a, acme::script_value b)
+{
+    if ( is_number(a) && is_number(b) )
+    {
+        const auto x = acme::to_double(a);
+        const auto y = acme::to_double(b);
+
+        return x == y || (x != x && y != y);
+    }
+
+    if ( a.type() == acme::string_type && b.type() == acme::string_type )
+    {
+        return a.as<acme::string>().value() == b.as<acme::string>().value();
+    }
+
+    return a == b;
+}
+
+// Run the script over the records in batches and once per record, and compare the outputs.
+
+auto check_batch(
+    std::string_view                     script,
+    std::span<const acme::batch_input>   inputs,
+    std::span<const acme::identifier>    output_ids,
+    std::size_t                          records
+)
+{
+    std::byte buffer[16384];
+    acme::fixed_buffer_resource mbr{buffer, sizeof(buffer)};
+
+    acme::parser script_parser{script, std::addressof(mbr)};
+    script_parser.parse_all();
+
+    acme::emit_context context{};
+    acme::emit(script_parser.ast_nodes(), context);
+
+    const auto code = context.bytecode();
+
+    TTS_EXPECT(acme::batch_virtual_machine::supports(code));
+
+    // Strings in the results are interned in the pool of the batch virtual machine.
+
+    acme::batch_virtual_machine batch{};
+
+    auto results = std::vector<std::vector<acme::script_value>>(output_ids.size(), std::vector<acme::script_value>(records));
+    auto outputs = std::vector<acme::batch_output>{};
+
+    for ( std::size_t i{}; i < output_ids.size(); i++ )
+    {
+        outputs.push_back(acme::batch_output{ .m_id = output_ids[i], .m_values = results[i] });
+    }
+
+    batch.execute(code, inputs, outputs, records);
+
+    for ( std::size_t record{}; record < records; record++ )
+    {
+        acme::virtual_machine vm{platform::pmr::get_default_resource()};
+
+        vm.push_scope();
+
+        for ( const auto& input : inputs )
+        {
+            if ( input.m_numbers.empty() == false )
+            {
+                vm.locals().push(input.m_id, acme::number{input.m_numbers[record]});
+            }
+
+            else
+            {
+                vm.locals().push(input.m_id, input.m_values[record]);
+            }
+        }
+
+        vm.execute(code);
+
+        for ( std::size_t i{}; i < output_ids.size(); i++ )
+        {
+            const auto var      = vm.get_var(output_ids[i]);
+            const auto expected = var.has_value() ? var.value().get() : acme::script_value{acme::undefined{}};
+
+            TTS_EXPECT(same_value(results[i][record], expected));
+        }
+    }
+
+    return batch.dispatch_count();
+}
+
+} // namespace
+
+TTS_CASE("Batch arithmetic and branches")
+{
+    using namespace acme::literals;
+
+    static constexpr std::size_t k_records = 2500;
+
+    auto price    = std::vector<double>(k_records);
+    auto quantity = std::vector<double>(k_records);
+
+    for ( std::size_t i{}; i < k_records; i++ )
+    {
+        price[i]    = static_cast<double>(i % 97) * 0.5;
+        quantity[i] = static_cast<double>(i % 13);
+    }
+
+    const acme::batch_input inputs[] =
+    {
+        { .m_id = "price"_id,    .m_numbers = price    },
+        { .m_id = "quantity"_id, .m_numbers = quantity },
+    };
+
+    const acme::identifier outputs[] = { "total"_id, "discount"_id, "flag"_id, "missing"_id };
+
+    const auto dispatched = check_batch(R"(
+        var total    = price * quantity;
+        var discount = 0;
+        var flag     = false;
+
+        if ( total > 100 )
+        {
+            discount = total / 10;
+            flag     = true;
+        }
+        else
+        {
+            if ( quantity == 0 )
+            {
+                discount = -1;
+            }
+        }
+
+        total = total - discount;
+    )", inputs, outputs, k_records);
+
+    // Dispatch is amortized over the lanes of a batch.
+
+    TTS_EXPECT(dispatched < k_records);
+};
+
+TTS_CASE("Batch loops with divergent trip counts")
+{
+    using namespace acme::literals;
+
+    static constexpr std::size_t k_records = 1100;
+
+    auto n = std::vector<double>(k_records);
+
+    for ( std::size_t i{}; i < k_records; i++ )
+    {
+        n[i] = static_cast<double>(i % 17);
+    }
+
+    const acme::batch_input  inputs[]  = { { .m_id = "n"_id, .m_numbers = n } };
+    const acme::identifier   outputs[] = { "s"_id, "i"_id };
+
+    check_batch(R"(
+        var s = 0;
+        var i = 0;
+
+        while ( i < n )
+        {
+            if ( i == 7 )
+            {
+                break;
+            }
+
+            s = s + i * i;
+            i = i + 1;
+        }
+    )", inputs, outputs, k_records);
+};
+
+TTS_CASE("Batch boxed values")
+{
+    using namespace acme::literals;
+
+    static constexpr std::size_t k_records = 300;
+
+    auto values = std::vector<acme::script_value>(k_records);
+
+    for ( std::size_t i{}; i < k_records; i++ )
+    {
+        switch ( i % 4 )
+        {
+            case 0:  values[i] = acme::script_value{acme::number{static_cast<double>(i)}}; break;
+            case 1:  values[i] = acme::script_value{acme::string{"a"}};                    break;
+            case 2:  values[i] = acme::script_value{acme::boolean{true}};                  break;
+            default: values[i] = acme::script_value{acme::undefined{}};                    break;
+        }
+    }
+
+    const acme::batch_input inputs[]  = { { .m_id = "v"_id, .m_values = values } };
+    const acme::identifier  outputs[] = { "r"_id, "t"_id };
+
+    check_batch(R"(
+        var r = v + 1;
+        var t = v;
+
+        if ( v )
+        {
+            t = 2 * 3;
+        }
+    )", inputs, outputs, k_records);
+};
@@ -0,0 +1,135 @@
+#if defined(__clang__)
+#pragma clang diagnostic push
+#pragma clang diagnostic ignored "-Wextra-semi"
+#endif /* __clang__ */
+
+#define TTS_MAIN
+#include <tts/tts.hpp>
+
+#if defined(__clang__)
+#pragma clang diagnostic pop
+#endif /* __clang__ */
+
+#include "memory/memory.hpp"
+#include "memory/fixed_buffer_resource.hpp"
+#include "base/base.hpp"
+#include "string_pool/string_pool.hpp"
+
+#include "tokenizer/tokenizer.hpp"
+#include "var/script_value.hpp"
+#include "parse/parser_context.hpp"
+#include "ast/ast.hpp"
+#include "parse/parse.hpp"
+#include "bytecode/bytecode.hpp"
+#include "virtual_machine/virtual_machine.hpp"
+#include "emit/emit.hpp"
+#include "compile/compile.hpp"
+
+namespace {
+
+// Emit the same script at runtime for comparison against the compile time result.
+
+auto runtime_emit(std::string_view script, acme::emit_context& context)
+{
+    std::byte buffer[8192];
+    acme::fixed_buffer_resource mbr{buffer, sizeof(buffer)};
+
+    acme::parser script_parser{script, std::addressof(mbr)};
+    script_parser.parse_all();
+
+    acme::emit(script_parser.ast_nodes(), context);
+}
+
+auto same_bytecode(const acme::bytecode& a, const acme::bytecode& b)
+{
+    const auto same_bytes = [](auto lhs, auto rhs)
+    {
+        return lhs.size_bytes() == rhs.size_bytes() && std::memcmp(lhs.data(), rhs.data(), lhs.size_bytes()) == 0;
+    };
+
+    if ( a.m_instructions.size() != b.m_instructions.size() )
+    {
+        return false;
+    }
+
+    for ( std::size_t i{}; i < a.m_instructions.size(); i++ )
+    {
+        if ( operand(a.m_instructions[i]) != operand(b.m_instructions[i]) || immediate(a.m_instructions[i]) != immediate(b.m_instructions[i]) )
+        {
+            return false;
+        }
+    }
+
+    return same_bytes(a.m_number_constants, b.m_number_constants)
+        && same_bytes(a.m_string_constants, b.m_string_constants)
+        && same_bytes(a.m_string_buffer, b.m_string_buffer);
+}
+
+} // namespace
+
+TTS_CASE("Compile time arithmetic")
+{
+    using namespace std::string_view_literals;
+
+    static constexpr auto k_script = acme::compile<"var y = 2; var x = 1 + y * 10; x = x - 3;">();
+
+    static_assert(k_script.m_instructions.size() > 0);
+    static_assert(acme::operand(k_script.m_instructions.back()) == acme::opcode::no_opearation);
+
+    acme::virtual_machine vm{};
+    vm.execute(k_script.bytecode());
+
+    TTS_EXPECT(vm.locals().get(acme::identifier{"x"sv}) == acme::script_value{18});
+};
+
+TTS_CASE("Compile time loop")
+{
+    using namespace std::string_view_literals;
+
+    static constexpr auto k_script = acme::compile<R"(
+        var sum = 0;
+        var i   = 0;
+
+        while ( i < 10 )
+        {
+            if ( i == 5 )
+            {
+                sum = sum + 100;
+            }
+
+            sum = sum + i;
+            i   = i + 1;
+        }
+    )">();
+
+    acme::virtual_machine vm{};
+    vm.execute(k_script.bytecode());
+
+    TTS_EXPECT(vm.locals().get(acme::identifier{"sum"sv}) == acme::script_value{145});
+};
+
+TTS_CASE("Compile time strings")
+{
+    using namespace std::string_view_literals;
+
+    static constexpr std::string_view k_source = R"(var s = "abc"; var t = 'def'; var b = s == "abc";)";
+    static constexpr auto             k_script = acme::compile<R"(var s = "abc"; var t = 'def'; var b = s == "abc";)">();
+
+    static_assert(k_script.m_string_buffer.size() > 0);
+
+    acme::emit_context context{};
+    runtime_emit(k_source, context);
+
+    TTS_EXPECT(same_bytecode(k_script.bytecode(), context.bytecode()));
+};
+
+TTS_CASE("Compile time matches runtime emit")
+{
+    static constexpr std::string_view k_source = "var a = 1.5; var b = a * 4294967295; while ( b > 1 ) { b = b / 2; }";
+    static constexpr auto             k_script = acme::compile<"var a = 1.5; var b = a * 4294967295; while ( b > 1 ) { b = b / 2; }">();
+
+    acme::emit_context context{};
+    runtime_emit(k_source, context);
+
+    TTS_EXPECT(same_bytecode(k_script.bytecode(), context.bytecode()));
+};
@@ -0,0 +1,132 @@
+#if defined(__clang__)
+#pragma clang diagnostic push
+#pragma clang diagnostic ignored "-Wextra-semi"
+#endif /* __clang__ */
+
+#define TTS_MAIN
+#include <tts/tts.hpp>
+
+#if defined(__clang__)
+#pragma clang diagnostic pop
+#endif /* __clang__ */
+
+#include <iostream>
+
+#include "memory/memory.hpp"
+#include "base/base.hpp"
+
+namespace {
+
+[[nodiscard]] constexpr auto sum_of_squares(std::size_t n) -> std::size_t
+{
+    auto list = acme::dynamic_cvector<std::size_t, 2u>{};
+
+    for ( std::size_t i{}; i < n; i++ )
+    {
+        list.push_back(i * i);
+    }
+
+    auto sum = std::size_t{};
+
+    for ( const auto v : list )
+    {
+        sum += v;
+    }
+
+    return sum;
+}
+
+static_assert(sum_of_squares(10) == 285u);
+
+} // namespace
+
+TTS_CASE("Allocate from the memory resource")
+{
+    acme::accounting_resource memory{};
+
+    {
+        acme::dynamic_cvector<int> list{std::addressof(memory)};
+
+        for ( int i{}; i < 100; i++ )
+        {
+            list.push_back(i);
+        }
+
+        TTS_EXPECT(list.resource() == std::addressof(memory));
+        TTS_EXPECT(list[99] == 99);
+        TTS_EXPECT(memory.total().m_allocations > 0u);
+        TTS_EXPECT(memory.total().in_use() == list.capacity() * sizeof(int));
+
+        // A moved vector keeps its storage and its resource.
+
+        const auto allocations = memory.total().m_allocations;
+        const auto moved       = std::move(list);
+
+        TTS_EXPECT(moved.resource() == std::addressof(memory));
+        TTS_EXPECT(moved.size() == 100u);
+        TTS_EXPECT(memory.total().m_allocations == allocations);
+
+        // A copy has no resource.
+
+        const auto copy = moved;
+
+        TTS_EXPECT(copy.resource() == nullptr);
+        TTS_EXPECT(copy == moved);
+        TTS_EXPECT(memory.total().m_allocations == allocations);
+    }
+
+    TTS_EXPECT(memory.total().in_use() == 0u);
+};
+
+TTS_CASE("Inline storage")
+{
+    acme::accounting_resource memory{};
+
+    acme::dynamic_cvector<std::string, 4u> list{std::addressof(memory)};
+
+    list.push_back("a");
+    list.push_back("b");
+    list.push_back("c");
+
+    TTS_EXPECT(list.capacity() == 4u);
+    TTS_EXPECT(memory.total().m_allocations == 0u);
+
+    // Inline elements are moved one by one.
+
+    auto moved = std::move(list);
+
+    TTS_EXPECT(list.empty());
+    TTS_EXPECT(moved.size() == 3u);
+    TTS_EXPECT(moved[2] == "c");
+
+    moved.push_back("d");
+    moved.push_back("e");
+
+    TTS_EXPECT(moved.capacity() == 8u);
+    TTS_EXPECT(memory.total().m_allocations == 1u);
+    TTS_EXPECT(moved[0] == "a");
+    TTS_EXPECT(moved[4] == "e");
+
+    moved.erase(moved.begin() + 1, moved.end());
+    moved.shrink_to_fit();
+
+    TTS_EXPECT(moved.capacity() == 4u);
+    TTS_EXPECT(moved[0] == "a");
+    TTS_EXPECT(memory.total().in_use() == 0u);
+};
+
+TTS_CASE("Growth policy")
+{
+    auto doubling = acme::dynamic_cvector<int>{};
+    auto half     = acme::dynamic_cvector<int, 0u, acme::grow_by_half>{};
+
+    for ( int i{}; i < 20; i++ )
+    {
+        doubling.push_back(i);
+        half.push_back(i);
+    }
+
+    TTS_EXPECT(doubling.capacity() == 32u);
+    TTS_EXPECT(half.capacity() == 28u);
+    TTS_EXPECT(std::equal(doubling.begin(), doubling.end(), half.begin(), half.end()));
+};
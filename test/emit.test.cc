@@ -34,7 +34,7 @@ auto do_test(const auto script, acme::emit_context& context)
     using namespace acme::literals;
     using namespace std::string_view_literals;
 
-    std::byte buffer[8192];
+    std::byte buffer[32768];
     acme::fixed_buffer_resource mbr{buffer, sizeof(buffer)};
 
     acme::parser script_parser{script, std::addressof(mbr)};
@@ -319,6 +319,33 @@ TTS_CASE("if string")
     TTS_EXPECT(vm.locals().get(acme::identifier{"s"sv}) == acme::script_value{ acme::string {std::string_view{"hello2"}}});
 };
 
+TTS_CASE("string and number concatenation")
+{
+    using namespace acme::literals;
+    using namespace std::string_view_literals;
+
+    acme::emit_context context{};
+
+    static constexpr std::string_view k_script =
+    R"(
+        var a= "n" + 12.5;
+        var b= 7 + "px";
+        var c= "x" + 1 / 3;
+    )";
+
+    do_test(k_script, context);
+
+    std::byte buffer[1024];
+    acme::fixed_buffer_resource mbr{buffer, sizeof(buffer)};
+
+    acme::virtual_machine vm{std::addressof(mbr)};
+    vm.execute(context.bytecode());
+
+    TTS_EXPECT(vm.locals().get(acme::identifier{"a"sv}) == acme::script_value{ acme::string {"n12.5"sv}});
+    TTS_EXPECT(vm.locals().get(acme::identifier{"b"sv}) == acme::script_value{ acme::string {"7px"sv}});
+    TTS_EXPECT(vm.locals().get(acme::identifier{"c"sv}) == acme::script_value{ acme::string {"x0.3333333333333333"sv}});
+};
+
 TTS_CASE("for loop")
 {
     using namespace acme::literals;
@@ -441,3 +468,158 @@ TTS_CASE("ternary")
     TTS_EXPECT(vm.locals().get(acme::identifier{"x"sv}) == acme::script_value{ acme::string {std::string_view{"fail"}}});
 };
 
+
+TTS_CASE("block scopes")
+{
+    using namespace acme::literals;
+    using namespace std::string_view_literals;
+
+    acme::emit_context context{};
+
+    static constexpr std::string_view k_script =
+    R"(
+        var i = 0;
+        var s = 0;
+
+        while ( i < 10 )
+        {
+            var t = i * 2;
+            s = s + t;
+            i = i + 1;
+        }
+
+        if ( s > 0 )
+        {
+            let u = 1;
+            s = s + u;
+        }
+    )";
+
+    do_test(k_script, context);
+
+    // Only the block that declares a let binding gets its own stack frame.
+
+    const auto code   = context.bytecode();
+    const auto frames = std::count_if(code.instructions().begin(), code.instructions().end(), [](const auto& ins)
+    {
+        return operand(ins) == acme::opcode::push_stack_frame;
+    });
+
+    TTS_EXPECT(frames == 1);
+
+    acme::virtual_machine vm{};
+    vm.execute(code);
+
+    // The var declared in the loop body is declared once in the script scope.
+
+    TTS_EXPECT(vm.locals().get(acme::identifier{"s"sv}) == acme::script_value{91});
+    TTS_EXPECT(vm.locals().get(acme::identifier{"t"sv}) == acme::script_value{18});
+    TTS_EXPECT(vm.locals().get(acme::identifier{"u"sv}).has_value() == false);
+    TTS_EXPECT(vm.locals().size() == 3u);
+};
+
+TTS_CASE("Symbols of names with the same hash")
+{
+    using namespace acme::literals;
+    using namespace std::string_view_literals;
+
+    acme::emit_context context{};
+
+    // Both pairs of names have the same FNV-1a hash.
+
+    static constexpr std::string_view k_script =
+    R"(
+        var costarring = 1;
+        var liquid = 2;
+        var declinate = costarring + 10;
+        var macallums = liquid + 20;
+        liquid = liquid + costarring;
+    )";
+
+    do_test(k_script, context);
+
+    TTS_EXPECT(acme::identifier{"costarring"sv} == acme::identifier{"liquid"sv});
+    TTS_EXPECT(acme::identifier{"declinate"sv} == acme::identifier{"macallums"sv});
+
+    // Symbol ids are dense and in the order the names are first used.
+
+    const auto code = context.bytecode();
+
+    TTS_EXPECT(code.symbols().size() == 4u);
+    TTS_EXPECT(code.find_symbol("costarring"sv) == std::optional<std::size_t>{0u});
+    TTS_EXPECT(code.find_symbol("liquid"sv) == std::optional<std::size_t>{1u});
+    TTS_EXPECT(code.find_symbol("macallums"sv) == std::optional<std::size_t>{3u});
+    TTS_EXPECT(code.symbol_name(2u) == "declinate"sv);
+    TTS_EXPECT(code.find_symbol("x"sv).has_value() == false);
+
+    // The first name keeps its hash as identifier.
+
+    TTS_EXPECT(code.var_id("costarring"sv) == acme::identifier{"costarring"sv});
+    TTS_EXPECT(code.var_id("liquid"sv) != code.var_id("costarring"sv));
+    TTS_EXPECT(code.var_id("macallums"sv) != code.var_id("declinate"sv));
+
+    acme::virtual_machine vm{};
+    vm.execute(code);
+
+    TTS_EXPECT(vm.locals().get(code.var_id("costarring"sv)) == acme::script_value{1});
+    TTS_EXPECT(vm.locals().get(code.var_id("liquid"sv)) == acme::script_value{3});
+    TTS_EXPECT(vm.locals().get(code.var_id("declinate"sv)) == acme::script_value{11});
+    TTS_EXPECT(vm.locals().get(code.var_id("macallums"sv)) == acme::script_value{22});
+    TTS_EXPECT(vm.locals().size() == 4u);
+};
+
+TTS_CASE("Global variables")
+{
+    using namespace std::string_view_literals;
+
+    acme::emit_context context{};
+
+    static constexpr std::string_view k_script =
+    R"(
+        var a0 = 0; var a1 = 1; var a2 = 2; var a3 = 3; var a4 = 4; var a5 = 5; var a6 = 6;
+        var a7 = 7; var a8 = 8; var a9 = 9; var b0 = 10; var b1 = 11; var b2 = 12; var b3 = 13;
+        var b4 = 14; var b5 = 15; var b6 = 16; var b7 = 17; var b8 = 18; var b9 = 19; var c0 = 20;
+        var c1 = 21; var c2 = 22; var c3 = 23; var c4 = 24; var c5 = 25; var c6 = 26;
+
+        var sum = 0;
+
+        for ( var i = 0; i < 3; i++ )
+        {
+            let a0 = 100;
+            sum = sum + a0 + c6;
+
+            {
+                let c6 = 1000;
+                sum = sum + a1 + c6 + host;
+            }
+        }
+
+        var a1 = a1 + 1;
+        host = host + 1;
+    )";
+
+    do_test(k_script, context);
+
+    const auto code = context.bytecode();
+
+    acme::virtual_machine vm{};
+
+    vm.push_scope();
+    vm.locals().push(acme::identifier{"host"sv}, acme::script_value{5});
+    vm.execute(code);
+
+    // Accesses of the variables of the script scope are linked to the global opcodes.
+
+    const auto linked = std::count_if(vm.code().begin(), vm.code().end(), [](const auto& ins)
+    {
+        return operand(ins) == acme::opcode::load_global;
+    });
+
+    TTS_EXPECT(linked > 0);
+
+    TTS_EXPECT(vm.locals().get(acme::identifier{"sum"sv}) == acme::script_value{3 * (100 + 26 + 1 + 1000 + 5)});
+    TTS_EXPECT(vm.locals().get(acme::identifier{"a0"sv}) == acme::script_value{0});
+    TTS_EXPECT(vm.locals().get(acme::identifier{"a1"sv}) == acme::script_value{2});
+    TTS_EXPECT(vm.locals().get(acme::identifier{"c6"sv}) == acme::script_value{26});
+    TTS_EXPECT(vm.get_var(acme::identifier{"host"sv}) == acme::script_value{6});
+};
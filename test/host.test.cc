@@ -0,0 +1,182 @@
+#if defined(__clang__)
+#pragma clang diagnostic push
+#pragma clang diagnostic ignored "-Wextra-semi"
+#endif /* __clang__ */
+
+#define TTS_MAIN
+#include <tts/tts.hpp>
+
+#if defined(__clang__)
+#pragma clang diagnostic pop
+#endif /* __clang__ */
+
+#include "memory/memory.hpp"
+#include "memory/fixed_buffer_resource.hpp"
+#include "base/base.hpp"
+#include "string_pool/string_pool.hpp"
+
+#include "tokenizer/tokenizer.hpp"
+#include "var/script_value.hpp"
+#include "parse/parser_context.hpp"
+#include "ast/ast.hpp"
+#include "parse/parse.hpp"
+#include "bytecode/bytecode.hpp"
+#include "bytecode/verify.hpp"
+#include "virtual_machine/virtual_machine.hpp"
+#include "emit/emit.hpp"
+
+namespace {
+
+struct order
+{
+    double        m_price;
+    std::int32_t  m_quantity;
+    bool          m_express;
+    std::uint8_t  m_priority;
+    float         m_discount;
+
+    [[nodiscard]] auto total() const -> double
+    {
+        return m_price * m_quantity;
+    }
+};
+
+auto emit_script(
+    std::string_view                     script,
+    acme::emit_context&                  context,
+    std::span<const acme::host_binding>  bindings
+)
+{
+    std::byte buffer[16384];
+    acme::fixed_buffer_resource mbr{buffer, sizeof(buffer)};
+
+    acme::parser script_parser{script, std::addressof(mbr)};
+    script_parser.parse_all();
+
+    context.host_objects(bindings);
+    acme::emit(script_parser.ast_nodes(), context);
+}
+
+auto order_type() -> const acme::host_type<order>&
+{
+    static const auto type = []()
+    {
+        auto t = acme::host_type<order>{};
+
+        t.field<&order::m_price>("price");
+        t.field<&order::m_quantity>("quantity");
+        t.field<&order::m_express>("express");
+        t.field<&order::m_priority>("priority");
+        t.field<&order::m_discount>("discount");
+        t.getter<&order::total>("total");
+        t.getter<[](const order& o) { return o.m_express ? "express" : "standard"; }>("shipping");
+
+        return t;
+    }();
+
+    return type;
+}
+
+} // namespace
+
+TTS_CASE("Host object fields")
+{
+    using namespace acme::literals;
+    using namespace std::string_view_literals;
+
+    static constexpr std::string_view k_script =
+    R"(
+        var p = o.price;
+        var q = o.quantity;
+        var e = o.express;
+        var r = o.priority + 1;
+        var d = o.discount;
+        var t = o.total;
+        var s = o.shipping;
+        var m = o.missing;
+        var x = other.price;
+    )";
+
+    const acme::host_binding bindings[] = { order_type().binding("o") };
+
+    acme::emit_context context{};
+    emit_script(k_script, context, bindings);
+
+    // Fields are loaded by offset, the names are not emitted.
+
+    const auto instructions = context.instructions();
+
+    TTS_EXPECT(std::count_if(instructions.begin(), instructions.end(), [](auto ins) { return operand(ins) == acme::opcode::load_host_field; }) == 7);
+    TTS_EXPECT(std::none_of(instructions.begin(), instructions.end(), [](auto ins) { return operand(ins) == acme::opcode::load_var; }));
+
+    auto code = context.bytecode();
+
+    TTS_EXPECT(static_cast<bool>(acme::verify(code, acme::virtual_machine::k_max_stack_depth)));
+
+    const auto record = order{ .m_price = 2.5, .m_quantity = -4, .m_express = true, .m_priority = 200, .m_discount = 0.25f };
+
+    const acme::host_object objects[] = { order_type().object(record) };
+
+    acme::virtual_machine vm{platform::pmr::get_default_resource()};
+    vm.host_objects(objects);
+    vm.execute(code);
+
+    TTS_EXPECT(vm.locals().get("p"_id) == acme::script_value{acme::number{2.5}});
+    TTS_EXPECT(vm.locals().get("q"_id) == acme::script_value{acme::number{-4.0}});
+    TTS_EXPECT(vm.locals().get("e"_id) == acme::script_value{acme::boolean{true}});
+    TTS_EXPECT(vm.locals().get("r"_id) == acme::script_value{acme::number{201.0}});
+    TTS_EXPECT(vm.locals().get("d"_id) == acme::script_value{acme::number{0.25}});
+    TTS_EXPECT(vm.locals().get("t"_id) == acme::script_value{acme::number{-10.0}});
+    TTS_EXPECT(vm.locals().get("s"_id) == acme::script_value{acme::string{"express"sv}});
+    TTS_EXPECT(is_undefined(vm.locals().get("m"_id).value().get()));
+    TTS_EXPECT(is_undefined(vm.locals().get("x"_id).value().get()));
+    TTS_EXPECT(vm.stack().empty());
+};
+
+TTS_CASE("Host objects are read in place")
+{
+    using namespace acme::literals;
+
+    const acme::host_binding bindings[] = { order_type().binding("a"), order_type().binding("b") };
+
+    acme::emit_context context{};
+    emit_script("var cheaper = a.price < b.price;", context, bindings);
+
+    const auto code = context.bytecode();
+
+    auto records = std::array<order, 3>{};
+
+    for ( std::size_t i{}; i < records.size(); i++ )
+    {
+        records[i].m_price = static_cast<double>(i);
+    }
+
+    acme::virtual_machine vm{};
+
+    for ( std::size_t i{}; i + 1 < records.size(); i++ )
+    {
+        const acme::host_object objects[] = { order_type().object(records[i]), order_type().object(records[i + 1]) };
+
+        vm.host_objects(objects);
+        vm.execute(code);
+
+        TTS_EXPECT(vm.locals().get("cheaper"_id) == acme::script_value{acme::boolean{true}});
+    }
+
+    // The next execution sees a change to the record.
+
+    const acme::host_object objects[] = { order_type().object(records[0]), order_type().object(records[1]) };
+
+    vm.host_objects(objects);
+    records[0].m_price = 10.0;
+    vm.execute(code);
+
+    TTS_EXPECT(vm.locals().get("cheaper"_id) == acme::script_value{acme::boolean{false}});
+
+    // Without host objects the fields are undefined.
+
+    vm.host_objects({});
+    vm.execute(code);
+
+    TTS_EXPECT(vm.locals().get("cheaper"_id) == acme::script_value{acme::boolean{false}});
+};
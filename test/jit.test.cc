@@ -0,0 +1,234 @@
+#if defined(__clang__)
+#pragma clang diagnostic push
+#pragma clang diagnostic ignored "-Wextra-semi"
+#endif /* __clang__ */
+
+#define TTS_MAIN
+#include <tts/tts.hpp>
+
+#if defined(__clang__)
+#pragma clang diagnostic pop
+#endif /* __clang__ */
+
+#include <iostream>
+
+#include "memory/memory.hpp"
+#include "memory/fixed_buffer_resource.hpp"
+#include "base/base.hpp"
+#include "string_pool/string_pool.hpp"
+
+#include "tokenizer/tokenizer.hpp"
+#include "var/script_value.hpp"
+#include "parse/parser_context.hpp"
+#include "ast/ast.hpp"
+#include "parse/parse.hpp"
+#include "bytecode/bytecode.hpp"
+#include "virtual_machine/virtual_machine.hpp"
+#include "emit/emit.hpp"
+
+#if defined(ACME_JS_JIT)
+
+namespace {
+
+auto do_emit(const auto script, acme::emit_context& context)
+{
+    std::byte buffer[8192];
+    acme::fixed_buffer_resource mbr{buffer, sizeof(buffer)};
+
+    acme::parser script_parser{script, std::addressof(mbr)};
+    script_parser.parse_all();
+
+    acme::emit(script_parser.ast_nodes(), context);
+}
+
+auto do_test(const acme::bytecode& code, std::uint32_t threshold = 0)
+{
+    // Run the bytecode in the interpreter and in compiled code and compare the resulting variables.
+
+    acme::virtual_machine interpreted{};
+    acme::virtual_machine compiled{};
+
+    interpreted.set_jit_threshold(std::numeric_limits<std::uint32_t>::max());
+    compiled.set_jit_threshold(threshold);
+
+    interpreted.execute(code);
+    compiled.execute(code);
+
+    TTS_EXPECT(interpreted.jit_compiled() == false);
+
+    const auto expected = interpreted.locals();
+    const auto actual   = compiled.locals();
+
+    TTS_EXPECT(expected.size() == actual.size());
+
+    for ( std::size_t i{}; i < expected.size(); ++i )
+    {
+        TTS_EXPECT(expected[i].first  == actual[i].first);
+        TTS_EXPECT(expected[i].second == actual[i].second);
+    }
+
+    TTS_EXPECT(interpreted.stack().size() == compiled.stack().size());
+
+    return compiled.jit_compiled();
+}
+
+} // namespace
+
+TTS_CASE("Baseline JIT")
+{
+    using namespace acme;
+    using namespace acme::literals;
+
+    constexpr auto k_numbers = std::to_array<acme::number_constant>
+    ({
+        number_constant{ .m_hash = "var1"_id },
+        number_constant{ .m_i32  = 1 },
+        number_constant{ .m_i32  = 3 },
+        number_constant{ .m_i32  = 9 },
+    });
+
+    constexpr auto k_instructions = std::to_array<acme::instruction>
+    ({
+        instruction::make(opcode::constant_identifier, 0u),
+        instruction::make(opcode::constant_i32,        1u),
+        instruction::make(opcode::constant_i32,        2u),
+        instruction::make(opcode::binary_add,          0u),
+        instruction::make(opcode::initialize,          0u),
+
+        instruction::make(opcode::constant_identifier, 0u),
+        instruction::make(opcode::load_var,            0u),
+        instruction::make(opcode::constant_i32,        3u),
+        instruction::make(opcode::binary_add,          0u),
+        instruction::make(opcode::constant_identifier, 0u),
+        instruction::make(opcode::store_var,           0u),
+    });
+
+    TTS_EXPECT(do_test(bytecode{std::span{k_instructions}, std::span{k_numbers}}) == true);
+};
+
+TTS_CASE("Baseline JIT loop")
+{
+    using namespace acme;
+    using namespace acme::literals;
+
+    // var s = 0; var i = 0; while ( i < 10 ) { s = s + i; i = i + 1; }
+
+    constexpr auto k_numbers = std::to_array<acme::number_constant>
+    ({
+        number_constant{ .m_hash = "s"_id },
+        number_constant{ .m_hash = "i"_id },
+        number_constant{ .m_i32  = 0 },
+        number_constant{ .m_i32  = 10 },
+        number_constant{ .m_i32  = 1 },
+    });
+
+    constexpr auto k_instructions = std::to_array<acme::instruction>
+    ({
+        instruction::make(opcode::constant_identifier, 0u),
+        instruction::make(opcode::constant_i32,        2u),
+        instruction::make(opcode::initialize,          0u),
+        instruction::make(opcode::constant_identifier, 1u),
+        instruction::make(opcode::constant_i32,        2u),
+        instruction::make(opcode::initialize,          0u),
+
+        instruction::make(opcode::constant_i32,        3u),
+        instruction::make(opcode::constant_identifier, 1u),
+        instruction::make(opcode::load_var,            0u),
+        instruction::make(opcode::compare_less_than,   0u),
+        instruction::make(opcode::jump_if_false,       25u),
+
+        instruction::make(opcode::constant_identifier, 1u),
+        instruction::make(opcode::load_var,            0u),
+        instruction::make(opcode::constant_identifier, 0u),
+        instruction::make(opcode::load_var,            0u),
+        instruction::make(opcode::binary_add,          0u),
+        instruction::make(opcode::constant_identifier, 0u),
+        instruction::make(opcode::store_var,           0u),
+
+        instruction::make(opcode::constant_i32,        4u),
+        instruction::make(opcode::constant_identifier, 1u),
+        instruction::make(opcode::load_var,            0u),
+        instruction::make(opcode::binary_add,          0u),
+        instruction::make(opcode::constant_identifier, 1u),
+        instruction::make(opcode::store_var,           0u),
+        instruction::make(opcode::jump_to,             6u),
+        instruction::make(opcode::no_opearation,       0u),
+    });
+
+    // Compiled on entry and compiled on a hot loop back-edge.
+
+    TTS_EXPECT(do_test(bytecode{std::span{k_instructions}, std::span{k_numbers}}) == true);
+    TTS_EXPECT(do_test(bytecode{std::span{k_instructions}, std::span{k_numbers}}, 4) == true);
+};
+
+TTS_CASE("Baseline JIT scripts")
+{
+    using namespace std::string_view_literals;
+
+    static constexpr auto k_scripts = std::to_array<std::string_view>
+    ({
+        R"(
+            var i= 1 + 9;
+            var foo= 110 + i;
+            i=20;
+
+            var n = i + foo;
+            var s = i - foo;
+        )"sv,
+
+        R"(
+            var i, n;
+
+            if ( true ) { i = 10; } else { i = 40; }
+            if ( false ) { n = undefined; } else { n = 20; }
+        )"sv,
+
+        R"(
+            var foo = 0;
+
+            for ( var i = 0; i < 10; i++ )
+            {
+                foo += (1+1);
+            }
+        )"sv,
+
+        R"(
+            var foo = 0;
+            while ( true )
+            {
+                let i = 0;
+
+                while ( i < 5 )
+                {
+                    foo += (1+1);
+                    i++;
+                }
+
+                if ( foo == 20 )
+                {
+                    break;
+                }
+            }
+        )"sv,
+
+        R"(
+            const foo = 120;
+
+            let x = foo > 140 ? "success" : "fail";
+            let n = foo < 140 ? "success" : "fail";
+        )"sv,
+    });
+
+    for ( auto script : k_scripts )
+    {
+        acme::emit_context context{};
+
+        do_emit(script, context);
+        // Scripts without loops are only compiled when the threshold is zero.
+
+        TTS_EXPECT(do_test(context.bytecode()) == true);
+        (void) do_test(context.bytecode(), 2);
+    }
+};
+
+#endif /* ACME_JS_JIT */
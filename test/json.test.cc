@@ -0,0 +1,248 @@
+#if defined(__clang__)
+#pragma clang diagnostic push
+#pragma clang diagnostic ignored "-Wextra-semi"
+#endif /* __clang__ */
+
+#define TTS_MAIN
+#include <tts/tts.hpp>
+
+#if defined(__clang__)
+#pragma clang diagnostic pop
+#endif /* __clang__ */
+
+#include <random>
+
+#include <nlohmann/json.hpp>
+
+#include "memory/memory.hpp"
+#include "base/base.hpp"
+#include "string_pool/string_pool.hpp"
+
+#include "tokenizer/tokenizer.hpp"
+#include "var/script_value.hpp"
+#include "parse/parser_context.hpp"
+#include "ast/ast.hpp"
+#include "bytecode/bytecode.hpp"
+#include "virtual_machine/virtual_machine.hpp"
+#include "json/json.hpp"
+
+namespace {
+
+auto stringify(const acme::script_value& value) -> std::string
+{
+    auto out = std::string{};
+
+    acme::json::stringify(value, out);
+
+    return out;
+}
+
+// Parse the text, write it back and compare both documents with nlohmann::json.
+
+auto round_trips(
+    acme::virtual_machine& vm,
+    acme::json::parser&    parser,
+    const std::string&     text
+) -> bool
+{
+    const auto result = parser.parse(vm, text);
+
+    return result && nlohmann::json::parse(stringify(result.m_value)) == nlohmann::json::parse(text);
+}
+
+} // namespace
+
+TTS_CASE("Parse JSON values")
+{
+    using namespace std::string_view_literals;
+
+    acme::virtual_machine vm{platform::pmr::get_default_resource()};
+    acme::json::parser    parser{};
+
+    TTS_EXPECT(parser.parse(vm, "null").m_value == acme::script_value{nullptr});
+    TTS_EXPECT(parser.parse(vm, " true ").m_value == acme::script_value{acme::boolean{true}});
+    TTS_EXPECT(parser.parse(vm, "false").m_value == acme::script_value{acme::boolean{false}});
+    TTS_EXPECT(parser.parse(vm, "-12.5e1").m_value == acme::script_value{acme::number{-125.0}});
+    TTS_EXPECT(parser.parse(vm, "\"text\"").m_value == acme::script_value{acme::string{"text"sv}});
+    TTS_EXPECT(parser.parse(vm, "\"\"").m_value == acme::script_value{acme::string{""sv}});
+
+    const auto result = parser.parse(vm, R"({ "name": "acme", "tags": ["a", "b", 3], "nested": { "empty": [], "none": {} }, "n": 0.25 })");
+
+    TTS_EXPECT(static_cast<bool>(result));
+    TTS_EXPECT(is_object(result.m_value));
+
+    const auto* object = std::get<acme::object>(result.m_value.m_value).data();
+
+    TTS_EXPECT(object->is_array() == false);
+    TTS_EXPECT(object->size() == 4u);
+    TTS_EXPECT(object->get("name") == acme::script_value{acme::string{"acme"sv}});
+    TTS_EXPECT(object->get("n") == acme::script_value{acme::number{0.25}});
+    TTS_EXPECT(is_undefined(object->get("missing")));
+
+    const auto* tags = std::get<acme::object>(object->get("tags").m_value).data();
+
+    TTS_EXPECT(tags->is_array());
+    TTS_EXPECT(tags->size() == 3u);
+    TTS_EXPECT(tags->at(1) == acme::script_value{acme::string{"b"sv}});
+    TTS_EXPECT(tags->at(2) == acme::script_value{acme::number{3.0}});
+
+    // Objects are created in the heap of the virtual machine.
+
+    TTS_EXPECT(vm.heap().size() == 5u);
+};
+
+TTS_CASE("Parse JSON strings")
+{
+    using namespace std::string_view_literals;
+
+    acme::virtual_machine vm{platform::pmr::get_default_resource()};
+    acme::json::parser    parser{};
+
+    TTS_EXPECT(parser.parse(vm, R"("a\"b\\c\/d\n\t")").m_value == acme::script_value{acme::string{"a\"b\\c/d\n\t"sv}});
+    TTS_EXPECT(parser.parse(vm, R"("\u00e9\u20AC\ud83d\ude00")").m_value == acme::script_value{acme::string{"\xC3\xA9\xE2\x82\xAC\xF0\x9F\x98\x80"sv}});
+
+    // Escapes and quotes across the 64 byte blocks of the structural scan.
+
+    for ( std::size_t padding{}; padding < 70u; padding++ )
+    {
+        const auto prefix = std::string(padding, 'x');
+        const auto text   = "[\"" + prefix + "\\\\\", \"" + prefix + "\\\"\", \"\\\\\\\\\"]";
+
+        const auto result = parser.parse(vm, text);
+
+        TTS_EXPECT(static_cast<bool>(result));
+
+        const auto* array = std::get<acme::object>(result.m_value.m_value).data();
+
+        TTS_EXPECT(array->size() == 3u);
+        TTS_EXPECT(array->at(0) == acme::script_value{acme::string{std::string_view{prefix + "\\"}}});
+        TTS_EXPECT(array->at(1) == acme::script_value{acme::string{std::string_view{prefix + "\""}}});
+        TTS_EXPECT(array->at(2) == acme::script_value{acme::string{"\\\\"sv}});
+    }
+};
+
+TTS_CASE("Reject invalid JSON")
+{
+    using acme::json::parse_error;
+
+    acme::virtual_machine vm{platform::pmr::get_default_resource()};
+    acme::json::parser    parser{};
+
+    const auto error = [&](std::string_view text) { return parser.parse(vm, text).m_error; };
+
+    TTS_EXPECT(error("") == parse_error::empty_document);
+    TTS_EXPECT(error("  ") == parse_error::empty_document);
+    TTS_EXPECT(error("[1, 2") == parse_error::unexpected_end);
+    TTS_EXPECT(error("[1, 2,]") == parse_error::unexpected_character);
+    TTS_EXPECT(error("{\"a\" 1}") == parse_error::unexpected_character);
+    TTS_EXPECT(error("{1: 2}") == parse_error::unexpected_character);
+    TTS_EXPECT(error("\"open") == parse_error::unclosed_string);
+    TTS_EXPECT(error("\"a\\qb\"") == parse_error::invalid_string);
+    TTS_EXPECT(error("\"\\ud83d\"") == parse_error::invalid_string);
+    TTS_EXPECT(error("\"tab\there\"") == parse_error::invalid_string);
+    TTS_EXPECT(error("01") == parse_error::invalid_number);
+    TTS_EXPECT(error("1.") == parse_error::invalid_number);
+    TTS_EXPECT(error("-") == parse_error::invalid_number);
+    TTS_EXPECT(error("0x10") == parse_error::invalid_number);
+    TTS_EXPECT(error("tru") == parse_error::invalid_literal);
+    TTS_EXPECT(error("nulls") == parse_error::invalid_literal);
+    TTS_EXPECT(error("1 2") == parse_error::trailing_content);
+    TTS_EXPECT(error("{} x") == parse_error::trailing_content);
+
+    const auto nested = [](std::size_t depth) { return std::string(depth, '[') + std::string(depth, ']'); };
+
+    TTS_EXPECT(error(nested(acme::json::parser::k_max_depth)) == parse_error::none);
+    TTS_EXPECT(error(nested(acme::json::parser::k_max_depth + 1u)) == parse_error::too_deep);
+
+    const auto result = parser.parse(vm, "[1, 2,\n 3 x]");
+
+    TTS_EXPECT(result.m_error == parse_error::unexpected_character);
+    TTS_EXPECT(result.m_offset == 10u);
+};
+
+TTS_CASE("Stringify script values")
+{
+    using namespace std::string_view_literals;
+
+    acme::virtual_machine vm{platform::pmr::get_default_resource()};
+
+    TTS_EXPECT(stringify(acme::script_value{acme::number{1.5}}) == "1.5");
+    TTS_EXPECT(stringify(acme::script_value{acme::number{1e21}}) == "1e+21");
+    TTS_EXPECT(stringify(acme::script_value{acme::number{NAN}}) == "null");
+    TTS_EXPECT(stringify(acme::script_value{acme::string{"a\"\x01\n"sv}}) == R"("a\"\u0001\n")");
+    TTS_EXPECT(stringify(acme::script_value{acme::undefined{}}).empty());
+
+    auto object = vm.heap().make_object();
+    auto array  = vm.heap().make_array();
+
+    array.data()->push_back(acme::script_value{acme::boolean{true}});
+    array.data()->push_back(acme::script_value{acme::undefined{}});
+
+    object.data()->insert(acme::string{"list"sv}, acme::script_value{array});
+    object.data()->insert(acme::string{"skipped"sv}, acme::script_value{acme::undefined{}});
+    object.data()->insert(acme::string{"null"sv}, acme::script_value{nullptr});
+
+    TTS_EXPECT(stringify(acme::script_value{object}) == R"({"list":[true,null],"null":null})");
+
+    // The buffer is appended to.
+
+    auto buffer = std::string{"x="};
+
+    TTS_EXPECT(acme::json::stringify(acme::script_value{array}, buffer));
+    TTS_EXPECT(buffer == "x=[true,null]");
+};
+
+TTS_CASE("JSON round trip")
+{
+    acme::virtual_machine vm{platform::pmr::get_default_resource()};
+    acme::json::parser    parser{};
+
+    TTS_EXPECT(round_trips(vm, parser, R"({"a":[1,2.5,-3e-7,{"b":null}],"c":"\u0000\\x","d":true,"e":{}})"));
+
+    // Random documents written by nlohmann::json.
+
+    auto random = std::mt19937{42};
+
+    const auto make = [&](auto& self, int depth) -> nlohmann::json
+    {
+        switch ( depth > 4 ? random() % 4 : random() % 6 )
+        {
+            case 0: return nullptr;
+            case 1: return random() % 2 == 0;
+            case 2: return std::ldexp(static_cast<double>(random()), static_cast<int>(random() % 64) - 32);
+            case 3: return std::string(random() % 80, static_cast<char>(' ' + random() % 94));
+
+            case 4:
+            {
+                auto array = nlohmann::json::array();
+
+                for ( auto n = random() % 8; n > 0; n-- )
+                {
+                    array.push_back(self(self, depth + 1));
+                }
+
+                return array;
+            }
+
+            default:
+            {
+                auto object = nlohmann::json::object();
+
+                for ( auto n = random() % 8; n > 0; n-- )
+                {
+                    object[std::to_string(random() % 1000)] = self(self, depth + 1);
+                }
+
+                return object;
+            }
+        }
+    };
+
+    for ( int i{}; i < 200; i++ )
+    {
+        const auto document = make(make, 0);
+
+        TTS_EXPECT(round_trips(vm, parser, document.dump()));
+        TTS_EXPECT(round_trips(vm, parser, document.dump(2)));
+    }
+};
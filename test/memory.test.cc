@@ -0,0 +1,154 @@
+#if defined(__clang__)
+#pragma clang diagnostic push
+#pragma clang diagnostic ignored "-Wextra-semi"
+#endif /* __clang__ */
+
+#define TTS_MAIN
+#include <tts/tts.hpp>
+
+#if defined(__clang__)
+#pragma clang diagnostic pop
+#endif /* __clang__ */
+
+#include <iostream>
+
+#include "memory/memory.hpp"
+#include "memory/fixed_buffer_resource.hpp"
+#include "base/base.hpp"
+#include "string_pool/string_pool.hpp"
+
+#include "tokenizer/tokenizer.hpp"
+#include "var/script_value.hpp"
+#include "parse/parser_context.hpp"
+#include "ast/ast.hpp"
+#include "parse/parse.hpp"
+#include "bytecode/bytecode.hpp"
+#include "virtual_machine/virtual_machine.hpp"
+#include "emit/emit.hpp"
+
+TTS_CASE("Accounting resource statistics")
+{
+    acme::accounting_resource memory{};
+
+    auto* parser = memory.resource(acme::memory_subsystem::k_parser);
+    auto* pool   = memory.resource(acme::memory_subsystem::k_string_pool);
+
+    auto* a = parser->allocate(24, 8);
+    auto* b = parser->allocate(1000, 8);
+    auto* c = pool->allocate(8, 8);
+
+    parser->deallocate(a, 24, 8);
+
+    const auto& parser_statistics = memory.statistics(acme::memory_subsystem::k_parser);
+
+    TTS_EXPECT(parser_statistics.m_allocations == 2u);
+    TTS_EXPECT(parser_statistics.m_allocated == 1024u);
+    TTS_EXPECT(parser_statistics.m_freed == 24u);
+    TTS_EXPECT(parser_statistics.in_use() == 1000u);
+    TTS_EXPECT(parser_statistics.m_peak == 1024u);
+    TTS_EXPECT(parser_statistics.m_histogram[acme::memory_statistics::size_class(24)] == 1u);
+    TTS_EXPECT(parser_statistics.m_histogram[acme::memory_statistics::size_class(1000)] == 1u);
+
+    TTS_EXPECT(memory.statistics(acme::memory_subsystem::k_string_pool).in_use() == 8u);
+    TTS_EXPECT(memory.statistics(acme::memory_subsystem::k_vm_stack).m_allocations == 0u);
+    TTS_EXPECT(memory.total().in_use() == 1008u);
+    TTS_EXPECT(memory.total().m_peak == 1032u);
+
+    memory.reset_peak();
+
+    TTS_EXPECT(memory.total().m_peak == 1008u);
+
+    parser->deallocate(b, 1000, 8);
+    pool->deallocate(c, 8, 8);
+
+    TTS_EXPECT(memory.total().in_use() == 0u);
+};
+
+TTS_CASE("Accounting resource quota")
+{
+    acme::accounting_resource memory{256};
+
+    auto* resource = memory.resource(acme::memory_subsystem::k_other);
+    auto* p        = resource->allocate(200, 8);
+
+    TTS_THROW(resource->allocate(100, 8), acme::quota_exceeded);
+
+    // A failed allocation is not counted.
+
+    TTS_EXPECT(memory.total().m_allocations == 1u);
+    TTS_EXPECT(memory.total().in_use() == 200u);
+
+    resource->deallocate(p, 200, 8);
+
+    p = resource->allocate(256, 8);
+    resource->deallocate(p, 256, 8);
+
+    TTS_EXPECT(memory.total().m_peak == 256u);
+};
+
+TTS_CASE("Fixed buffer resource overflow")
+{
+    std::byte buffer[64];
+    acme::fixed_buffer_resource mbr{buffer, sizeof(buffer)};
+
+    TTS_THROW(static_cast<void>(mbr.allocate(128, 8)), std::bad_alloc);
+};
+
+TTS_CASE("Script over the memory quota")
+{
+    using namespace acme::literals;
+
+    static constexpr std::string_view k_script =
+    R"(
+        var s = "a";
+
+        for ( var i = 0; i < 4000; i++ )
+        {
+            s = s + "abcdefgh";
+        }
+    )";
+
+    acme::accounting_resource memory{16 * 1024};
+
+    acme::parser script_parser{k_script, memory.resource(acme::memory_subsystem::k_parser)};
+    script_parser.parse_all();
+
+    acme::emit_context context{};
+    acme::emit(script_parser.ast_nodes(), context);
+
+    acme::virtual_machine vm{memory};
+
+    vm.start(context.bytecode());
+
+    TTS_EXPECT(vm.resume(1000) == acme::execution_status::k_suspended);
+
+    while ( vm.resume(1000) == acme::execution_status::k_suspended )
+    {
+    }
+
+    // The script is abandoned, the process and the virtual machine carry on.
+
+    TTS_EXPECT(vm.out_of_memory() == true);
+    TTS_EXPECT(vm.suspended() == false);
+    TTS_EXPECT(vm.stack().empty());
+    TTS_EXPECT(vm.memory() == std::addressof(memory));
+
+    TTS_EXPECT(memory.total().m_peak <= memory.quota());
+    TTS_EXPECT(memory.statistics(acme::memory_subsystem::k_parser).m_allocations > 0u);
+    TTS_EXPECT(memory.statistics(acme::memory_subsystem::k_string_pool).m_allocations > 0u);
+    TTS_EXPECT(memory.statistics(acme::memory_subsystem::k_vm_stack).m_allocations > 0u);
+
+    const auto i = vm.locals().get("i"_id);
+
+    TTS_EXPECT(i.has_value());
+    TTS_EXPECT(i->get().as<acme::number>().value() < 4000);
+
+    // The next script runs normally.
+
+    memory.set_quota(acme::accounting_resource::k_unlimited);
+
+    vm.execute(context.bytecode());
+
+    TTS_EXPECT(vm.out_of_memory() == false);
+    TTS_EXPECT(vm.locals().get("i"_id) == acme::script_value{4000});
+};
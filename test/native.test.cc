@@ -0,0 +1,182 @@
+#if defined(__clang__)
+#pragma clang diagnostic push
+#pragma clang diagnostic ignored "-Wextra-semi"
+#endif /* __clang__ */
+
+#define TTS_MAIN
+#include <tts/tts.hpp>
+
+#if defined(__clang__)
+#pragma clang diagnostic pop
+#endif /* __clang__ */
+
+#include "memory/memory.hpp"
+#include "memory/fixed_buffer_resource.hpp"
+#include "base/base.hpp"
+#include "string_pool/string_pool.hpp"
+
+#include "tokenizer/tokenizer.hpp"
+#include "var/script_value.hpp"
+#include "parse/parser_context.hpp"
+#include "ast/ast.hpp"
+#include "parse/parse.hpp"
+#include "bytecode/bytecode.hpp"
+#include "bytecode/verify.hpp"
+#include "virtual_machine/virtual_machine.hpp"
+#include "emit/emit.hpp"
+#include "optimize/optimize.hpp"
+
+namespace {
+
+auto distance(double x, double y) -> double
+{
+    return std::sqrt(x * x + y * y);
+}
+
+auto repeat(std::string_view text, int count) -> std::string
+{
+    auto result = std::string{};
+
+    for ( int i{}; i < count; i++ )
+    {
+        result += text;
+    }
+
+    return result;
+}
+
+auto emit_script(
+    std::string_view             script,
+    acme::emit_context&          context,
+    const acme::native_registry& natives
+)
+{
+    std::byte buffer[16384];
+    acme::fixed_buffer_resource mbr{buffer, sizeof(buffer)};
+
+    acme::parser script_parser{script, std::addressof(mbr)};
+    script_parser.parse_all();
+
+    context.natives(natives.signatures());
+    acme::emit(script_parser.ast_nodes(), context);
+}
+
+} // namespace
+
+TTS_CASE("Native function calls")
+{
+    using namespace acme::literals;
+    using namespace std::string_view_literals;
+
+    auto calls   = 0;
+    auto counter = [&calls]() -> int { return ++calls; };
+
+    acme::native_registry natives{};
+
+    natives.add<&distance>("distance");
+    natives.add<&repeat>("repeat");
+    natives.add<[](bool b) { return !b; }>("not");
+    natives.add("count", counter);
+
+    TTS_EXPECT(natives.size() == 4u);
+    TTS_EXPECT(natives.signatures()[0].m_arity == 2u);
+    TTS_EXPECT(natives.signatures()[3].m_arity == 0u);
+
+    static constexpr std::string_view k_script =
+    R"(
+        var d = distance(3, 4);
+        var r = repeat("ab", 3);
+        var n = not(d > 4);
+        var m = distance(6);
+        var u = missing(1, 2);
+
+        var a = count();
+        var b = count();
+        var c = count() + 10;
+    )";
+
+    acme::emit_context context{};
+    emit_script(k_script, context, natives);
+
+    const auto instructions = context.instructions();
+
+    TTS_EXPECT(std::count_if(instructions.begin(), instructions.end(), [](auto ins) { return operand(ins) == acme::opcode::call_native; }) == 7);
+
+    auto code = context.bytecode();
+
+    TTS_EXPECT(static_cast<bool>(acme::verify(code, acme::virtual_machine::k_max_stack_depth)));
+
+    acme::virtual_machine vm{platform::pmr::get_default_resource()};
+    vm.natives(std::addressof(natives));
+    vm.execute(code);
+
+    TTS_EXPECT(vm.locals().get("d"_id) == acme::script_value{acme::number{5.0}});
+    TTS_EXPECT(vm.locals().get("r"_id) == acme::script_value{acme::string{"ababab"sv}});
+    TTS_EXPECT(vm.locals().get("n"_id) == acme::script_value{acme::boolean{false}});
+    TTS_EXPECT(is_undefined(vm.locals().get("u"_id).value().get()));
+    TTS_EXPECT(vm.locals().get("c"_id) == acme::script_value{acme::number{13.0}});
+    TTS_EXPECT(calls == 3);
+    TTS_EXPECT(vm.stack().empty());
+
+    // Missing arguments are undefined, which converts to NaN.
+
+    TTS_EXPECT(std::isnan(to_double(vm.locals().get("m"_id).value().get())));
+};
+
+TTS_CASE("Native function calls without a registry")
+{
+    using namespace acme::literals;
+
+    acme::native_registry natives{};
+
+    natives.add<&distance>("distance");
+
+    acme::emit_context context{};
+    emit_script("var d = distance(3, 4);", context, natives);
+
+    acme::virtual_machine vm{};
+    vm.execute(context.bytecode());
+
+    TTS_EXPECT(is_undefined(vm.locals().get("d"_id).value().get()));
+    TTS_EXPECT(vm.stack().empty());
+};
+
+TTS_CASE("Native function calls are not removed by the optimizer")
+{
+    using namespace acme::literals;
+
+    auto calls   = 0;
+    auto counter = [&calls](double step) -> double { calls += 1; return step; };
+
+    acme::native_registry natives{};
+
+    natives.add("step", counter);
+
+    static constexpr std::string_view k_script =
+    R"(
+        var i = 0;
+        var s = 0;
+
+        while ( i < 10 )
+        {
+            s = s + step(2);
+            i = i + 1;
+        }
+    )";
+
+    acme::emit_context context{};
+    emit_script(k_script, context, natives);
+
+    acme::opt::optimize(context, acme::opt::optimize_level::k_O2);
+
+    auto code = context.bytecode();
+
+    TTS_EXPECT(static_cast<bool>(acme::verify(code, acme::virtual_machine::k_max_stack_depth)));
+
+    acme::virtual_machine vm{};
+    vm.natives(std::addressof(natives));
+    vm.execute(code);
+
+    TTS_EXPECT(vm.locals().get("s"_id) == acme::script_value{acme::number{20.0}});
+    TTS_EXPECT(calls == 10);
+};
@@ -0,0 +1,221 @@
+#if defined(__clang__)
+#pragma clang diagnostic push
+#pragma clang diagnostic ignored "-Wextra-semi"
+#endif /* __clang__ */
+
+#define TTS_MAIN
+#include <tts/tts.hpp>
+
+#if defined(__clang__)
+#pragma clang diagnostic pop
+#endif /* __clang__ */
+
+#include "memory/memory.hpp"
+#include "memory/fixed_buffer_resource.hpp"
+#include "base/base.hpp"
+#include "numeric/numeric.hpp"
+#include "string_pool/string_pool.hpp"
+
+namespace {
+
+auto strtod_value(std::string_view text)
+{
+    const auto copy = std::string{text};
+    return std::strtod(copy.c_str(), nullptr);
+}
+
+} // namespace
+
+TTS_CASE("Parse eight digits")
+{
+    static_assert(acme::numeric::is_eight_digits(acme::numeric::load_eight_chars("12345678")));
+    static_assert(acme::numeric::is_eight_digits(acme::numeric::load_eight_chars("1234a678")) == false);
+    static_assert(acme::numeric::parse_eight_digits(acme::numeric::load_eight_chars("12345678")) == 12345678u);
+    static_assert(acme::numeric::parse_eight_digits(acme::numeric::load_eight_chars("00000009")) == 9u);
+
+    TTS_EXPECT(acme::numeric::parse_eight_digits(acme::numeric::load_eight_chars("98765432")) == 98765432u);
+};
+
+TTS_CASE("Parse integer")
+{
+    using namespace std::string_view_literals;
+
+    constexpr auto k_decimal = acme::numeric::parse_integer("1234567890123456789;"sv, 10);
+
+    static_assert(k_decimal.has_value());
+    static_assert(k_decimal->m_magnitude == 1234567890123456789ull);
+    static_assert(k_decimal->m_length == 19);
+
+    TTS_EXPECT(acme::numeric::parse_integer("deAD120F"sv, 16)->m_magnitude == 0xdeAD120Full);
+    TTS_EXPECT(acme::numeric::parse_integer("101100"sv, 2)->m_magnitude == 0b101100ull);
+    TTS_EXPECT(acme::numeric::parse_integer("255"sv, 8)->m_magnitude == 0255ull);
+    TTS_EXPECT(acme::numeric::parse_integer("x"sv, 10).has_value() == false);
+
+    // Overflowing values are approximated and no longer reported as integers.
+
+    const auto big = acme::numeric::parse_integer("123456789012345678901234567890"sv, 10);
+
+    TTS_EXPECT(big->is_integer() == false);
+    TTS_RELATIVE_EQUAL(big->m_value, 1.2345678901234568e29, 1e-12);
+};
+
+TTS_CASE("Parse number")
+{
+    using namespace std::string_view_literals;
+
+    static_assert(acme::numeric::parse_number("0.5"sv)->m_value == 0.5);
+    static_assert(acme::numeric::parse_number("-25e-1"sv)->m_value == -2.5);
+    static_assert(acme::numeric::parse_number("0x10"sv)->m_magnitude == 16);
+
+    const auto inputs = std::array
+    {
+        "0"sv, "1"sv, "0.1"sv, "0.341"sv, "3.14159265358979323846"sv, "1e23"sv, "8.98846567431158e307"sv,
+        "2.2250738585072014e-308"sv, "4.9e-324"sv, "1.7976931348623157e308"sv, "123456789012345678901234567890"sv,
+        "9007199254740993"sv, "0.000000000000000000000000001"sv, "7.038531e-26"sv, "1e400"sv, "1e-400"sv, "12."sv, ".5"sv
+    };
+
+    for ( const auto input : inputs )
+    {
+        const auto number = acme::numeric::parse_number(input);
+
+        TTS_EXPECT(number.has_value());
+        TTS_EXPECT(number->m_length == input.size());
+        TTS_IEEE_EQUAL(number->m_value, strtod_value(input));
+    }
+
+    // Exponent without digits is not part of the number.
+
+    TTS_EXPECT(acme::numeric::parse_number("1e"sv)->m_length == 1u);
+    TTS_EXPECT(acme::numeric::parse_number("1e+;"sv)->m_length == 1u);
+    TTS_EXPECT(acme::numeric::parse_number("."sv).has_value() == false);
+};
+
+TTS_CASE("Parse number matches strtod")
+{
+    auto state = std::uint64_t{0x9E3779B97F4A7C15};
+
+    const auto next = [&]()
+    {
+        state ^= state << 13;
+        state ^= state >> 7;
+        state ^= state << 17;
+        return state;
+    };
+
+    auto mismatches = std::size_t{};
+
+    for ( std::size_t i{}; i < 20000; i++ )
+    {
+        char buffer[64]{};
+
+        const auto bits  = next();
+        const auto value = std::bit_cast<double>(bits & 0x7FEFFFFFFFFFFFFFull);
+        const auto len   = std::snprintf(buffer, sizeof(buffer), "%.*g", static_cast<int>(next() % 18) + 1, value);
+        const auto text  = std::string_view{buffer, static_cast<std::size_t>(len)};
+
+        const auto number = acme::numeric::parse_number(text);
+
+        if ( number.has_value() == false || number->m_value != std::strtod(buffer, nullptr) )
+        {
+            mismatches++;
+        }
+    }
+
+    TTS_EXPECT(mismatches == 0u);
+};
+
+TTS_CASE("String to number")
+{
+    using namespace std::string_view_literals;
+
+    TTS_IEEE_EQUAL(acme::numeric::string_to_number(""sv), 0.0);
+    TTS_IEEE_EQUAL(acme::numeric::string_to_number("  42\n"sv), 42.0);
+    TTS_IEEE_EQUAL(acme::numeric::string_to_number("-1.5e3"sv), -1500.0);
+    TTS_IEEE_EQUAL(acme::numeric::string_to_number("0xff"sv), 255.0);
+    TTS_IEEE_EQUAL(acme::numeric::string_to_number("-Infinity"sv), -std::numeric_limits<double>::infinity());
+
+    TTS_EXPECT(std::isnan(acme::numeric::string_to_number("12px"sv)));
+    TTS_EXPECT(std::isnan(acme::numeric::string_to_number("-0x10"sv)));
+    TTS_EXPECT(std::isnan(acme::numeric::string_to_number("abc"sv)));
+};
+
+TTS_CASE("Interned string caches its numeric value")
+{
+    using namespace std::string_view_literals;
+
+    std::byte buffer[1024];
+    acme::fixed_buffer_resource mbr{buffer, sizeof(buffer)};
+
+    acme::string_pool pool{std::addressof(mbr)};
+
+    auto s1 = pool.intern("3.25"sv);
+    auto s2 = pool.intern("3.25"sv);
+
+    TTS_IEEE_EQUAL(s1.to_number(), 3.25);
+    TTS_IEEE_EQUAL(s2.to_number(), 3.25);
+    TTS_EXPECT(std::isnan(pool.intern("x1"sv).to_number()));
+};
+
+TTS_CASE("Number to string")
+{
+    using namespace std::string_view_literals;
+
+    const auto format = [](double value)
+    {
+        auto buffer = acme::numeric::number_string_buffer{};
+        return std::string{acme::numeric::number_to_string(value, buffer)};
+    };
+
+    static_assert(acme::numeric::cached_number_string(0.0) == "0"sv);
+    static_assert(acme::numeric::cached_number_string(-0.0) == "0"sv);
+    static_assert(acme::numeric::cached_number_string(7.0) == "7"sv);
+    static_assert(acme::numeric::cached_number_string(1023.0) == "1023"sv);
+    static_assert(acme::numeric::cached_number_string(1024.0).empty());
+    static_assert(acme::numeric::cached_number_string(0.5).empty());
+
+    TTS_EQUAL(format(std::numeric_limits<double>::quiet_NaN()), "NaN"sv);
+    TTS_EQUAL(format(-std::numeric_limits<double>::infinity()), "-Infinity"sv);
+    TTS_EQUAL(format(42.0), "42"sv);
+    TTS_EQUAL(format(-42.0), "-42"sv);
+    TTS_EQUAL(format(123456.0), "123456"sv);
+    TTS_EQUAL(format(0.1), "0.1"sv);
+    TTS_EQUAL(format(0.1 + 0.2), "0.30000000000000004"sv);
+    TTS_EQUAL(format(-1.5), "-1.5"sv);
+    TTS_EQUAL(format(1e21), "1e+21"sv);
+    TTS_EQUAL(format(1e20), "100000000000000000000"sv);
+    TTS_EQUAL(format(123e-20), "1.23e-18"sv);
+    TTS_EQUAL(format(0.000001), "0.000001"sv);
+    TTS_EQUAL(format(0.0000001), "1e-7"sv);
+    TTS_EQUAL(format(5e-324), "5e-324"sv);
+    TTS_EQUAL(format(1.7976931348623157e308), "1.7976931348623157e+308"sv);
+};
+
+TTS_CASE("Number to string round-trips random values")
+{
+    auto state = std::uint64_t{0x2545F4914F6CDD1D};
+
+    const auto next = [&]()
+    {
+        state ^= state << 13;
+        state ^= state >> 7;
+        state ^= state << 17;
+        return state;
+    };
+
+    auto mismatches = std::size_t{};
+
+    for ( std::size_t i{}; i < 20000; i++ )
+    {
+        const auto value = std::bit_cast<double>(next() & 0xFFEFFFFFFFFFFFFFull);
+
+        auto buffer = acme::numeric::number_string_buffer{};
+        auto text   = acme::numeric::number_to_string(value, buffer);
+
+        if ( acme::numeric::string_to_number(text) != value )
+        {
+            mismatches++;
+        }
+    }
+
+    TTS_EXPECT(mismatches == 0u);
+};
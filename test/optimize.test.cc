@@ -0,0 +1,243 @@
+#if defined(__clang__)
+#pragma clang diagnostic push
+#pragma clang diagnostic ignored "-Wextra-semi"
+#endif /* __clang__ */
+
+#define TTS_MAIN
+#include <tts/tts.hpp>
+
+#if defined(__clang__)
+#pragma clang diagnostic pop
+#endif /* __clang__ */
+
+#include "memory/memory.hpp"
+#include "memory/fixed_buffer_resource.hpp"
+#include "base/base.hpp"
+#include "string_pool/string_pool.hpp"
+
+#include "tokenizer/tokenizer.hpp"
+#include "var/script_value.hpp"
+#include "parse/parser_context.hpp"
+#include "ast/ast.hpp"
+#include "parse/parse.hpp"
+#include "bytecode/bytecode.hpp"
+#include "bytecode/verify.hpp"
+#include "virtual_machine/virtual_machine.hpp"
+#include "emit/emit.hpp"
+#include "optimize/optimize.hpp"
+
+namespace {
+
+auto emit_script(std::string_view script, acme::emit_context& context)
+{
+    std::byte buffer[16384];
+    acme::fixed_buffer_resource mbr{buffer, sizeof(buffer)};
+
+    acme::parser script_parser{script, std::addressof(mbr)};
+    script_parser.parse_all();
+
+    acme::emit(script_parser.ast_nodes(), context);
+}
+
+auto count_opcode(const acme::emit_context& context, acme::opcode op)
+{
+    const auto instructions = context.instructions();
+
+    return std::count_if(instructions.begin(), instructions.end(), [&](const auto& ins) { return operand(ins) == op; });
+}
+
+// Run the script at every optimization level and compare the variables with the unoptimized run.
+
+auto check_levels(std::string_view script)
+{
+    using acme::opt::optimize_level;
+
+    acme::emit_context reference{};
+    emit_script(script, reference);
+
+    acme::virtual_machine expected{};
+    expected.execute(reference.bytecode());
+
+    for ( const auto level : { optimize_level::k_O1, optimize_level::k_O2 } )
+    {
+        acme::emit_context context{};
+        emit_script(script, context);
+
+        acme::opt::optimize(context, level);
+
+        auto       code   = context.bytecode();
+        const auto depth  = code.max_stack_depth();
+        const auto result = acme::verify(code, acme::virtual_machine::k_max_stack_depth);
+
+        TTS_EXPECT(static_cast<bool>(result));
+        TTS_EXPECT(result.m_max_stack_depth <= depth);
+
+        acme::virtual_machine actual{};
+        actual.execute(code);
+
+        const auto locals = expected.locals();
+
+        for ( std::size_t i{}; i < locals.size(); ++i )
+        {
+            TTS_EXPECT(actual.locals().get(locals[i].first) == locals[i].second);
+        }
+
+        TTS_EXPECT(actual.stack().empty());
+    }
+}
+
+} // namespace
+
+TTS_CASE("Jump threading and unreachable blocks")
+{
+    using namespace acme;
+    using namespace acme::literals;
+
+    acme::emit_context context{};
+
+    const auto x = static_cast<instruction::immediate_type>(context.add_number_constant(number_constant{ .m_hash = "x"_id }));
+    const auto i = static_cast<instruction::immediate_type>(context.add_number_constant(number_constant{ .m_i32  = 1 }));
+
+    context.assign_instructions(emit_context::bytecode_list_type
+    {
+        std::in_place,
+        instruction::make(opcode::constant_identifier, x),
+        instruction::make(opcode::constant_i32,        i),
+        instruction::make(opcode::initialize,          0u),
+        instruction::make(opcode::jump_to,             7u),
+        instruction::make(opcode::constant_i32,        i),
+        instruction::make(opcode::constant_identifier, x),
+        instruction::make(opcode::store_var,           0u),
+        instruction::make(opcode::jump_to,             8u),
+        instruction::make(opcode::no_opearation,       0u),
+    }, 2);
+
+    const auto stats = opt::optimize(context, opt::optimize_level::k_O1);
+
+    TTS_EXPECT(stats.m_threaded_jumps >= 1u);
+    TTS_EXPECT(stats.m_unreachable_instructions == 4u);
+    TTS_EXPECT(stats.m_instructions_after == 4u);
+    TTS_EXPECT(count_opcode(context, opcode::jump_to) == 0);
+
+    virtual_machine vm{};
+    vm.execute(context.bytecode());
+
+    TTS_EXPECT(vm.locals().get("x"_id) == acme::script_value{1});
+};
+
+TTS_CASE("Redundant loads, copies and dead stores")
+{
+    using namespace acme;
+    using namespace acme::literals;
+
+    static constexpr std::string_view k_script =
+    R"(
+        var a = 3;
+        var b = a;
+        var r = b + b;
+        var d = 1;
+
+        d = 2;
+        d = r + 1;
+    )";
+
+    acme::emit_context context{};
+    emit_script(k_script, context);
+
+    const auto stats = opt::optimize(context, opt::optimize_level::k_O2);
+
+    TTS_EXPECT(stats.m_copies >= 1u);
+    TTS_EXPECT(stats.m_redundant_loads == 1u);
+    TTS_EXPECT(stats.m_dead_stores == 1u);
+    TTS_EXPECT(stats.m_instructions_after < stats.m_instructions_before);
+    TTS_EXPECT(count_opcode(context, opcode::duplicate_top) >= 1);
+
+    virtual_machine vm{};
+    vm.execute(context.bytecode());
+
+    TTS_EXPECT(vm.locals().get("r"_id) == acme::script_value{6});
+    TTS_EXPECT(vm.locals().get("d"_id) == acme::script_value{7});
+
+    check_levels(k_script);
+};
+
+TTS_CASE("Loop invariant code motion")
+{
+    using namespace acme;
+    using namespace acme::literals;
+
+    static constexpr std::string_view k_script =
+    R"(
+        var n = 5;
+        var s = 0;
+        var i = 0;
+
+        while ( i < n * 2 )
+        {
+            s = s + n * 3;
+            i = i + 1;
+        }
+    )";
+
+    acme::emit_context context{};
+    emit_script(k_script, context);
+
+    const auto stats = opt::optimize(context, opt::optimize_level::k_O2);
+
+    TTS_EXPECT(stats.m_hoisted_expressions == 2u);
+
+    virtual_machine vm{};
+    vm.execute(context.bytecode());
+
+    TTS_EXPECT(vm.locals().get("s"_id) == acme::script_value{150});
+    TTS_EXPECT(vm.locals().get("i"_id) == acme::script_value{10});
+
+    check_levels(k_script);
+};
+
+TTS_CASE("Optimized scripts")
+{
+    check_levels(R"(
+        var i = 0;
+        var s = 0;
+        var t = 0;
+
+        while ( i < 20 )
+        {
+            if ( i == 15 )
+            {
+                break;
+            }
+
+            if ( i % 2 == 0 )
+            {
+                let k = i * 2;
+                s = s + k;
+            }
+            else
+            {
+                s = s - 1;
+            }
+
+            if ( i > 10 )
+            {
+                t = t + i;
+            }
+            i = i + 1;
+        }
+    )");
+
+    check_levels(R"(
+        var a = 1;
+        var b = a;
+
+        a = 2;
+
+        var c = b + a;
+
+        for ( var j = 0; j < 3; j = j + 1 )
+        {
+            c = c + b * 4;
+        }
+    )");
+};
@@ -11,6 +11,7 @@
 #endif /* __clang__ */
 
 #include <iostream>
+#include <random>
 
 #include "memory/memory.hpp"
 #include "memory/fixed_buffer_resource.hpp"
@@ -23,6 +24,7 @@
 #include "parse/parser_context.hpp"
 #include "ast/ast.hpp"
 #include "parse/parse.hpp"
+#include "ast/ast_cache.hpp"
 #include "render/render.hpp"
 
 namespace {
@@ -45,8 +47,161 @@ void do_test(const auto script)
     std::cout << res << '\n';
 }
 
+// The cache of the expression parsed in the state, which covers the positions of the nodes.
+
+template <typename State>
+auto parse_expression(std::string_view text) -> std::string
+{
+    platform::pmr::monotonic_buffer_resource resource{};
+
+    acme::parser script_parser{text, std::addressof(resource)};
+    script_parser.next_token();
+
+    acme::parser::ast_node_list_type nodes{};
+    nodes.push_back(script_parser.parse(State{}));
+
+    auto cache = std::string{};
+    acme::ast::write_cache(nodes, cache);
+
+    return cache;
+}
+
+// Length of the chain of nested expressions from the node, walked without recursion.
+
+auto nesting_depth(const acme::ast::UniqueAstNode& root) -> std::size_t
+{
+    using namespace acme::ast;
+
+    // First node of a list, or null.
+
+    const auto first = [](const UniqueAstNode& list) -> const UniqueAstNode*
+    {
+        const auto& nodes = list.get()->deref<AstNodeList>().nodes();
+
+        return nodes.empty() ? nullptr : std::addressof(nodes[0]);
+    };
+
+    auto depth = std::size_t{};
+
+    for ( const auto* p = std::addressof(root); p != nullptr && p->get() != nullptr; depth++ )
+    {
+        auto* node = p->get();
+
+        if ( auto* unary = node->as<UnaryExpression>(); unary != nullptr )
+        {
+            p = std::addressof(unary->expression());
+        }
+
+        else if ( auto* binary = node->as<BinaryExpression>(); binary != nullptr )
+        {
+            p = instanceof<BinaryExpression>(binary->left()) ? std::addressof(binary->left()) : std::addressof(binary->right());
+        }
+
+        else if ( auto* array = node->as<ArrayLiteral>(); array != nullptr )
+        {
+            p = first(array->elements());
+        }
+
+        else if ( auto* object = node->as<ObjectLiteral>(); object != nullptr )
+        {
+            p = first(object->properties());
+            p = p != nullptr ? std::addressof(p->get()->deref<ObjectProperty>().value()) : nullptr;
+        }
+
+        else
+        {
+            p = nullptr;
+        }
+    }
+
+    return depth;
+}
+
 } // namespace
 
+TTS_CASE("Binary expressions match the precedence levels")
+{
+    constexpr auto k_operators = std::array
+    {
+        "*", "/", "%", "+", "-", "<<", ">>", ">>>", "==", "!=", "===", "!==", "<", "<=", ">", ">=",
+        "instanceof", "&&", "||", "&", "|", "^"
+    };
+
+    constexpr auto k_operands = std::array
+    {
+        "a", "b1", "10", "2.5", "\"s\"", "-c", "!d", "(e + f)", "g.h", "i(j)", "k++", "~l"
+    };
+
+    auto random = std::mt19937{11};
+
+    auto matched = true;
+
+    for ( int i{}; i < 500; i++ )
+    {
+        auto text = std::string{k_operands[random() % k_operands.size()]};
+
+        for ( auto n = random() % 8; n > 0; n-- )
+        {
+            text += ' ';
+            text += k_operators[random() % k_operators.size()];
+            text += ' ';
+            text += k_operands[random() % k_operands.size()];
+        }
+
+        text += ';';
+
+        matched = matched && parse_expression<acme::state::binary_expression>(text) == parse_expression<acme::state::logical_expression>(text);
+    }
+
+    TTS_EXPECT(matched);
+};
+
+TTS_CASE("Deeply nested expressions")
+{
+    // The nesting of expressions is on the heap, so the depth is not limited by the stack. The
+    // other kinds of nesting are shallower than the prefix operators to keep the test short.
+
+    constexpr std::size_t k_unary_depth = 1'000'000u;
+    constexpr std::size_t k_depth       = 10'000u;
+
+    const auto repeat = [](std::string_view text, std::size_t count)
+    {
+        auto result = std::string{};
+        result.reserve(text.size() * count);
+
+        for ( std::size_t i{}; i < count; i++ )
+        {
+            result += text;
+        }
+
+        return result;
+    };
+
+    const auto depth_of = [](const std::string& text)
+    {
+        platform::pmr::monotonic_buffer_resource resource{};
+
+        acme::parser script_parser{text, std::addressof(resource)};
+        script_parser.next_token();
+
+        const auto result = script_parser.parse(acme::state::expression{});
+
+        TTS_EXPECT(script_parser.current_token().type() == acme::token_type::tok_semicolon);
+        TTS_EXPECT(script_parser.m_frames.empty());
+
+        return nesting_depth(result);
+    };
+
+    TTS_EQUAL(depth_of(repeat("!", k_unary_depth) + "a;"), k_unary_depth + 1u);
+
+    TTS_EQUAL(depth_of("a" + repeat(" + a", k_depth) + ";"), k_depth + 1u);
+    TTS_EQUAL(depth_of(repeat("a = ", k_depth) + "1;"), k_depth + 1u);
+    TTS_EQUAL(depth_of(repeat("(", k_depth) + "1" + repeat(")", k_depth) + ";"), 1u);
+    TTS_EQUAL(depth_of(repeat("[", k_depth) + repeat("]", k_depth) + ";"), k_depth);
+    TTS_EQUAL(depth_of(repeat("{a: ", k_depth) + "1" + repeat("}", k_depth) + ";"), k_depth + 1u);
+    TTS_EQUAL(depth_of(repeat("-(", k_depth) + "1" + repeat(")", k_depth) + ";"), k_depth + 1u);
+};
+
 TTS_CASE("Parse variables")
 {
     static constexpr std::string_view k_script =
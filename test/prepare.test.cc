@@ -0,0 +1,91 @@
+#if defined(__clang__)
+#pragma clang diagnostic push
+#pragma clang diagnostic ignored "-Wextra-semi"
+#endif /* __clang__ */
+
+#define TTS_MAIN
+#include <tts/tts.hpp>
+
+#if defined(__clang__)
+#pragma clang diagnostic pop
+#endif /* __clang__ */
+
+#include "memory/memory.hpp"
+#include "memory/fixed_buffer_resource.hpp"
+#include "base/base.hpp"
+#include "string_pool/string_pool.hpp"
+
+#include "tokenizer/tokenizer.hpp"
+#include "var/script_value.hpp"
+#include "parse/parser_context.hpp"
+#include "ast/ast.hpp"
+#include "parse/parse.hpp"
+#include "bytecode/bytecode.hpp"
+#include "bytecode/verify.hpp"
+#include "virtual_machine/virtual_machine.hpp"
+#include "emit/emit.hpp"
+#include "compile/prepare.hpp"
+
+TTS_CASE("Prepared expression")
+{
+    using namespace acme;
+
+    static constexpr std::string_view k_parameters[] = { "price", "quantity" };
+
+    const auto expression = prepared_expression{"price * quantity > 100;", k_parameters};
+
+    TTS_EXPECT(expression.parameter_count() == 2u);
+    TTS_EXPECT(expression.bytecode().verified() == true);
+
+    // Parameters are read from their slots, no identifiers are loaded.
+
+    const auto instructions = expression.bytecode().instructions();
+
+    TTS_EXPECT(std::count_if(instructions.begin(), instructions.end(), [](auto ins) { return operand(ins) == opcode::load_param; }) == 2);
+    TTS_EXPECT(std::none_of(instructions.begin(), instructions.end(), [](auto ins) { return operand(ins) == opcode::load_var; }));
+
+    virtual_machine vm{};
+
+    for ( int i{}; i < 20; i++ )
+    {
+        const script_value arguments[] = { script_value{number{static_cast<double>(i)}}, script_value{number{10.0}} };
+
+        TTS_EXPECT(evaluate(vm, expression, arguments) == script_value{boolean{i * 10 > 100}});
+        TTS_EXPECT(vm.stack().empty());
+    }
+};
+
+TTS_CASE("Prepared expression with statements")
+{
+    using namespace acme;
+    using namespace acme::literals;
+
+    static constexpr std::string_view k_parameters[] = { "n" };
+
+    const auto expression = prepared_expression{R"(
+        var s = 0;
+        var i = 0;
+
+        while ( i < n )
+        {
+            s = s + i;
+            i = i + 1;
+        }
+
+        s + missing;
+        s * 2;
+    )", k_parameters};
+
+    virtual_machine vm{};
+
+    const script_value first[]  = { script_value{number{10.0}} };
+    const script_value second[] = { script_value{number{4.0}} };
+
+    TTS_EXPECT(evaluate(vm, expression, first) == script_value{90});
+    TTS_EXPECT(evaluate(vm, expression, second) == script_value{12});
+
+    // Variables of an evaluation are released.
+
+    TTS_EXPECT(vm.get_var("s"_id).has_value() == false);
+    TTS_EXPECT(vm.stack().empty());
+};
@@ -0,0 +1,147 @@
+#if defined(__clang__)
+#pragma clang diagnostic push
+#pragma clang diagnostic ignored "-Wextra-semi"
+#endif /* __clang__ */
+
+#define TTS_MAIN
+#include <tts/tts.hpp>
+
+#if defined(__clang__)
+#pragma clang diagnostic pop
+#endif /* __clang__ */
+
+#include <sstream>
+
+#include "memory/memory.hpp"
+#include "base/base.hpp"
+#include "string_pool/string_pool.hpp"
+
+#include "tokenizer/tokenizer.hpp"
+#include "var/script_value.hpp"
+#include "parse/parser_context.hpp"
+#include "ast/ast.hpp"
+#include "parse/parse.hpp"
+#include "json/json_escape.hpp"
+#include "render/render.hpp"
+#include "render/json_writer.hpp"
+#include "render/to_json.hpp"
+
+namespace {
+
+constexpr std::string_view k_script =
+R"(
+    var i = 1;
+    var n;
+    const s = "Test";
+    var b = false;
+    var f = 1.5;
+
+    var ter = i > 10 ? i : 11;
+    i += 2;
+
+    if ( (i + 10)++ ) { var n = i; } else if ( !false ) { var n = -i; } else { var n = i; }
+
+    for ( var i = 0; i < 10; i ++ ) { /* NOP */ }
+    while ( i > 0 ) { i--; }
+
+    blaah (a,b,10)().aa;
+    var car1 = new Car (123, -1234, "BLAAH" );
+    if ( new.target ) { /* NOP */ }
+
+    function calcRectArea(width, height)
+    {
+        if ( width ) { return 10; }
+        return width * height;
+    }
+
+    var arr = [, 20, "some string",, 30];
+    var empty = [];
+
+    for ( let i = 0; i < 10; i ++ )
+    {
+        some_label:
+        if ( i > 1 ) { break; } else if ( i == 3 ) { continue some_label; }
+    }
+
+    var obj = { a: "foo", b: 42, c: { h : 10, set b(c) { var a = 10; }, get s() { a; } } };
+)";
+
+// The text of the document built with nlohmann::json.
+
+auto dump(const acme::parser::ast_node_list_type& ast_nodes) -> std::string
+{
+    using namespace std::string_view_literals;
+
+    nlohmann::json result{};
+
+    for ( const auto& p : ast_nodes )
+    {
+        auto sub      = acme::render::to_json(p);
+        sub["type"sv] = acme::ast::to_string(p);
+
+        result += sub;
+    }
+
+    return result.dump(2);
+}
+
+} // namespace
+
+TTS_CASE("Streamed AST JSON is identical to nlohmann::json")
+{
+    platform::pmr::monotonic_buffer_resource resource{};
+
+    acme::parser script_parser{k_script, std::addressof(resource)};
+    script_parser.parse_all();
+
+    const auto& ast_nodes = script_parser.ast_nodes();
+
+    TTS_EXPECT(ast_nodes.empty() == false);
+    TTS_EXPECT(acme::to_json(ast_nodes) == dump(ast_nodes));
+};
+
+TTS_CASE("Stream AST JSON to a buffer and an ostream")
+{
+    platform::pmr::monotonic_buffer_resource resource{};
+
+    // Large enough for the writer to flush the stream several times.
+
+    auto script = std::string{};
+
+    for ( int i{}; i < 64; i++ )
+    {
+        script += k_script;
+    }
+
+    acme::parser script_parser{script, std::addressof(resource)};
+    script_parser.parse_all();
+
+    const auto& ast_nodes = script_parser.ast_nodes();
+    const auto  expected  = dump(ast_nodes);
+
+    TTS_EXPECT(expected.size() > 4u * acme::render::json_writer::k_flush_size);
+
+    auto stream = std::ostringstream{};
+
+    acme::to_json(ast_nodes, stream);
+
+    TTS_EXPECT(stream.str() == expected);
+
+    // The buffer is appended to.
+
+    auto buffer = std::string{"x"};
+
+    acme::to_json(ast_nodes, buffer);
+
+    TTS_EXPECT(buffer == "x" + expected);
+};
+
+TTS_CASE("Empty AST JSON")
+{
+    platform::pmr::monotonic_buffer_resource resource{};
+
+    acme::parser script_parser{"", std::addressof(resource)};
+    script_parser.parse_all();
+
+    TTS_EXPECT(acme::to_json(script_parser.ast_nodes()) == dump(script_parser.ast_nodes()));
+};
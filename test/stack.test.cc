@@ -139,6 +139,48 @@ static_assert(
 );
 #endif
 
+static_assert(
+
+    []() constexpr
+    {
+        using namespace acme;
+
+        std::allocator<acme::script_value> allocator{};
+
+        auto* first  = allocator.allocate(2);
+        auto* second = allocator.allocate(4);
+
+        auto result = [&]()
+        {
+            containers::stack<std::dynamic_extent, acme::script_value> stack{std::span{first, 2}};
+
+            stack.push_back(acme::script_value{acme::number{1}});
+            stack.push_back(acme::script_value{acme::boolean{true}});
+
+            if ( stack.size() != 2 || stack.capacity() != 2 ) { return false; }
+
+            // Entries are moved to the new storage, the old storage is handed back.
+
+            if ( stack.relocate(std::span{second, 4}).data() != first ) { return false; }
+
+            stack.push_back(acme::script_value{acme::undefined{}});
+
+            if ( stack.capacity() != 4 )                      { return false; }
+            if ( auto v = stack.pop_back(); not is_undefined(v) ) { return false; }
+            if ( auto v = stack.pop_back(); not is_boolean(v)   ) { return false; }
+            if ( stack.top() != acme::script_value{1} )       { return false; }
+
+            return true;
+        }();
+
+        allocator.deallocate(first, 2);
+        allocator.deallocate(second, 4);
+
+        return result;
+
+    }() == true, "[ACME stack] Span backed stack"
+);
+
 static_assert(
 
     []() constexpr
@@ -185,3 +185,26 @@ TTS_CASE("Concatanate")
     TTS_EXPECT(s3.view() == "123456"sv);
     TTS_EXPECT(pool.count() == 3u);
 };
+
+TTS_CASE("Strings with the same hash")
+{
+    using namespace std::string_view_literals;
+
+    std::byte buffer[1024];
+    acme::fixed_buffer_resource mbr{buffer, sizeof(buffer)};
+
+    acme::string_pool pool{std::addressof(mbr)};
+
+    // Both strings have the same FNV-1a hash.
+
+    auto s1 = pool.intern("costarring"sv);
+    auto s2 = pool.intern("liquid"sv);
+    auto s3 = pool.concatanate("liq"sv, "uid"sv);
+
+    TTS_EXPECT(s1.hash() == s2.hash());
+    TTS_EXPECT(s1.view() == "costarring"sv);
+    TTS_EXPECT(s2.view() == "liquid"sv);
+    TTS_EXPECT((s1 == s2) == false);
+    TTS_EXPECT(s2 == s3);
+    TTS_EXPECT(pool.count() == 2u);
+};
@@ -475,13 +475,43 @@ TTS_CASE("Tokenize number")
         acme::tokenizer tokenizer{"0.54e2"sv};
 
         auto token = parse_number(tokenizer);
-        TTS_IEEE_EQUAL(token.value().to_double(), 0.54);
+        TTS_IEEE_EQUAL(token.value().to_double(), 54.0);
     }
 
     {
         acme::tokenizer tokenizer{"-0.54e2"sv};
 
         auto token = parse_number(tokenizer);
-        TTS_IEEE_EQUAL(token.value().to_double(), -0.54);
+        TTS_IEEE_EQUAL(token.value().to_double(), -54.0);
     }
 };
+
+TTS_CASE("Identifier hashes")
+{
+    using namespace acme;
+    using namespace std::string_view_literals;
+
+    acme::tokenizer tokenizer{"var xtypeof = _a$1 + ab . c;"sv};
+
+    constexpr auto k_identifiers = std::array{ "xtypeof"sv, "_a$1"sv, "ab"sv, "c"sv };
+
+    auto i = std::size_t{};
+
+    while ( tokenizer.empty() == false )
+    {
+        const auto token = tokenizer.next();
+
+        if ( token.is_identifier() == false )
+        {
+            continue;
+        }
+
+        TTS_EXPECT(i < k_identifiers.size());
+        TTS_EXPECT(token.to_string() == k_identifiers[i]);
+        TTS_EXPECT(token.hash() == acme::detail::hash_fnv1a(k_identifiers[i]));
+
+        i++;
+    }
+
+    TTS_EXPECT(i == k_identifiers.size());
+};
@@ -0,0 +1,211 @@
+#if defined(__clang__)
+#pragma clang diagnostic push
+#pragma clang diagnostic ignored "-Wextra-semi"
+#endif /* __clang__ */
+
+#define TTS_MAIN
+#include <tts/tts.hpp>
+
+#if defined(__clang__)
+#pragma clang diagnostic pop
+#endif /* __clang__ */
+
+#include "memory/memory.hpp"
+#include "memory/fixed_buffer_resource.hpp"
+#include "base/base.hpp"
+#include "string_pool/string_pool.hpp"
+
+#include "tokenizer/tokenizer.hpp"
+#include "var/script_value.hpp"
+#include "parse/parser_context.hpp"
+#include "ast/ast.hpp"
+#include "parse/parse.hpp"
+#include "bytecode/bytecode.hpp"
+#include "bytecode/verify.hpp"
+#include "virtual_machine/virtual_machine.hpp"
+#include "emit/emit.hpp"
+
+namespace {
+
+auto emit_script(std::string_view script, acme::emit_context& context)
+{
+    std::byte buffer[8192];
+    acme::fixed_buffer_resource mbr{buffer, sizeof(buffer)};
+
+    acme::parser script_parser{script, std::addressof(mbr)};
+    script_parser.parse_all();
+
+    acme::emit(script_parser.ast_nodes(), context);
+}
+
+template <std::size_t N>
+auto verify_instructions(const std::array<acme::instruction, N>& instructions, std::size_t stack_capacity = acme::virtual_machine::k_max_stack_depth)
+{
+    static constexpr auto k_numbers = std::to_array<acme::number_constant>
+    ({
+        acme::number_constant{ .m_i32 = 1 },
+    });
+
+    auto code = acme::bytecode{std::span{instructions}, std::span{k_numbers}};
+
+    return acme::verify(code, stack_capacity);
+}
+
+} // namespace
+
+TTS_CASE("Stack effects")
+{
+    static_assert(acme::stack_effect_of(acme::opcode::binary_add).m_pops == 2);
+    static_assert(acme::stack_effect_of(acme::opcode::binary_add).m_pushes == 1);
+    static_assert(acme::stack_effect_of(acme::opcode::binary_add_number).m_pops == 2);
+    static_assert(acme::stack_effect_of(acme::opcode::duplicate_top).m_pushes == 2);
+    static_assert(acme::stack_effect_of(acme::opcode::initialize).m_pushes == 0);
+    static_assert(acme::stack_effect_of(acme::opcode::jump_to).m_pops == 0);
+
+    // Verification is usable during constant evaluation.
+
+    static_assert([]()
+    {
+        constexpr auto k_instructions = std::to_array<acme::instruction>
+        ({
+            acme::instruction::make(acme::opcode::push_bool_true,  0u),
+            acme::instruction::make(acme::opcode::push_bool_false, 0u),
+            acme::instruction::make(acme::opcode::binary_add,      0u),
+        });
+
+        auto code   = acme::bytecode{std::span{k_instructions}};
+        auto result = acme::verify(code, 2);
+
+        return static_cast<bool>(result) && result.m_max_stack_depth == 2 && code.verified();
+    }());
+
+    TTS_EXPECT(acme::stack_effect_of(acme::opcode::store_var).m_pops == 2u);
+    TTS_EXPECT(acme::stack_effect_of(acme::opcode::load_var).m_pushes == 1u);
+};
+
+TTS_CASE("Verify emitted script")
+{
+    using namespace std::string_view_literals;
+
+    static constexpr std::string_view k_script =
+    R"(
+        var sum = 0;
+        var i   = 0;
+        var s   = "a";
+
+        while ( i < 10 )
+        {
+            if ( i == 5 )
+            {
+                sum = sum + 100;
+            }
+
+            sum = sum + i * 2;
+            i   = i + 1;
+        }
+    )";
+
+    acme::emit_context context{};
+    emit_script(k_script, context);
+
+    auto code   = context.bytecode();
+    auto result = acme::verify(code, acme::virtual_machine::k_max_stack_depth);
+
+    TTS_EXPECT(static_cast<bool>(result));
+    TTS_EXPECT(code.verified());
+    TTS_EXPECT(result.m_max_stack_depth >= 2u);
+    TTS_EXPECT(result.m_max_stack_depth == context.max_stack_depth());
+    TTS_EXPECT(code.max_stack_depth() == context.max_stack_depth());
+
+    // Verified bytecode runs on the unchecked path with the same result.
+
+    acme::virtual_machine checked{};
+    checked.execute(context.bytecode());
+
+    acme::virtual_machine unchecked{};
+    unchecked.execute(code);
+
+    TTS_EXPECT(checked.locals().get(acme::identifier{"sum"sv}) == acme::script_value{190});
+    TTS_EXPECT(unchecked.locals().get(acme::identifier{"sum"sv}) == acme::script_value{190});
+    TTS_EXPECT(checked.stack().empty());
+    TTS_EXPECT(unchecked.stack().empty());
+};
+
+TTS_CASE("Reject invalid bytecode")
+{
+    using acme::instruction;
+    using acme::opcode;
+    using acme::verify_error;
+
+    const auto jump_out_of_range = verify_instructions(std::to_array
+    ({
+        instruction::make(opcode::jump_to, 5u),
+    }));
+
+    TTS_EXPECT(jump_out_of_range.m_error == verify_error::jump_out_of_range);
+
+    const auto constant_out_of_range = verify_instructions(std::to_array
+    ({
+        instruction::make(opcode::constant_i32, 0u),
+        instruction::make(opcode::constant_i32, 1u),
+    }));
+
+    TTS_EXPECT(constant_out_of_range.m_error == verify_error::constant_out_of_range);
+    TTS_EXPECT(constant_out_of_range.m_offset == 1u);
+
+    const auto string_out_of_range = verify_instructions(std::to_array
+    ({
+        instruction::make(opcode::constant_string, 0u),
+    }));
+
+    TTS_EXPECT(string_out_of_range.m_error == verify_error::constant_out_of_range);
+
+    const auto underflow = verify_instructions(std::to_array
+    ({
+        instruction::make(opcode::constant_i32, 0u),
+        instruction::make(opcode::binary_add,   0u),
+    }));
+
+    TTS_EXPECT(underflow.m_error == verify_error::stack_underflow);
+    TTS_EXPECT(underflow.m_offset == 1u);
+
+    // One path reaches offset 3 with an extra value on the stack.
+
+    const auto mismatch = verify_instructions(std::to_array
+    ({
+        instruction::make(opcode::push_bool_true, 0u),
+        instruction::make(opcode::jump_if_false,  3u),
+        instruction::make(opcode::push_null,      0u),
+        instruction::make(opcode::no_opearation,  0u),
+    }));
+
+    TTS_EXPECT(mismatch.m_error == verify_error::stack_mismatch);
+
+    const auto overflow = verify_instructions(std::to_array
+    ({
+        instruction::make(opcode::push_null, 0u),
+        instruction::make(opcode::push_null, 0u),
+        instruction::make(opcode::push_null, 0u),
+    }), 2);
+
+    TTS_EXPECT(overflow.m_error == verify_error::stack_overflow);
+    TTS_EXPECT(overflow.m_offset == 2u);
+
+    // A loop that leaves a value on the stack in each iteration.
+
+    const auto growing_loop = verify_instructions(std::to_array
+    ({
+        instruction::make(opcode::push_null, 0u),
+        instruction::make(opcode::jump_to,   0u),
+    }));
+
+    TTS_EXPECT(growing_loop.m_error == verify_error::stack_mismatch);
+
+    const auto scope_underflow = verify_instructions(std::to_array
+    ({
+        instruction::make(opcode::push_stack_frame, 0u),
+        instruction::make(opcode::pop_stack_frame,  2u),
+    }));
+
+    TTS_EXPECT(scope_underflow.m_error == verify_error::scope_underflow);
+};
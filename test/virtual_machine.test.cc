@@ -94,3 +94,286 @@ TTS_CASE("Virtual machine 2")
     TTS_EXPECT(vm.locals().get("var1"_id) == acme::script_value{13});
 };
 
+
+TTS_CASE("Quickening")
+{
+    using namespace acme;
+    using namespace acme::literals;
+    using namespace std::string_view_literals;
+
+    // var s = 0; var i = 0; while ( i < 10 ) { s = s + i; i = i + 1; }
+
+    constexpr auto k_numbers = std::to_array<acme::number_constant>
+    ({
+        number_constant{ .m_hash = "s"_id },
+        number_constant{ .m_hash = "i"_id },
+        number_constant{ .m_i32  = 0 },
+        number_constant{ .m_i32  = 10 },
+        number_constant{ .m_i32  = 1 },
+    });
+
+    constexpr auto k_instructions = std::to_array<acme::instruction>
+    ({
+        instruction::make(opcode::constant_identifier, 0u),
+        instruction::make(opcode::constant_i32,        2u),
+        instruction::make(opcode::initialize,          0u),
+        instruction::make(opcode::constant_identifier, 1u),
+        instruction::make(opcode::constant_i32,        2u),
+        instruction::make(opcode::initialize,          0u),
+
+        instruction::make(opcode::constant_i32,        3u),
+        instruction::make(opcode::constant_identifier, 1u),
+        instruction::make(opcode::load_var,            0u),
+        instruction::make(opcode::compare_less_than,   0u),
+        instruction::make(opcode::jump_if_false,       25u),
+
+        instruction::make(opcode::constant_identifier, 1u),
+        instruction::make(opcode::load_var,            0u),
+        instruction::make(opcode::constant_identifier, 0u),
+        instruction::make(opcode::load_var,            0u),
+        instruction::make(opcode::binary_add,          0u),
+        instruction::make(opcode::constant_identifier, 0u),
+        instruction::make(opcode::store_var,           0u),
+
+        instruction::make(opcode::constant_i32,        4u),
+        instruction::make(opcode::constant_identifier, 1u),
+        instruction::make(opcode::load_var,            0u),
+        instruction::make(opcode::binary_add,          0u),
+        instruction::make(opcode::constant_identifier, 1u),
+        instruction::make(opcode::store_var,           0u),
+        instruction::make(opcode::jump_to,             6u),
+        instruction::make(opcode::no_opearation,       0u),
+    });
+
+    virtual_machine vm{};
+
+    vm.execute(bytecode{std::span{k_instructions}, std::span{k_numbers}});
+
+    TTS_EXPECT(vm.locals().get("s"_id) == acme::script_value{45});
+    TTS_EXPECT(vm.locals().get("i"_id) == acme::script_value{10});
+
+    // Instructions are rewritten in the virtual machine's own copy of the code only.
+
+    TTS_EXPECT(operand(vm.code()[9])  == opcode::compare_less_than_number);
+    TTS_EXPECT(operand(vm.code()[15]) == opcode::binary_add_number);
+    TTS_EXPECT(operand(vm.code()[21]) == opcode::binary_add_number);
+    TTS_EXPECT(operand(k_instructions[9])  == opcode::compare_less_than);
+    TTS_EXPECT(operand(k_instructions[15]) == opcode::binary_add);
+};
+
+TTS_CASE("Quickening guard")
+{
+    using namespace acme;
+    using namespace acme::literals;
+    using namespace std::string_view_literals;
+
+    // var a = 1; var r = 0; var i = 0; while ( i < 2 ) { r = a + a; a = true; i = i + 1; }
+
+    constexpr auto k_numbers = std::to_array<acme::number_constant>
+    ({
+        number_constant{ .m_hash = "a"_id },
+        number_constant{ .m_hash = "r"_id },
+        number_constant{ .m_hash = "i"_id },
+        number_constant{ .m_i32  = 1 },
+        number_constant{ .m_i32  = 0 },
+        number_constant{ .m_i32  = 2 },
+    });
+
+    constexpr auto k_instructions = std::to_array<acme::instruction>
+    ({
+        instruction::make(opcode::constant_identifier, 0u),
+        instruction::make(opcode::constant_i32,        3u),
+        instruction::make(opcode::initialize,          0u),
+        instruction::make(opcode::constant_identifier, 1u),
+        instruction::make(opcode::constant_i32,        4u),
+        instruction::make(opcode::initialize,          0u),
+        instruction::make(opcode::constant_identifier, 2u),
+        instruction::make(opcode::constant_i32,        4u),
+        instruction::make(opcode::initialize,          0u),
+
+        instruction::make(opcode::constant_i32,        5u),
+        instruction::make(opcode::constant_identifier, 2u),
+        instruction::make(opcode::load_var,            0u),
+        instruction::make(opcode::compare_less_than,   0u),
+        instruction::make(opcode::jump_if_false,       31u),
+
+        instruction::make(opcode::constant_identifier, 0u),
+        instruction::make(opcode::load_var,            0u),
+        instruction::make(opcode::constant_identifier, 0u),
+        instruction::make(opcode::load_var,            0u),
+        instruction::make(opcode::binary_add,          0u),
+        instruction::make(opcode::constant_identifier, 1u),
+        instruction::make(opcode::store_var,           0u),
+
+        instruction::make(opcode::push_bool_true,      0u),
+        instruction::make(opcode::constant_identifier, 0u),
+        instruction::make(opcode::store_var,           0u),
+
+        instruction::make(opcode::constant_i32,        3u),
+        instruction::make(opcode::constant_identifier, 2u),
+        instruction::make(opcode::load_var,            0u),
+        instruction::make(opcode::binary_add,          0u),
+        instruction::make(opcode::constant_identifier, 2u),
+        instruction::make(opcode::store_var,           0u),
+        instruction::make(opcode::jump_to,             9u),
+        instruction::make(opcode::no_opearation,       0u),
+    });
+
+    virtual_machine vm{};
+
+    vm.execute(bytecode{std::span{k_instructions}, std::span{k_numbers}});
+
+    // The second iteration adds booleans, the quickened instruction falls back to the generic one.
+
+    TTS_EXPECT(vm.locals().get("r"_id) == acme::script_value{2});
+    TTS_EXPECT(operand(vm.code()[18]) == opcode::binary_add);
+    TTS_EXPECT(operand(vm.code()[27]) == opcode::binary_add_number);
+};
+
+TTS_CASE("Operand stack sized from bytecode")
+{
+    using namespace acme::literals;
+
+    // Left associative additions are emitted right operand first, which keeps one value
+    // per term on the stack. Deeper than the previous fixed capacity of 24 values.
+
+    auto script = std::string{"var x = 1"};
+
+    for ( int i{}; i < 39; i++ )
+    {
+        script += " + 1";
+    }
+
+    script += ";";
+
+    std::byte buffer[32768];
+    acme::fixed_buffer_resource mbr{buffer, sizeof(buffer)};
+
+    acme::parser script_parser{script, std::addressof(mbr)};
+    script_parser.parse_all();
+
+    acme::emit_context context{};
+    acme::emit(script_parser.ast_nodes(), context);
+
+    const auto code = context.bytecode();
+
+    TTS_EXPECT(code.max_stack_depth() > 24u);
+    TTS_EXPECT(code.max_stack_depth() == acme::max_stack_depth(code.instructions()));
+
+    acme::virtual_machine vm{};
+
+    vm.execute(code);
+
+    TTS_EXPECT(vm.locals().get("x"_id) == acme::script_value{40});
+    TTS_EXPECT(vm.stack().empty());
+
+    // The storage is kept for the next execution.
+
+    const auto capacity = vm.stack().capacity();
+
+    TTS_EXPECT(capacity >= code.max_stack_depth());
+
+    vm.execute(code);
+
+    TTS_EXPECT(vm.stack().capacity() == capacity);
+};
+
+TTS_CASE("Resumable execution")
+{
+    using namespace acme::literals;
+
+    static constexpr std::string_view k_script =
+    R"(
+        var i = 0;
+        var s = 0;
+
+        while ( i < 1000 )
+        {
+            s = s + i;
+            i = i + 1;
+        }
+    )";
+
+    std::byte buffer[8192];
+    acme::fixed_buffer_resource mbr{buffer, sizeof(buffer)};
+
+    acme::parser script_parser{k_script, std::addressof(mbr)};
+    script_parser.parse_all();
+
+    acme::emit_context context{};
+    acme::emit(script_parser.ast_nodes(), context);
+
+    acme::virtual_machine vm{};
+
+    vm.start(context.bytecode());
+
+    // Each slice runs a bounded number of loop iterations.
+
+    auto slices = 0;
+
+    while ( vm.resume(500) == acme::execution_status::k_suspended )
+    {
+        slices++;
+
+        TTS_EXPECT(vm.suspended() == true);
+        TTS_EXPECT(vm.stack().empty());
+    }
+
+    TTS_EXPECT(slices > 10);
+    TTS_EXPECT(vm.suspended() == false);
+    TTS_EXPECT(vm.locals().get("i"_id) == acme::script_value{1000});
+    TTS_EXPECT(vm.locals().get("s"_id) == acme::script_value{499500});
+};
+
+TTS_CASE("Cancel execution over budget")
+{
+    using namespace acme::literals;
+
+    static constexpr std::string_view k_script =
+    R"(
+        var i = 0;
+
+        while ( true )
+        {
+            let j = i;
+            i = j + 1;
+        }
+    )";
+
+    std::byte buffer[8192];
+    acme::fixed_buffer_resource mbr{buffer, sizeof(buffer)};
+
+    acme::parser script_parser{k_script, std::addressof(mbr)};
+    script_parser.parse_all();
+
+    acme::emit_context context{};
+    acme::emit(script_parser.ast_nodes(), context);
+
+    acme::virtual_machine vm{};
+
+    vm.start(context.bytecode());
+
+    for ( int slice{}; slice < 10; slice++ )
+    {
+        TTS_EXPECT(vm.resume(100) == acme::execution_status::k_suspended);
+    }
+
+    vm.cancel();
+
+    TTS_EXPECT(vm.suspended() == false);
+    TTS_EXPECT(vm.stack().empty());
+    TTS_EXPECT(vm.locals().get("j"_id).has_value() == false);
+    TTS_EXPECT(vm.locals().get("i"_id).has_value() == true);
+
+    // A script without a budget still runs to completion on the same virtual machine.
+
+    acme::parser next_parser{"var k = 2 * 21;", std::addressof(mbr)};
+    next_parser.parse_all();
+
+    acme::emit_context next_context{};
+    acme::emit(next_parser.ast_nodes(), next_context);
+
+    vm.execute(next_context.bytecode());
+
+    TTS_EXPECT(vm.locals().get("k"_id) == acme::script_value{42});
+};
@@ -0,0 +1,93 @@
+#include "memory/memory.hpp"
+#include "base/base.hpp"
+#include "string_pool/string_pool.hpp"
+#include "parse/parser_context.hpp"
+
+#include "tokenizer/tokenizer.hpp"
+#include "var/script_value.hpp"
+#include "ast/ast.hpp"
+#include "parse/parse.hpp"
+#include "bytecode/bytecode.hpp"
+#include "virtual_machine/virtual_machine.hpp"
+#include "emit/emit.hpp"
+#include "optimize/optimize.hpp"
+#include "aot/aot.hpp"
+
+/* acme_aotc: ahead-of-time compiler from JavaScript source to a C++ translation unit.
+
+    Usage: acme_aotc [-O0|-O1|-O2] <input.js> <output.cc> [function name]
+
+    The bytecode is optimized with acme::opt::optimize at the given level, -O0 by default.
+    The generated function has the signature `void name(acme::virtual_machine&)`
+    and is run with `acme::virtual_machine::execute(native_script)`.
+*/
+
+auto main(int argc, char** argv) -> int
+{
+    auto level     = acme::opt::optimize_level::k_O0;
+    auto arguments = std::vector<std::string_view>{};
+
+    for ( int i = 1; i < argc; i++ )
+    {
+        const auto argument = std::string_view{argv[i]};
+
+        if ( argument == "-O0" || argument == "-O1" || argument == "-O2" )
+        {
+            level = static_cast<acme::opt::optimize_level>(argument[2] - '0');
+        }
+
+        else
+        {
+            arguments.push_back(argument);
+        }
+    }
+
+    if ( arguments.size() < 2 )
+    {
+        std::cerr << "Usage: " << argv[0] << " [-O0|-O1|-O2] <input.js> <output.cc> [function name]\n";
+        return EXIT_FAILURE;
+    }
+
+    const auto input_path  = std::filesystem::path{arguments[0]};
+    const auto output_path = std::filesystem::path{arguments[1]};
+    const auto name        = arguments.size() > 2 ? std::string{arguments[2]} : "acme_script_" + input_path.stem().string();
+
+    std::ifstream input{input_path, std::ios::binary};
+
+    if ( input.is_open() == false )
+    {
+        std::cerr << "acme_aotc: cannot open '" << input_path.string() << "'\n";
+        return EXIT_FAILURE;
+    }
+
+    const auto source = std::string{std::istreambuf_iterator<char>{input}, std::istreambuf_iterator<char>{}};
+
+    platform::pmr::monotonic_buffer_resource resource{};
+
+    acme::parser script_parser{source, std::addressof(resource)};
+    script_parser.parse_all();
+
+    acme::emit_context context{};
+    acme::emit(script_parser.ast_nodes(), context);
+    acme::opt::optimize(context, level);
+
+    std::ostringstream generated{};
+
+    if ( acme::aot::transpile(context.bytecode(), name, generated) == false )
+    {
+        std::cerr << "acme_aotc: unsupported bytecode in '" << input_path.string() << "'\n";
+        return EXIT_FAILURE;
+    }
+
+    std::ofstream output{output_path, std::ios::binary | std::ios::trunc};
+
+    if ( output.is_open() == false )
+    {
+        std::cerr << "acme_aotc: cannot write '" << output_path.string() << "'\n";
+        return EXIT_FAILURE;
+    }
+
+    output << generated.str();
+
+    return EXIT_SUCCESS;
+}